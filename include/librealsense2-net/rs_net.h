@@ -15,6 +15,25 @@ extern "C" {
 
 #include "librealsense2/rs.h"
 
+/** \brief Reception statistics of a stream of a net device, for the last time the stream was started */
+typedef struct rs2_net_stream_statistics
+{
+    unsigned long long received_frames;   /**< Frames received over RTP */
+    unsigned long long corrupted_frames;  /**< Frames that were truncated or whose size did not match their header */
+    unsigned long long packets_expected;  /**< RTP packets the server sent, counted by their sequence numbers */
+    unsigned long long packets_lost;      /**< RTP packets that did not arrive */
+    unsigned long long injected_frames;   /**< Frames delivered to the sensor */
+    unsigned long long dropped_frames;    /**< Frames dropped because the application did not keep up with the stream */
+    double avg_latency_ms;                /**< Average time from the presentation of a frame at the server to its reception, 0 until RTCP synchronized the clocks */
+    double max_latency_ms;                /**< Largest time from the presentation of a frame at the server to its reception */
+    double avg_decompress_time_ms;        /**< Average time to decompress a received frame */
+    double avg_injection_latency_ms;      /**< Average time from the reception of a frame to its delivery to the sensor */
+    unsigned long long compression_switches; /**< Times the server changed the compression of the stream, 0 unless the server adapts it */
+    double avg_encode_time_ms;            /**< Recent average time the server took to compress a frame, 0 unless the server adapts the compression */
+    double avg_compression_ratio;         /**< Recent average of the raw frame size over the received size, 0 unless the server adapts the compression */
+    int send_backlog;                     /**< Frames that waited to be sent at the server when the last frame was compressed */
+} rs2_net_stream_statistics;
+
 /**
  * Net device is a rs2_device that can be stream and be contolled remotely over network 
  * \param[in] api_version Users are expected to pass their version of \c RS2_API_VERSION to make sure they are running the correct librealsense version.
@@ -23,6 +42,15 @@ extern "C" {
  */
 rs2_device* rs2_create_net_device(int api_version, const char* address, rs2_error** error);
 
+/**
+ * Get the reception statistics of a stream of a net device. The statistics of a stream that stopped are the ones of its last run
+ * \param[in] device     net device, created by rs2_create_net_device
+ * \param[in] profile    stream profile of one of the sensors of the device
+ * \param[out] statistics receives the statistics of the stream
+ * \param[out] error     if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+ */
+void rs2_get_net_stream_statistics(const rs2_device* device, const rs2_stream_profile* profile, rs2_net_stream_statistics* statistics, rs2_error** error);
+
 #ifdef __cplusplus
 }
 #endif
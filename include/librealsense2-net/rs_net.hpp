@@ -30,6 +30,20 @@ namespace rs2
                 error::handle(e);
             }
 
+            /**
+            * Get the reception statistics of a stream of the device
+            *
+            * \param[in] profile   stream profile of one of the sensors of the device
+            */
+            rs2_net_stream_statistics get_stream_statistics(const stream_profile& profile) const
+            {
+                rs2_error* e = nullptr;
+                rs2_net_stream_statistics statistics;
+                rs2_get_net_stream_statistics(_dev.get(), profile.get(), &statistics, &e);
+                error::handle(e);
+                return statistics;
+            }
+
 
         private:
             std::shared_ptr<rs2_device> init(const std::string& address)
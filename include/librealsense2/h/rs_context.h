@@ -54,6 +54,18 @@ void rs2_set_devices_changed_callback(const rs2_context* context, rs2_devices_ch
  * @return  A pointer to a device that plays data from the file, or null in case of failure
  */
 rs2_device* rs2_context_add_device(rs2_context* ctx, const char* file, rs2_error** error);
+
+/**
+ * Create a new device that plays several files as one continuous recording and add it to the context.
+ * Each entry may also be a pattern with '*' and '?' wildcards in the file name (e.g. "rec_*.bag") or a text file that lists the files, one per line.
+ * rs2_context_add_device keeps playing the single file it is given
+ * \param ctx          The context to which the new device will be added
+ * \param files        The files of the recording, patterns or lists of files, in playback order
+ * \param files_count  The number of files
+ * \param[out] error     If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+ * @return  A pointer to a device that plays data from the files, or null in case of failure
+ */
+rs2_device* rs2_context_add_device_from_files(rs2_context* ctx, const char** files, int files_count, rs2_error** error);
     
 /**
  * Add an instance of software device to the context
@@ -85,6 +85,16 @@ rs2_metadata_type rs2_get_frame_metadata(const rs2_frame* frame, rs2_frame_metad
 */
 int rs2_supports_frame_metadata(const rs2_frame* frame, rs2_frame_metadata_value frame_metadata, rs2_error** error);
 
+/**
+* retrieve all the metadata attributes of a frame in a single call
+* \param[in] frame          handle returned from a callback
+* \param[out] values        receives the value of each supported attribute, indexed by rs2_frame_metadata_value
+* \param[out] supported     receives non-zero for each attribute the frame supports, zero for the others
+* \param[in] count          size of the arrays, usually RS2_FRAME_METADATA_COUNT. Attributes beyond it are not retrieved
+* \param[out] error         if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_get_frame_metadata_all(const rs2_frame* frame, rs2_metadata_type* values, int* supported, int count, rs2_error** error);
+
 /**
 * retrieve timestamp domain from frame handle. timestamps can only be comparable if they are in common domain
 * (for example, depth timestamp might come from system time while color timestamp might come from the device)
@@ -231,6 +241,24 @@ rs2_pixel* rs2_get_frame_texture_coordinates(const rs2_frame* frame, rs2_error**
 */
 int rs2_get_frame_points_count(const rs2_frame* frame, rs2_error** error);
 
+/**
+* When called on Motion frame type, this method returns the number of consecutive IMU samples in the frame.
+* It is more than one when the sensor batches its samples, see RS2_OPTION_MOTION_BATCH_SIZE
+* \param[in] frame       Motion frame
+* \param[out] error      If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return                Number of samples, the frame data starts with them packed one after the other
+*/
+int rs2_get_motion_frame_samples_count(const rs2_frame* frame, rs2_error** error);
+
+/**
+* When called on Motion frame type, this method returns a pointer to an array of the timestamps of the frame samples.
+* The timestamps share the frame timestamp domain, the frame itself is stamped by its last sample
+* \param[in] frame       Motion frame
+* \param[out] error      If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return                Pointer to an array of rs2_get_motion_frame_samples_count timestamps in milliseconds, lifetime is managed by the frame
+*/
+const rs2_time_t* rs2_get_motion_frame_timestamps(const rs2_frame* frame, rs2_error** error);
+
 /**
 * Returns the stream profile that was used to start the stream of this frame
 * \param[in] frame       frame reference, owned by the user
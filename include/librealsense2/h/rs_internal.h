@@ -121,10 +121,18 @@ typedef struct rs2_software_notification
     const char* serialized_data;
 } rs2_software_notification;
 
+/** \brief A metadata value of an injected frame. */
+typedef struct rs2_software_metadata
+{
+    rs2_frame_metadata_value key;
+    rs2_metadata_type value;
+} rs2_software_metadata;
+
 struct rs2_software_device_destruction_callback;
 
 /**
  * Create librealsense context that will try to record all operations over librealsense into a file
+ * Files ending with ".rsmock" are written in a compact binary format, other files are sqlite databases
  * \param[in] api_version realsense API version as provided by RS2_API_VERSION macro
  * \param[in] filename string representing the name of the file to record
  * \param[in] section  string representing the name of the section within existing recording
@@ -156,6 +164,28 @@ rs2_context* rs2_create_mock_context(int api_version, const char* filename, cons
 */
 rs2_context* rs2_create_mock_context_versioned(int api_version, const char* filename, const char* section, const char* min_api_version, rs2_error** error);
 
+/**
+* Create librealsense context that plays back a recording on a virtual clock
+* The recorded frames are delivered one at a time, in the order of their recorded timestamps, each as soon as the previous one was consumed
+* \param[in] api_version realsense API version as provided by RS2_API_VERSION macro
+* \param[in] filename string representing the name of the file to play back from
+* \param[in] section  string representing the name of the section within existing recording
+* \param[in] min_api_version reject any file that was recorded before this version
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return            context object, should be released by rs2_delete_context
+*/
+rs2_context* rs2_create_mock_context_virtual_clock(int api_version, const char* filename, const char* section, const char* min_api_version, rs2_error** error);
+
+/**
+ * Convert a section of a recording between the sqlite and the binary recording formats
+ * The format of each file is picked by its name, as in rs2_create_recording_context
+ * \param[in] source  string representing the name of the recording to read
+ * \param[in] target  string representing the name of the file to write, the section is added to it
+ * \param[in] section string representing the name of the section within the recording
+ * \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+ */
+void rs2_convert_recording(const char* source, const char* target, const char* section, rs2_error** error);
+
 /**
  * Create software device to enable use librealsense logic without getting data from backend
  * but inject the data from outside
@@ -175,12 +205,25 @@ rs2_sensor* rs2_software_device_add_sensor(rs2_device* dev, const char* sensor_n
 
 /**
  * Inject video frame to software sonsor
+ * The pixels are not copied, they are the data of the frame until the frame is released, then the deleter is called.
+ * A deleter that returns the buffer to a pool of the application lets it reuse the buffers without allocations
  * \param[in] sensor the software sensor
  * \param[in] frame all the frame components
  * \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
  */
 void rs2_software_sensor_on_video_frame(rs2_sensor* sensor, rs2_software_video_frame frame, rs2_error** error);
 
+/**
+ * Inject video frame to software sensor together with all its metadata.
+ * The frame carries the given metadata instead of the values set with rs2_software_sensor_set_metadata
+ * \param[in] sensor the software sensor
+ * \param[in] frame all the frame components
+ * \param[in] metadata the metadata values of the frame
+ * \param[in] metadata_count the number of metadata values, an error is returned when they do not fit in the frame (21 values)
+ * \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+ */
+void rs2_software_sensor_on_video_frame_with_metadata(rs2_sensor* sensor, rs2_software_video_frame frame, const rs2_software_metadata* metadata, int metadata_count, rs2_error** error);
+
 /**
 * Inject motion frame to software sonsor
 * \param[in] sensor the software sensor
@@ -207,7 +250,7 @@ void rs2_software_sensor_on_pose_frame(rs2_sensor* sensor, rs2_software_pose_fra
 void rs2_software_sensor_on_notification(rs2_sensor* sensor, rs2_software_notification notif, rs2_error** error);
 
 /**
-* Set frame metadata for the upcoming frames
+* Set frame metadata for the upcoming frames, an error is returned when a new key does not fit in the frame (21 values)
 * \param[in] sensor the software sensor
 * \param[in] value metadata key to set
 * \param[in] type metadata value
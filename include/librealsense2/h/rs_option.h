@@ -96,6 +96,11 @@ extern "C" {
         RS2_OPTION_THERMAL_COMPENSATION, /**< Depth Thermal Compensation for selected D400 SKUs */
         RS2_OPTION_TRIGGER_CAMERA_ACCURACY_HEALTH, /**< Enable depth & color frame sync with periodic calibration for proper alignment */
         RS2_OPTION_RESET_CAMERA_ACCURACY_HEALTH,
+        RS2_OPTION_KERNEL_FRAME_BUFFERS, /**< Number of frame buffers queued to the driver, applied when the sensor is opened */
+        RS2_OPTION_NEWEST_FRAME_ONLY, /**< Deliver only the newest frame the driver has ready, releasing the stale ones unread */
+        RS2_OPTION_STREAMING_PROFILE, /**< Preset of the frame buffers and delivery: 0 - custom, 1 - low latency, 2 - high throughput */
+        RS2_OPTION_KERNEL_DROPPED_FRAMES, /**< Frames dropped at the driver boundary since the sensor was started */
+        RS2_OPTION_MOTION_BATCH_SIZE, /**< Number of consecutive IMU samples delivered in a single motion frame, applied when the sensor is started */
         RS2_OPTION_COUNT /**< Number of enumeration values. Not a valid input: intended to be used in for-loops. */
     } rs2_option;
 
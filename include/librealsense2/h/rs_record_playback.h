@@ -48,6 +48,20 @@ rs2_device* rs2_create_record_device(const rs2_device* device, const char* file,
 */
 rs2_device* rs2_create_record_device_ex(const rs2_device* device, const char* file, int compression_enabled, rs2_error** error);
 
+/**
+* Creates a recording device that splits the recording into several files, each of them playable on its own.
+* The recording continues to a new file once the current file reaches the given size or duration, without stopping the device.
+* The first file is saved to the given path, the following ones get an index suffix (e.g. "rec.bag", "rec_1.bag", "rec_2.bag")
+* \param[in]  device                The device to record
+* \param[in]  file                  The desired path to which the recorder should save the first file
+* \param[in]  compression_enabled   Indicates if compression is enabled, 0 means false, otherwise true
+* \param[in]  max_file_size         Size in bytes after which the recording continues to a new file, 0 for no size limit
+* \param[in]  max_file_duration_ms  Recorded duration in milliseconds after which the recording continues to a new file, 0 for no duration limit
+* \param[out] error     If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return A pointer to a device that records its data to files, or null in case of failure
+*/
+rs2_device* rs2_create_split_record_device(const rs2_device* device, const char* file, int compression_enabled, unsigned long long max_file_size, unsigned long long max_file_duration_ms, rs2_error** error);
+
 /**
 * Pause the recording device without stopping the actual device from streaming.
 * Pausing will cause the device to stop writing new data to the file, in particular, frames and changes to extensions
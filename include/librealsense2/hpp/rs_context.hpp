@@ -192,6 +192,28 @@ namespace rs2
             return playback { device };
         }
 
+        /**
+         * Creates a device that plays several RealSense files as one continuous recording
+         *
+         * On successful load, the device will be appended to the context and a devices_changed event triggered
+         * @param files  Paths to the RealSense files, in playback order. Each entry may also be a pattern such as "rec_*.bag" or a text file listing the files
+         * @return A playback device matching the given files
+         */
+        playback load_device(const std::vector<std::string>& files)
+        {
+            std::vector<const char*> file_names;
+            for (auto&& file : files)
+                file_names.push_back(file.c_str());
+
+            rs2_error* e = nullptr;
+            auto device = std::shared_ptr<rs2_device>(
+                rs2_context_add_device_from_files(_context.get(), file_names.data(), static_cast<int>(file_names.size()), &e),
+                rs2_delete_device);
+            rs2::error::handle(e);
+
+            return playback { device };
+        }
+
         void unload_device(const std::string& file)
         {
             rs2_error* e = nullptr;
@@ -507,6 +507,27 @@ namespace rs2
             return r != 0;
         }
 
+        /**
+        * retrieve all the metadata attributes the frame supports in a single call
+        * \return            the supported frame_metadata attributes and their values
+        */
+        std::vector<std::pair<rs2_frame_metadata_value, rs2_metadata_type>> get_all_frame_metadata() const
+        {
+            rs2_error* e = nullptr;
+            rs2_metadata_type values[RS2_FRAME_METADATA_COUNT];
+            int supported[RS2_FRAME_METADATA_COUNT];
+            rs2_get_frame_metadata_all(frame_ref, values, supported, RS2_FRAME_METADATA_COUNT, &e);
+            error::handle(e);
+
+            std::vector<std::pair<rs2_frame_metadata_value, rs2_metadata_type>> results;
+            for (int i = 0; i < RS2_FRAME_METADATA_COUNT; i++)
+            {
+                if (supported[i])
+                    results.emplace_back(static_cast<rs2_frame_metadata_value>(i), values[i]);
+            }
+            return results;
+        }
+
         /**
         * retrieve frame number (from frame handle)
         * \return               the frame number of the frame, in milliseconds since the device was started
@@ -884,6 +905,43 @@ namespace rs2
             auto data = reinterpret_cast<const float*>(get_data());
             return rs2_vector{ data[0], data[1], data[2] };
         }
+        /**
+        * Retrieve the number of IMU samples in the frame, more than one when the sensor batches them
+        * \return int - number of samples
+        */
+        int get_samples_count() const
+        {
+            rs2_error* e = nullptr;
+            auto r = rs2_get_motion_frame_samples_count(get(), &e);
+            error::handle(e);
+            return r;
+        }
+        /**
+        * Retrieve the motion data of one of the samples of the frame
+        * \param[in] sample - index of the sample, less than get_samples_count(), throws otherwise
+        * \return rs2_vector - 3D vector in Euclidean coordinate space.
+        */
+        rs2_vector get_motion_data(int sample) const
+        {
+            if (sample < 0 || sample >= get_samples_count())
+                throw std::runtime_error("Motion sample index is out of range");
+            auto data = reinterpret_cast<const float*>(get_data()) + 3 * sample;
+            return rs2_vector{ data[0], data[1], data[2] };
+        }
+        /**
+        * Retrieve the timestamp of one of the samples of the frame
+        * \param[in] sample - index of the sample, less than get_samples_count(), throws otherwise
+        * \return rs2_time_t - timestamp of the sample in milliseconds, in the frame timestamp domain
+        */
+        rs2_time_t get_sample_timestamp(int sample) const
+        {
+            rs2_error* e = nullptr;
+            if (sample < 0 || sample >= get_samples_count())
+                throw std::runtime_error("Motion sample index is out of range");
+            auto r = rs2_get_motion_frame_timestamps(get(), &e);
+            error::handle(e);
+            return r[sample];
+        }
     };
 
     class pose_frame : public frame
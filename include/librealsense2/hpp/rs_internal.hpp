@@ -39,14 +39,17 @@ namespace rs2
         * create librealsense context that given a file will respond to calls exactly as the recording did
         * if the user calls a method that was either not called during recording or violates causality of the recording error will be thrown
         * \param[in] filename string of the name of the file
+        * \param[in] virtual_clock deliver the recorded frames in the order of their timestamps, as fast as they are consumed
         */
         mock_context(const std::string& filename,
                      const std::string& section = "",
-                     const std::string& min_api_version = "0.0.0")
+                     const std::string& min_api_version = "0.0.0",
+                     bool virtual_clock = false)
         {
             rs2_error* e = nullptr;
+            auto create = virtual_clock ? rs2_create_mock_context_virtual_clock : rs2_create_mock_context_versioned;
             _context = std::shared_ptr<rs2_context>(
-                rs2_create_mock_context_versioned(RS2_API_VERSION, filename.c_str(), section.c_str(), min_api_version.c_str(), &e),
+                create(RS2_API_VERSION, filename.c_str(), section.c_str(), min_api_version.c_str(), &e),
                 rs2_delete_context);
             error::handle(e);
         }
@@ -68,6 +71,19 @@ namespace rs2
 
             return time;
         }
+
+        /**
+        * convert a section of a recording between the sqlite and the binary (".rsmock") recording formats
+        * \param[in] source  name of the recording to read
+        * \param[in] target  name of the file the section is added to
+        * \param[in] section name of the section within the recording
+        */
+        inline void convert_recording(const std::string& source, const std::string& target, const std::string& section)
+        {
+            rs2_error* e = nullptr;
+            rs2_convert_recording(source.c_str(), target.c_str(), section.c_str(), &e);
+            error::handle(e);
+        }
     }
 
     template<class T>
@@ -148,6 +164,19 @@ namespace rs2
             error::handle(e);
         }
 
+        /**
+        * Inject video frame into the sensor together with all its metadata, in a single call
+        *
+        * \param[in] frame      all the parameters that required to define video frame
+        * \param[in] metadata   the metadata values of the frame, used instead of the values set with set_metadata
+        */
+        void on_video_frame(rs2_software_video_frame frame, const std::vector<rs2_software_metadata>& metadata)
+        {
+            rs2_error* e = nullptr;
+            rs2_software_sensor_on_video_frame_with_metadata(_sensor.get(), frame, metadata.data(), static_cast<int>(metadata.size()), &e);
+            error::handle(e);
+        }
+
         /**
         * Inject motion frame into the sensor
         *
@@ -234,6 +234,24 @@ namespace rs2
             rs2::error::handle(e);
         }
 
+        /**
+        * Creates a recording device that splits the recording into several rosbag files without stopping the device.
+        * The first file is saved to the given path, the following ones get an index suffix (e.g. "rec.bag", "rec_1.bag")
+        * \param[in]  file                  The desired path to which the recorder should save the first file
+        * \param[in]  device                The device to record
+        * \param[in]  compression_enabled   Indicates if compression is enabled
+        * \param[in]  max_file_size         Size in bytes after which the recording continues to a new file, 0 for no size limit
+        * \param[in]  max_file_duration     Recorded duration after which the recording continues to a new file, 0 for no duration limit
+        */
+        recorder(const std::string& file, rs2::device dev, bool compression_enabled, uint64_t max_file_size, std::chrono::milliseconds max_file_duration)
+        {
+            rs2_error* e = nullptr;
+            _dev = std::shared_ptr<rs2_device>(
+                rs2_create_split_record_device(dev.get().get(), file.c_str(), compression_enabled, max_file_size, max_file_duration.count(), &e),
+                rs2_delete_device);
+            rs2::error::handle(e);
+        }
+
 
         /**
         * Pause the recording device without stopping the actual device from streaming.
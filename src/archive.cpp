@@ -211,37 +211,97 @@ namespace librealsense
         return owner->publish_frame(this);
     }
 
+    const md_attribute_parser_base* frame::find_metadata_parser(const rs2_frame_metadata_value& frame_metadata) const
+    {
+        if (!metadata_parsers)
+            return nullptr;
+
+        auto it = metadata_parsers.get()->find(frame_metadata);
+        return it == metadata_parsers.get()->end() ? nullptr : it->second.get();
+    }
+
+    rs2_metadata_type* frame::get_metadata_values() const
+    {
+        auto values = _md_values.load(std::memory_order_acquire);
+        if (values)
+            return values;
+
+        // concurrent first queries may both allocate, the one that loses releases its buffer and takes the other
+        std::unique_ptr<rs2_metadata_type[]> allocated(new rs2_metadata_type[MAX_CACHED_METADATA]);
+        if (_md_values.compare_exchange_strong(values, allocated.get(), std::memory_order_acq_rel))
+            values = allocated.release();
+        return values;
+    }
+
+    // Returns true when the attribute is cached. Parsers may query other attributes of the frame, and the queries of
+    // an attribute while another thread parses it parse it again, so a query never waits for another.
+    bool frame::cache_frame_metadata(const rs2_frame_metadata_value& frame_metadata, const md_attribute_parser_base& parser) const
+    {
+        if (frame_metadata < 0 || frame_metadata >= MAX_CACHED_METADATA)
+            return false;
+
+        const uint64_t bit = uint64_t(1) << frame_metadata;
+        if (_md_parsed.load(std::memory_order_acquire) & bit)
+            return true;
+        if (_md_claimed.fetch_or(bit) & bit)
+            return false;
+
+        bool supported = false;
+        try
+        {
+            supported = parser.supports(*this);
+            if (supported)
+                get_metadata_values()[frame_metadata] = parser.get(*this);
+        }
+        catch (...)
+        {
+            // left claimed, so the attribute is parsed on each query and each query reports its error
+            return false;
+        }
+
+        if (supported)
+            _md_supported.fetch_or(bit);
+        _md_parsed.fetch_or(bit, std::memory_order_release);
+        return true;
+    }
+
     rs2_metadata_type frame::get_frame_metadata(const rs2_frame_metadata_value& frame_metadata) const
     {
         if (!metadata_parsers)
             throw invalid_value_exception(to_string() << "metadata not available for "
                 << get_string(get_stream()->get_stream_type()) << " stream");
 
-        auto it = metadata_parsers.get()->find(frame_metadata);
-        if (it == metadata_parsers.get()->end())          // Possible user error - md attribute is not supported by this frame type
+        auto parser = find_metadata_parser(frame_metadata);
+        if (!parser)          // Possible user error - md attribute is not supported by this frame type
             throw invalid_value_exception(to_string() << get_string(frame_metadata)
                 << " attribute is not applicable for "
                 << get_string(get_stream()->get_stream_type()) << " stream ");
 
+        if (cache_frame_metadata(frame_metadata, *parser) && (_md_supported & (uint64_t(1) << frame_metadata)))
+            return _md_values.load(std::memory_order_relaxed)[frame_metadata];
+
         // Proceed to parse and extract the required data attribute
-        return it->second->get(*this);
+        return parser->get(*this);
     }
 
     bool frame::supports_frame_metadata(const rs2_frame_metadata_value& frame_metadata) const
     {
         // verify preconditions
-        if (!metadata_parsers)
-            return false;                         // No parsers are available or no metadata was attached
-
-        auto it = metadata_parsers.get()->find(frame_metadata);
-        if (it == metadata_parsers.get()->end())          // Possible user error - md attribute is not supported by this frame type
+        auto parser = find_metadata_parser(frame_metadata);
+        if (!parser)          // No parsers are available, no metadata was attached or the md attribute is not supported by this frame type
             return false;
 
-        return it->second->supports(*this);
+        if (cache_frame_metadata(frame_metadata, *parser))
+            return (_md_supported & (uint64_t(1) << frame_metadata)) != 0;
+
+        return parser->supports(*this);
     }
 
     int frame::get_frame_data_size() const
     {
+        // Frames referencing external memory through a continuation report the size the continuation declares
+        if (on_release.get_data() && on_release.get_size())
+            return static_cast<int>(on_release.get_size());
         return data.size();
     }
 
@@ -15,7 +15,10 @@ namespace librealsense
     class md_attribute_parser_base;
     class frame;
 
-    typedef std::map<rs2_frame_metadata_value, std::shared_ptr<md_attribute_parser_base>> metadata_parser_map;
+    // Room for the public attributes and for the internal ones (frame_metadata_internal, RS2_FRAME_METADATA_COUNT + 1
+    // to + 5), so all of them are kept in the array. Only values past RS2_FRAME_METADATA_COUNT + 7 would use the map
+    const int MAX_FRAME_METADATA_VALUES = ::RS2_FRAME_METADATA_COUNT + 8;
+    typedef enum_map<rs2_frame_metadata_value, std::shared_ptr<md_attribute_parser_base>, MAX_FRAME_METADATA_VALUES> metadata_parser_map;
 
     /*
         Each frame is attached with a static header
@@ -40,6 +43,7 @@ namespace librealsense
                                                  // if the recorder was configured to realtime mode or not
                                                  // if true, this will force any queue receiving this frame not to drop it
         uint32_t            raw_size = 0;   // The frame transmitted size (payload only)
+        uint32_t            motion_samples = 1; // Consecutive IMU samples carried by a motion frame
 
         frame_additional_data() {}
 
@@ -120,10 +124,15 @@ namespace librealsense
             r.owner.reset();
             if (owner) metadata_parsers = owner->get_md_parsers();
             if (r.metadata_parsers) metadata_parsers = std::move(r.metadata_parsers);
+            _md_claimed = 0;
+            _md_parsed = 0;
+            _md_supported = 0;
+            // the values of the other frame are stale, its buffer is kept for reuse
+            r._md_values = _md_values.exchange(r._md_values.load());
             return *this;
         }
 
-        virtual ~frame() { on_release.reset(); }
+        virtual ~frame() { on_release.reset(); delete[] _md_values.load(); }
         rs2_metadata_type get_frame_metadata(const rs2_frame_metadata_value& frame_metadata) const override;
         bool supports_frame_metadata(const rs2_frame_metadata_value& frame_metadata) const override;
         int get_frame_data_size() const override;
@@ -178,6 +187,19 @@ namespace librealsense
         bool _fixed = false;
         std::atomic_bool _kept;
         std::shared_ptr<stream_profile_interface> stream;
+
+        // Each metadata attribute is parsed on its first query and kept for the following queries of the frame.
+        // The bits of the masks are indexed by the attribute. The values are allocated on the first query,
+        // so the frames whose metadata is never queried don't pay for them
+        static const int MAX_CACHED_METADATA = 64;
+        mutable std::atomic<uint64_t> _md_claimed{ 0 };      // the attribute is being parsed or could not be cached
+        mutable std::atomic<uint64_t> _md_parsed{ 0 };       // the attribute is cached
+        mutable std::atomic<uint64_t> _md_supported{ 0 };
+        mutable std::atomic<rs2_metadata_type*> _md_values{ nullptr };
+
+        rs2_metadata_type* get_metadata_values() const;
+        const md_attribute_parser_base* find_metadata_parser(const rs2_frame_metadata_value& frame_metadata) const;
+        bool cache_frame_metadata(const rs2_frame_metadata_value& frame_metadata, const md_attribute_parser_base& parser) const;
     };
 
     class points : public frame
@@ -455,6 +477,17 @@ namespace librealsense
     public:
         motion_frame() : frame()
         {}
+
+        int get_samples_count() const { return static_cast<int>(additional_data.motion_samples); }
+
+        // A batch of samples is followed by their timestamps at the end of the frame data,
+        // a single sample is stamped by the frame timestamp
+        const rs2_time_t* get_samples_timestamps() const
+        {
+            if (get_samples_count() <= 1)
+                return &additional_data.timestamp;
+            return reinterpret_cast<const rs2_time_t*>(get_frame_data() + get_frame_data_size() - get_samples_count() * sizeof(rs2_time_t));
+        }
     };
 
     MAP_EXTENSION(RS2_EXTENSION_MOTION_FRAME, librealsense::motion_frame);
@@ -372,6 +372,11 @@ namespace librealsense
             virtual std::string get_device_location() const = 0;
             virtual usb_spec  get_usb_specification() const = 0;
 
+            // when set, a frame is released back to the driver unread if a newer one is already waiting
+            virtual void set_newest_frame_only(bool newest_only) {}
+            // frames lost at the driver boundary since the stream was started
+            virtual uint64_t get_dropped_frames_count() const { return 0; }
+
             virtual ~uvc_device() = default;
 
         protected:
@@ -389,6 +394,16 @@ namespace librealsense
                 _dev->probe_and_commit(profile, callback, buffers);
             }
 
+            void set_newest_frame_only(bool newest_only) override
+            {
+                _dev->set_newest_frame_only(newest_only);
+            }
+
+            uint64_t get_dropped_frames_count() const override
+            {
+                return _dev->get_dropped_frames_count();
+            }
+
             void stream_on(std::function<void(const notification& n)> error_handler = [](const notification& n){}) override
             {
                 _dev->stream_on(error_handler);
@@ -658,6 +673,24 @@ namespace librealsense
                 _dev[dev_index]->probe_and_commit(profile, callback, buffers);
             }
 
+            void set_newest_frame_only(bool newest_only) override
+            {
+                for (auto& dev : _dev)
+                {
+                    dev->set_newest_frame_only(newest_only);
+                }
+            }
+
+            uint64_t get_dropped_frames_count() const override
+            {
+                uint64_t count = 0;
+                for (auto& dev : _dev)
+                {
+                    count += dev->get_dropped_frames_count();
+                }
+                return count;
+            }
+
 
             void stream_on(std::function<void(const notification& n)> error_handler = [](const notification& n){}) override
             {
@@ -0,0 +1,299 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "AdaptiveCompression.h"
+#include <algorithm>
+#include <cstring>
+#include <ipDeviceCommon/RsCommon.h>
+
+#define ADAPTIVE_AVERAGE_WEIGHT 0.1
+
+namespace
+{
+    const char* getZipMethodName(ZipMethod t_zipMethod)
+    {
+        switch(t_zipMethod)
+        {
+        case ZipMethod::gzip:
+            return "gzip";
+        case ZipMethod::rvl:
+            return "rvl";
+        case ZipMethod::jpeg:
+            return "jpeg";
+        case ZipMethod::lz:
+            return "lz4";
+        case ZipMethod::rvl_bands:
+            return "rvl bands";
+        case ZipMethod::none:
+            return "none";
+        default:
+            return "unknown";
+        }
+    }
+
+    double updateAverage(double t_average, double t_sample, long long t_samples)
+    {
+        return t_samples ? t_average + ADAPTIVE_AVERAGE_WEIGHT * (t_sample - t_average) : t_sample;
+    }
+} // namespace
+
+AdaptiveCompression::AdaptiveCompression(int t_width, int t_height, rs2_format t_format, rs2_stream t_streamType, int t_bpp, ZipMethod t_fixedMethod, bool t_isAdaptive)
+    : ICompression(t_width, t_height, t_format, t_bpp)
+    , m_fixedMethod(t_fixedMethod)
+    , m_isAdaptive(t_isAdaptive)
+    , m_currentLevel(0)
+    , m_sendBacklog(0)
+    , m_maxBacklog(0)
+    , m_idleEvaluations(0)
+    , m_relaxEvaluations(ADAPTIVE_RELAX_EVALUATIONS)
+    , m_avgFrameIntervalMs(0)
+    , m_statistic({t_fixedMethod, 0, 0, 0, 0, 0, 0})
+{
+    if(t_fixedMethod == ZipMethod::jpeg)
+    {
+        m_jpeg = std::make_shared<JpegCompression>(t_width, t_height, t_format, t_bpp);
+        m_codecs[ZipMethod::jpeg] = m_jpeg;
+    }
+    if(!m_isAdaptive)
+    {
+        return;
+    }
+
+    // sending the raw frame is possible only when it fits in a message together with the header
+    if(t_width * t_height * t_bpp + sizeof(int) + sizeof(AdaptiveCompressionHeader) <= MAX_FRAME_SIZE)
+    {
+        m_levels.push_back({ZipMethod::none, 0, 0, 0, 0});
+    }
+    if(t_fixedMethod == ZipMethod::jpeg)
+    {
+        for(int quality : {90, 75, 50, 30})
+        {
+            m_levels.push_back({ZipMethod::jpeg, quality, 0, 0, 0});
+        }
+        // 75 is the default quality of the fixed JPEG compression
+        m_currentLevel = m_levels.size() - 3;
+    }
+    else if(t_streamType == RS2_STREAM_DEPTH)
+    {
+        m_levels.push_back({ZipMethod::lz, 0, 0, 0, 0});
+        m_levels.push_back({ZipMethod::rvl_bands, 0, 0, 0, 0});
+        m_currentLevel = t_fixedMethod == ZipMethod::rvl_bands ? m_levels.size() - 1 : m_levels.size() - 2;
+    }
+    else
+    {
+        m_levels.push_back({t_fixedMethod, 0, 0, 0, 0});
+        m_currentLevel = m_levels.size() - 1;
+    }
+    m_statistic.zipMethod = m_levels[m_currentLevel].zipMethod;
+    m_statistic.quality = m_levels[m_currentLevel].quality;
+}
+
+std::shared_ptr<ICompression> AdaptiveCompression::getCodec(ZipMethod t_zipMethod)
+{
+    auto codec = m_codecs.find(t_zipMethod);
+    if(codec != m_codecs.end())
+    {
+        return codec->second;
+    }
+    std::shared_ptr<ICompression> newCodec = CompressionFactory::getObject(t_zipMethod, m_width, m_height, m_format, m_bpp);
+    m_codecs[t_zipMethod] = newCodec;
+    return newCodec;
+}
+
+void AdaptiveCompression::setSendBacklog(int t_frames)
+{
+    m_sendBacklog = t_frames;
+}
+
+AdaptiveCompressionStatistic AdaptiveCompression::getStatistic()
+{
+    std::lock_guard<std::mutex> lock(m_statisticMutex);
+    return m_statistic;
+}
+
+int AdaptiveCompression::compressBuffer(unsigned char* t_buffer, int t_size, unsigned char* t_compressedBuf)
+{
+    if(!m_isAdaptive)
+    {
+        std::shared_ptr<ICompression> codec = getCodec(m_fixedMethod);
+        return codec ? codec->compressBuffer(t_buffer, t_size, t_compressedBuf) : -1;
+    }
+
+    auto encodeBegin = std::chrono::steady_clock::now();
+    if(m_compFrameCounter)
+    {
+        double frameIntervalMs = std::chrono::duration<double, std::milli>(encodeBegin - m_prevFrameTime).count();
+        m_avgFrameIntervalMs = updateAverage(m_avgFrameIntervalMs, frameIntervalMs, m_compFrameCounter - 1);
+    }
+    m_prevFrameTime = encodeBegin;
+
+    // the codecs write their size before their data, so they write at an offset that puts their data right after
+    // the size and the adaptive header, which overwrite the codec size afterwards
+    Level& level = m_levels[m_currentLevel];
+    const int headerSize = sizeof(AdaptiveCompressionHeader);
+    int payloadSize = 0;
+    if(level.zipMethod == ZipMethod::none)
+    {
+        // getMaxCompressedSize leaves room for the raw frame after the headers
+        memcpy(t_compressedBuf + sizeof(int) + headerSize, t_buffer, t_size);
+        payloadSize = t_size;
+    }
+    else
+    {
+        if(level.zipMethod == ZipMethod::jpeg)
+        {
+            m_jpeg->setQuality(level.quality);
+        }
+        std::shared_ptr<ICompression> codec = getCodec(level.zipMethod);
+        int codecSize = codec ? codec->compressBuffer(t_buffer, t_size, t_compressedBuf + headerSize) : -1;
+        if(codecSize == -1)
+        {
+            return -1;
+        }
+        payloadSize = codecSize - sizeof(int);
+    }
+    double encodeTimeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - encodeBegin).count();
+
+    AdaptiveCompressionHeader header;
+    header.magic = ADAPTIVE_COMPRESSION_MAGIC;
+    header.zipMethod = level.zipMethod;
+    header.quality = level.quality;
+    int sendBacklog = m_sendBacklog;
+    header.sendBacklog = std::min(sendBacklog, 0xFFFF);
+    header.encodeTimeUs = uint32_t(encodeTimeMs * 1000);
+    int compressedSize = headerSize + payloadSize;
+    memcpy(t_compressedBuf, &compressedSize, sizeof(compressedSize));
+    memcpy(t_compressedBuf + sizeof(compressedSize), &header, headerSize);
+
+    {
+        std::lock_guard<std::mutex> lock(m_statisticMutex);
+        level.avgEncodeTimeMs = updateAverage(level.avgEncodeTimeMs, encodeTimeMs, level.frameCount);
+        level.avgCompressionRatio = updateAverage(level.avgCompressionRatio, double(t_size) / compressedSize, level.frameCount);
+        level.frameCount++;
+        m_statistic.avgEncodeTimeMs = level.avgEncodeTimeMs;
+        m_statistic.avgCompressionRatio = level.avgCompressionRatio;
+        m_statistic.sendBacklog = sendBacklog;
+        m_statistic.frameCount++;
+    }
+    m_maxBacklog = std::max(m_maxBacklog, sendBacklog);
+    if(++m_compFrameCounter % ADAPTIVE_EVALUATION_FRAMES == 0)
+    {
+        evaluate();
+    }
+    return compressedSize + sizeof(compressedSize);
+}
+
+int AdaptiveCompression::getMaxCompressedSize(int t_size)
+{
+    if(!m_isAdaptive)
+    {
+        std::shared_ptr<ICompression> codec = getCodec(m_fixedMethod);
+        return codec ? codec->getMaxCompressedSize(t_size) : t_size;
+    }
+    // any level may be chosen before the next frame
+    int maxCodecSize = 0;
+    for(auto& level : m_levels)
+    {
+        std::shared_ptr<ICompression> codec = level.zipMethod == ZipMethod::none ? nullptr : getCodec(level.zipMethod);
+        int codecSize = codec ? codec->getMaxCompressedSize(t_size) : int(sizeof(int)) + t_size;
+        maxCodecSize = std::max(maxCodecSize, codecSize);
+    }
+    return sizeof(AdaptiveCompressionHeader) + maxCodecSize;
+}
+
+void AdaptiveCompression::evaluate()
+{
+    Level& level = m_levels[m_currentLevel];
+    size_t nextLevel = m_currentLevel;
+    if(m_maxBacklog >= ADAPTIVE_HIGH_BACKLOG)
+    {
+        // the link does not keep up, wait longer before trying a weaker compression again
+        nextLevel = std::min(m_currentLevel + 1, m_levels.size() - 1);
+        m_idleEvaluations = 0;
+        m_relaxEvaluations = std::min(2 * m_relaxEvaluations, ADAPTIVE_MAX_RELAX_EVALUATIONS);
+    }
+    else if(m_avgFrameIntervalMs > 0 && level.avgEncodeTimeMs > ADAPTIVE_CPU_BUDGET * m_avgFrameIntervalMs)
+    {
+        // the encoder does not keep up with the stream
+        nextLevel = m_currentLevel ? m_currentLevel - 1 : 0;
+        m_idleEvaluations = 0;
+    }
+    else if(m_maxBacklog == 0 && ++m_idleEvaluations >= m_relaxEvaluations)
+    {
+        nextLevel = m_currentLevel ? m_currentLevel - 1 : 0;
+        m_idleEvaluations = 0;
+    }
+    m_maxBacklog = 0;
+    if(nextLevel == m_currentLevel)
+    {
+        return;
+    }
+
+    Level& next = m_levels[nextLevel];
+    INF << "compression switched from " << getZipMethodName(level.zipMethod) << " " << level.quality << " to " << getZipMethodName(next.zipMethod) << " " << next.quality
+        << ", encode time " << level.avgEncodeTimeMs << " ms, ratio " << level.avgCompressionRatio << ", frame interval " << m_avgFrameIntervalMs << " ms";
+    m_currentLevel = nextLevel;
+    std::lock_guard<std::mutex> lock(m_statisticMutex);
+    m_statistic.zipMethod = next.zipMethod;
+    m_statistic.quality = next.quality;
+    m_statistic.switchCount++;
+}
+
+int AdaptiveCompression::decompressBuffer(unsigned char* t_buffer, int t_size, unsigned char* t_uncompressedBuf)
+{
+    const int headerSize = sizeof(AdaptiveCompressionHeader);
+    AdaptiveCompressionHeader header;
+    if(t_size >= headerSize)
+    {
+        memcpy(&header, t_buffer, headerSize);
+    }
+    if(t_size < headerSize || header.magic != ADAPTIVE_COMPRESSION_MAGIC)
+    {
+        std::shared_ptr<ICompression> codec = getCodec(m_fixedMethod);
+        return codec ? codec->decompressBuffer(t_buffer, t_size, t_uncompressedBuf) : -1;
+    }
+    if(header.zipMethod > ZipMethod::none)
+    {
+        ERR << "unknown zip method " << int(header.zipMethod);
+        return -1;
+    }
+
+    ZipMethod zipMethod = ZipMethod(header.zipMethod);
+    int payloadSize = t_size - headerSize;
+    int uncompressedSize;
+    if(zipMethod == ZipMethod::none)
+    {
+        uncompressedSize = m_width * m_height * m_bpp;
+        if(payloadSize != uncompressedSize)
+        {
+            ERR << "uncompressed frame of " << payloadSize << " bytes, expected " << uncompressedSize;
+            return -1;
+        }
+        memcpy(t_uncompressedBuf, t_buffer + headerSize, payloadSize);
+    }
+    else
+    {
+        std::shared_ptr<ICompression> codec = getCodec(zipMethod);
+        uncompressedSize = codec ? codec->decompressBuffer(t_buffer + headerSize, payloadSize, t_uncompressedBuf) : -1;
+        if(uncompressedSize == -1)
+        {
+            return -1;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_statisticMutex);
+    if(m_statistic.frameCount && (m_statistic.zipMethod != zipMethod || m_statistic.quality != header.quality))
+    {
+        m_statistic.switchCount++;
+        INF << "server switched compression from " << getZipMethodName(m_statistic.zipMethod) << " " << m_statistic.quality << " to " << getZipMethodName(zipMethod) << " " << int(header.quality)
+            << ", send backlog " << header.sendBacklog << " frames, encode time " << m_statistic.avgEncodeTimeMs << " ms, ratio " << m_statistic.avgCompressionRatio;
+    }
+    m_statistic.zipMethod = zipMethod;
+    m_statistic.quality = header.quality;
+    m_statistic.avgEncodeTimeMs = updateAverage(m_statistic.avgEncodeTimeMs, header.encodeTimeUs / 1000.0, m_statistic.frameCount);
+    m_statistic.avgCompressionRatio = updateAverage(m_statistic.avgCompressionRatio, double(uncompressedSize) / t_size, m_statistic.frameCount);
+    m_statistic.sendBacklog = header.sendBacklog;
+    m_statistic.frameCount++;
+    m_decompFrameCounter++;
+    return uncompressedSize;
+}
@@ -0,0 +1,90 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "CompressionFactory.h"
+#include "JpegCompression.h"
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#define ADAPTIVE_COMPRESSION_MAGIC 0x50434441 // "ADCP"
+#define ADAPTIVE_EVALUATION_FRAMES 30 // frames between two decisions, a switch never happens in between
+#define ADAPTIVE_HIGH_BACKLOG 2 // frames waiting to be sent that call for a stronger compression
+#define ADAPTIVE_RELAX_EVALUATIONS 3 // idle decisions before trying a weaker compression again
+#define ADAPTIVE_MAX_RELAX_EVALUATIONS 48
+#define ADAPTIVE_CPU_BUDGET 0.8 // part of the frame interval the encoder may take
+
+#pragma pack(push, 1)
+// precedes the payload of every frame that is encoded in adaptive mode
+struct AdaptiveCompressionHeader
+{
+    uint32_t magic;
+    uint8_t zipMethod;
+    uint8_t quality;
+    uint16_t sendBacklog;
+    uint32_t encodeTimeUs;
+};
+#pragma pack(pop)
+
+struct AdaptiveCompressionStatistic
+{
+    ZipMethod zipMethod;
+    int quality;
+    double avgEncodeTimeMs;
+    double avgCompressionRatio;
+    int sendBacklog;
+    long long switchCount;
+    long long frameCount;
+};
+
+// Chooses the codec of a stream while it is streaming.
+// The encoder measures the encoded size, the encode time and the frames that wait to be sent, and every
+// ADAPTIVE_EVALUATION_FRAMES frames moves one step between no compression and the strongest compression of the stream.
+// Every frame carries the method it was encoded with, so the decoder follows the switches, and data without the
+// header is decoded with the fixed method of the stream. When adaptive mode is disabled the encoder uses the fixed
+// method and writes the same data as that codec.
+class AdaptiveCompression : public ICompression
+{
+public:
+    AdaptiveCompression(int t_width, int t_height, rs2_format t_format, rs2_stream t_streamType, int t_bpp, ZipMethod t_fixedMethod, bool t_isAdaptive);
+    int compressBuffer(unsigned char* t_buffer, int t_size, unsigned char* t_compressedBuf);
+    int decompressBuffer(unsigned char* t_buffer, int t_size, unsigned char* t_uncompressedBuf);
+    int getMaxCompressedSize(int t_size);
+
+    // number of encoded frames that wait to be sent, reported by the sender
+    void setSendBacklog(int t_frames);
+    AdaptiveCompressionStatistic getStatistic();
+
+private:
+    struct Level
+    {
+        ZipMethod zipMethod;
+        int quality;
+        double avgEncodeTimeMs;
+        double avgCompressionRatio;
+        long long frameCount;
+    };
+
+    std::shared_ptr<ICompression> getCodec(ZipMethod t_zipMethod);
+    void evaluate();
+
+    ZipMethod m_fixedMethod;
+    bool m_isAdaptive;
+    std::vector<Level> m_levels; // ordered from the weakest to the strongest compression
+    size_t m_currentLevel;
+    std::map<ZipMethod, std::shared_ptr<ICompression>> m_codecs;
+    std::shared_ptr<JpegCompression> m_jpeg;
+
+    std::atomic<int> m_sendBacklog;
+    int m_maxBacklog;
+    int m_idleEvaluations, m_relaxEvaluations;
+    std::chrono::steady_clock::time_point m_prevFrameTime;
+    double m_avgFrameIntervalMs;
+
+    std::mutex m_statisticMutex;
+    AdaptiveCompressionStatistic m_statistic;
+};
@@ -2,8 +2,10 @@
 // Copyright(c) 2020 Intel Corporation. All Rights Reserved.
 
 #include "CompressionFactory.h"
+#include "AdaptiveCompression.h"
 #include "JpegCompression.h"
 #include "Lz4Compression.h"
+#include "RvlBandsCompression.h"
 #include "RvlCompression.h"
 
 std::shared_ptr<ICompression> CompressionFactory::getObject(int t_width, int t_height, rs2_format t_format, rs2_stream t_streamType, int t_bpp)
@@ -15,18 +17,25 @@ std::shared_ptr<ICompression> CompressionFactory::getObject(int t_width, int t_h
     }
     else if(t_streamType == RS2_STREAM_DEPTH)
     {
-        zipMeth = ZipMethod::lz;
+        zipMeth = getDepthZipMethod();
     }
     if(!isCompressionSupported(t_format, t_streamType))
     {
         return nullptr;
     }
+    return std::make_shared<AdaptiveCompression>(t_width, t_height, t_format, t_streamType, t_bpp, zipMeth, getIsAdaptive());
+}
 
-    switch(zipMeth)
+std::shared_ptr<ICompression> CompressionFactory::getObject(ZipMethod t_zipMethod, int t_width, int t_height, rs2_format t_format, int t_bpp)
+{
+    switch(t_zipMethod)
     {
     case ZipMethod::rvl:
         return std::make_shared<RvlCompression>(t_width, t_height, t_format, t_bpp);
         break;
+    case ZipMethod::rvl_bands:
+        return std::make_shared<RvlBandsCompression>(t_width, t_height, t_format, t_bpp);
+        break;
     case ZipMethod::jpeg:
         return std::make_shared<JpegCompression>(t_width, t_height, t_format, t_bpp);
         break;
@@ -45,6 +54,52 @@ bool& CompressionFactory::getIsEnabled()
     return m_isEnabled;
 }
 
+ZipMethod& CompressionFactory::getDepthZipMethod()
+{
+    static ZipMethod m_depthZipMethod = ZipMethod::lz;
+    return m_depthZipMethod;
+}
+
+bool CompressionFactory::getDepthZipMethod(const std::string& t_name, ZipMethod& t_zipMethod)
+{
+    if(t_name == "lz4")
+    {
+        t_zipMethod = ZipMethod::lz;
+    }
+    else if(t_name == "rvl")
+    {
+        t_zipMethod = ZipMethod::rvl;
+    }
+    else if(t_name == "rvl_bands")
+    {
+        t_zipMethod = ZipMethod::rvl_bands;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+const char* CompressionFactory::getDepthZipMethodName(ZipMethod t_zipMethod)
+{
+    switch(t_zipMethod)
+    {
+    case ZipMethod::rvl:
+        return "rvl";
+    case ZipMethod::rvl_bands:
+        return "rvl_bands";
+    default:
+        return "lz4";
+    }
+}
+
+bool& CompressionFactory::getIsAdaptive()
+{
+    static bool m_isAdaptive = false;
+    return m_isAdaptive;
+}
+
 bool CompressionFactory::isCompressionSupported(rs2_format t_format, rs2_stream t_streamType)
 {
     if(getIsEnabled() == 0)
@@ -12,12 +12,25 @@ typedef enum ZipMethod
     rvl,
     jpeg,
     lz,
+    rvl_bands,
+    none,
 } ZipMethod;
 
 class CompressionFactory
 {
 public:
+    // codec of a stream, it follows the switches of a server that adapts the compression to the link
     static std::shared_ptr<ICompression> getObject(int t_width, int t_height, rs2_format t_format, rs2_stream t_streamType, int t_bpp);
+    static std::shared_ptr<ICompression> getObject(ZipMethod t_zipMethod, int t_width, int t_height, rs2_format t_format, int t_bpp);
     static bool isCompressionSupported(rs2_format t_format, rs2_stream t_streamType);
     static bool& getIsEnabled();
+    // Method used for depth streams. the server sends its method in the SDP of its depth streams, and the clients
+    // set it here before creating their decoders
+    static ZipMethod& getDepthZipMethod();
+    // returns false when t_name is not the name of a depth method
+    static bool getDepthZipMethod(const std::string& t_name, ZipMethod& t_zipMethod);
+    // name of a depth method, as sent in the SDP and taken on the server command line
+    static const char* getDepthZipMethodName(ZipMethod t_zipMethod);
+    // when enabled the encoders switch between the methods of their stream according to the measured throughput
+    static bool& getIsAdaptive();
 };
@@ -14,6 +14,8 @@ public:
         m_width(t_width),m_height(t_height), m_format(t_format), m_bpp(t_bpp) {};
     virtual int compressBuffer(unsigned char* t_buffer, int t_size, unsigned char* t_compressedBuf) = 0;
     virtual int decompressBuffer(unsigned char* t_buffer, int t_size, unsigned char* t_uncompressedBuf) = 0;
+    // largest number of bytes compressBuffer may write for an input of t_size bytes, the size it writes first included
+    virtual int getMaxCompressedSize(int t_size) = 0;
 
 protected:
     int m_width, m_height, m_bpp;
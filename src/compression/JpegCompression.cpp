@@ -48,6 +48,11 @@ JpegCompression::~JpegCompression()
     jpeg_destroy_compress(&m_cinfo);
 }
 
+void JpegCompression::setQuality(int t_quality)
+{
+    jpeg_set_quality(&m_cinfo, t_quality, TRUE);
+}
+
 void JpegCompression::convertYUYVtoYUV(unsigned char** t_buffer)
 {
     for(int i = 0; i < m_cinfo.image_width; i += 2)
@@ -176,6 +181,12 @@ int JpegCompression::compressBuffer(unsigned char* t_buffer, int t_size, unsigne
     return compressWithHeaderSize;
 }
 
+int JpegCompression::getMaxCompressedSize(int t_size)
+{
+    // the encoder writes to its own buffer, and copies to the destination only a result that is not larger than the input
+    return t_size;
+}
+
 int JpegCompression::decompressBuffer(unsigned char* t_buffer, int t_compressedSize, unsigned char* t_uncompressedBuf)
 {
     unsigned char* ptr = t_uncompressedBuf;
@@ -14,6 +14,8 @@ public:
     ~JpegCompression();
     int compressBuffer(unsigned char* t_buffer, int t_size, unsigned char* t_compressedBuf);
     int decompressBuffer(unsigned char* t_buffer, int t_size, unsigned char* t_uncompressedBuf);
+    int getMaxCompressedSize(int t_size);
+    void setQuality(int t_quality);
 
 private:
     void convertYUYVtoYUV(unsigned char** t_buffer);
@@ -34,6 +34,12 @@ int Lz4Compression::compressBuffer(unsigned char* t_buffer, int t_size, unsigned
     return compressWithHeaderSize;
 }
 
+int Lz4Compression::getMaxCompressedSize(int t_size)
+{
+    // LZ4 writes its output before the size is checked against the input size
+    return sizeof(int) + LZ4_compressBound(t_size);
+}
+
 int Lz4Compression::decompressBuffer(unsigned char* t_buffer, int t_compressedSize, unsigned char* t_uncompressedBuf)
 {
     const int decompressed_size = LZ4_decompress_safe((const char*)t_buffer, (char*)t_uncompressedBuf, t_compressedSize, m_width * m_height * m_bpp);
@@ -12,4 +12,5 @@ public:
     Lz4Compression(int t_width, int t_height, rs2_format t_format, int t_bpp);
     int compressBuffer(unsigned char* t_buffer, int t_size, unsigned char* t_compressedBuf);
     int decompressBuffer(unsigned char* t_buffer, int t_size, unsigned char* t_uncompressedBuf);
+    int getMaxCompressedSize(int t_size);
 };
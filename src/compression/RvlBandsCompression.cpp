@@ -0,0 +1,417 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "RvlBandsCompression.h"
+#include <algorithm>
+#include <cstring>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+    // Same 3 bit nibble coding as the legacy RVL, kept local to the band that is being coded
+    class NibbleWriter
+    {
+    public:
+        NibbleWriter(std::vector<int>& t_words)
+            : m_words(t_words)
+            , m_word(0)
+            , m_nibbles(0)
+        {
+        }
+
+        void put(int t_value)
+        {
+            do
+            {
+                int nibble = t_value & 0x7;
+                if(t_value >>= 3)
+                    nibble |= 0x8;
+                m_word = (m_word << 4) | nibble;
+                if(++m_nibbles == 8)
+                {
+                    m_words.push_back(m_word);
+                    m_nibbles = 0;
+                    m_word = 0;
+                }
+            } while(t_value);
+        }
+
+        void flush()
+        {
+            if(m_nibbles)
+                m_words.push_back(m_word << 4 * (8 - m_nibbles));
+            m_nibbles = 0;
+            m_word = 0;
+        }
+
+    private:
+        std::vector<int>& m_words;
+        int m_word;
+        int m_nibbles;
+    };
+
+    class NibbleReader
+    {
+    public:
+        NibbleReader(const int* t_words, const int* t_wordsEnd)
+            : m_words(t_words)
+            , m_wordsEnd(t_wordsEnd)
+            , m_word(0)
+            , m_nibbles(0)
+        {
+        }
+
+        // returns -1 when the data ends in the middle of a value
+        int get()
+        {
+            unsigned int nibble;
+            int value = 0, shift = 0;
+            do
+            {
+                if(!m_nibbles)
+                {
+                    if(m_words == m_wordsEnd)
+                        return -1;
+                    memcpy(&m_word, m_words++, sizeof(m_word));
+                    m_nibbles = 8;
+                }
+                nibble = m_word >> 28;
+                m_word <<= 4;
+                m_nibbles--;
+                if(shift > 27)
+                    return -1;
+                value |= (nibble & 0x7) << shift;
+                shift += 3;
+            } while(nibble & 0x8);
+            return value;
+        }
+
+    private:
+        const int* m_words;
+        const int* m_wordsEnd;
+        unsigned int m_word;
+        int m_nibbles;
+    };
+
+    int countZeros(const short* t_pixels, const short* t_end)
+    {
+        const short* p = t_pixels;
+#ifdef __SSE2__
+        const __m128i zero = _mm_setzero_si128();
+        while(t_end - p >= 8 && _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_loadu_si128((const __m128i*)p), zero)) == 0xFFFF)
+            p += 8;
+#endif
+        while(p != t_end && !*p)
+            p++;
+        return int(p - t_pixels);
+    }
+
+    int countNonZeros(const short* t_pixels, const short* t_end)
+    {
+        const short* p = t_pixels;
+#ifdef __SSE2__
+        const __m128i zero = _mm_setzero_si128();
+        while(t_end - p >= 8 && _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_loadu_si128((const __m128i*)p), zero)) == 0)
+            p += 8;
+#endif
+        while(p != t_end && *p)
+            p++;
+        return int(p - t_pixels);
+    }
+
+    // writes the zigzag coded differences between consecutive pixels of a run
+    void zigzagDeltas(const short* t_pixels, int t_numPixels, short t_previous, int* t_deltas)
+    {
+        if(!t_numPixels)
+            return;
+        int delta = t_pixels[0] - t_previous;
+        t_deltas[0] = (delta << 1) ^ (delta >> 31);
+        int i = 1;
+#ifdef __SSE2__
+        for(; i + 8 <= t_numPixels; i += 8)
+        {
+            __m128i current = _mm_loadu_si128((const __m128i*)(t_pixels + i));
+            __m128i previous = _mm_loadu_si128((const __m128i*)(t_pixels + i - 1));
+            // sign extend to 32 bits, the difference of two shorts does not fit in 16 bits
+            __m128i currentLow = _mm_srai_epi32(_mm_unpacklo_epi16(current, current), 16);
+            __m128i currentHigh = _mm_srai_epi32(_mm_unpackhi_epi16(current, current), 16);
+            __m128i previousLow = _mm_srai_epi32(_mm_unpacklo_epi16(previous, previous), 16);
+            __m128i previousHigh = _mm_srai_epi32(_mm_unpackhi_epi16(previous, previous), 16);
+            __m128i deltaLow = _mm_sub_epi32(currentLow, previousLow);
+            __m128i deltaHigh = _mm_sub_epi32(currentHigh, previousHigh);
+            _mm_storeu_si128((__m128i*)(t_deltas + i), _mm_xor_si128(_mm_slli_epi32(deltaLow, 1), _mm_srai_epi32(deltaLow, 31)));
+            _mm_storeu_si128((__m128i*)(t_deltas + i + 4), _mm_xor_si128(_mm_slli_epi32(deltaHigh, 1), _mm_srai_epi32(deltaHigh, 31)));
+        }
+#endif
+        for(; i < t_numPixels; i++)
+        {
+            delta = t_pixels[i] - t_pixels[i - 1];
+            t_deltas[i] = (delta << 1) ^ (delta >> 31);
+        }
+    }
+
+    uint32_t readHeaderField(const unsigned char* t_buffer, int t_index)
+    {
+        uint32_t value;
+        memcpy(&value, t_buffer + t_index * sizeof(value), sizeof(value));
+        return value;
+    }
+
+    void writeHeaderField(unsigned char* t_buffer, int t_index, uint32_t t_value)
+    {
+        memcpy(t_buffer + t_index * sizeof(t_value), &t_value, sizeof(t_value));
+    }
+} // namespace
+
+RvlBandsCompression::RvlBandsCompression(int t_width, int t_height, rs2_format t_format, int t_bpp)
+    : ICompression(t_width, t_height, t_format, t_bpp)
+    , m_legacy(t_width, t_height, t_format, t_bpp)
+    , m_job(nullptr)
+    , m_jobBands(0)
+    , m_jobSequence(0)
+    , m_busyWorkers(0)
+    , m_isStopping(false)
+    , m_nextBand(0)
+{
+    int cores = std::max(1, int(std::thread::hardware_concurrency()));
+    m_numBands = std::max(1, std::min(std::min(cores, RVL_BANDS_MAX_BANDS), t_height));
+    m_bandWords.resize(m_numBands);
+    m_bandDeltas.resize(m_numBands);
+    // the calling thread codes bands as well
+    for(int i = 1; i < m_numBands; i++)
+    {
+        m_workers.push_back(std::thread(&RvlBandsCompression::workerLoop, this));
+    }
+}
+
+RvlBandsCompression::~RvlBandsCompression()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_workersMutex);
+        m_isStopping = true;
+    }
+    m_jobReady.notify_all();
+    for(auto& worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+void RvlBandsCompression::runBands(int t_numBands, const std::function<void(int)>& t_job)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_workersMutex);
+        m_job = &t_job;
+        m_jobBands = t_numBands;
+        m_nextBand = 0;
+        m_busyWorkers = int(m_workers.size());
+        m_jobSequence++;
+    }
+    m_jobReady.notify_all();
+    takeBands(t_job, t_numBands);
+    std::unique_lock<std::mutex> lock(m_workersMutex);
+    m_jobDone.wait(lock, [this]() { return m_busyWorkers == 0; });
+    m_job = nullptr;
+}
+
+void RvlBandsCompression::takeBands(const std::function<void(int)>& t_job, int t_numBands)
+{
+    for(int band = m_nextBand++; band < t_numBands; band = m_nextBand++)
+    {
+        t_job(band);
+    }
+}
+
+void RvlBandsCompression::workerLoop()
+{
+    unsigned long long doneSequence = 0;
+    std::unique_lock<std::mutex> lock(m_workersMutex);
+    while(true)
+    {
+        m_jobReady.wait(lock, [&]() { return m_isStopping || m_jobSequence != doneSequence; });
+        if(m_isStopping)
+        {
+            return;
+        }
+        doneSequence = m_jobSequence;
+        const std::function<void(int)>* job = m_job;
+        int numBands = m_jobBands;
+        lock.unlock();
+        takeBands(*job, numBands);
+        lock.lock();
+        if(--m_busyWorkers == 0)
+        {
+            m_jobDone.notify_one();
+        }
+    }
+}
+
+std::vector<RvlBandsCompression::Band> RvlBandsCompression::getBands(int t_numPixels, int t_numBands) const
+{
+    std::vector<Band> bands;
+    int rowsPerBand = (m_height + t_numBands - 1) / t_numBands;
+    for(int i = 0; i < t_numBands; i++)
+    {
+        int first = std::min(i * rowsPerBand * m_width, t_numPixels);
+        int last = std::min((i + 1) * rowsPerBand * m_width, t_numPixels);
+        bands.push_back({first, last - first});
+    }
+    return bands;
+}
+
+void RvlBandsCompression::encodeBand(const short* t_pixels, int t_numPixels, std::vector<int>& t_words, std::vector<int>& t_deltas)
+{
+    t_words.clear();
+    t_deltas.resize(t_numPixels);
+    NibbleWriter writer(t_words);
+    const short* end = t_pixels + t_numPixels;
+    short previous = 0;
+    while(t_pixels != end)
+    {
+        int zeros = countZeros(t_pixels, end);
+        t_pixels += zeros;
+        writer.put(zeros);
+        int nonzeros = countNonZeros(t_pixels, end);
+        writer.put(nonzeros);
+        zigzagDeltas(t_pixels, nonzeros, previous, t_deltas.data());
+        for(int i = 0; i < nonzeros; i++)
+            writer.put(t_deltas[i]);
+        if(nonzeros)
+            previous = t_pixels[nonzeros - 1];
+        t_pixels += nonzeros;
+    }
+    writer.flush();
+}
+
+bool RvlBandsCompression::decodeBand(const int* t_words, const int* t_wordsEnd, short* t_pixels, int t_numPixels)
+{
+    NibbleReader reader(t_words, t_wordsEnd);
+    short previous = 0;
+    while(t_numPixels)
+    {
+        int zeros = reader.get();
+        if(zeros < 0 || zeros > t_numPixels)
+            return false;
+        memset(t_pixels, 0, zeros * sizeof(short));
+        t_pixels += zeros;
+        t_numPixels -= zeros;
+        int nonzeros = reader.get();
+        if(nonzeros < 0 || nonzeros > t_numPixels || (!zeros && !nonzeros))
+            return false;
+        t_numPixels -= nonzeros;
+        for(; nonzeros; nonzeros--)
+        {
+            int positive = reader.get();
+            if(positive < 0)
+                return false;
+            int delta = (positive >> 1) ^ -(positive & 1);
+            previous = short(previous + delta);
+            *t_pixels++ = previous;
+        }
+    }
+    return true;
+}
+
+int RvlBandsCompression::compressBuffer(unsigned char* t_buffer, int t_size, unsigned char* t_compressedBuf)
+{
+    const short* pixels = (const short*)t_buffer;
+    std::vector<Band> bands = getBands(t_size / sizeof(short), m_numBands);
+
+    runBands(m_numBands, [&](int i) {
+        encodeBand(pixels + bands[i].firstPixel, bands[i].numPixels, m_bandWords[i], m_bandDeltas[i]);
+    });
+
+    int headerSize = int((3 + m_numBands) * sizeof(uint32_t));
+    int compressedSize = headerSize;
+    for(auto& words : m_bandWords)
+        compressedSize += int(words.size() * sizeof(int));
+    int compressWithHeaderSize = compressedSize + sizeof(compressedSize);
+    if(compressWithHeaderSize > t_size)
+    {
+        ERR << "Compression overflow, destination buffer is smaller than the compressed size";
+        return -1;
+    }
+
+    memcpy(t_compressedBuf, &compressedSize, sizeof(compressedSize));
+    unsigned char* compressed = t_compressedBuf + sizeof(compressedSize);
+    writeHeaderField(compressed, 0, RVL_BANDS_MAGIC);
+    writeHeaderField(compressed, 1, RVL_BANDS_VERSION);
+    writeHeaderField(compressed, 2, m_numBands);
+    int offset = headerSize;
+    for(int i = 0; i < m_numBands; i++)
+    {
+        writeHeaderField(compressed, 3 + i, offset);
+        memcpy(compressed + offset, m_bandWords[i].data(), m_bandWords[i].size() * sizeof(int));
+        offset += int(m_bandWords[i].size() * sizeof(int));
+    }
+    if(m_compFrameCounter++ % 50 == 0)
+    {
+        INF << "frame " << m_compFrameCounter << "\tdepth\tcompression\trvl bands\t" << t_size << "\t/\t" << compressedSize;
+    }
+    return compressWithHeaderSize;
+}
+
+int RvlBandsCompression::getMaxCompressedSize(int t_size)
+{
+    // the bands are coded to their own buffers, and copied to the destination only when they fit in the input size
+    return t_size;
+}
+
+int RvlBandsCompression::decompressBuffer(unsigned char* t_buffer, int t_size, unsigned char* t_uncompressedBuf)
+{
+    if(t_size < int(3 * sizeof(uint32_t)) || readHeaderField(t_buffer, 0) != RVL_BANDS_MAGIC)
+    {
+        return m_legacy.decompressBuffer(t_buffer, t_size, t_uncompressedBuf);
+    }
+    uint32_t version = readHeaderField(t_buffer, 1);
+    if(version != RVL_BANDS_VERSION)
+    {
+        ERR << "unsupported rvl bands version " << version;
+        return -1;
+    }
+    uint32_t numBands = readHeaderField(t_buffer, 2);
+    if(numBands == 0 || numBands > uint32_t(m_height) || (3 + numBands) * sizeof(uint32_t) > uint32_t(t_size))
+    {
+        ERR << "corrupted rvl bands header, band count " << numBands;
+        return -1;
+    }
+    std::vector<uint32_t> offsets;
+    for(uint32_t i = 0; i < numBands; i++)
+    {
+        offsets.push_back(readHeaderField(t_buffer, 3 + i));
+    }
+    offsets.push_back(t_size);
+    for(uint32_t i = 0; i < numBands; i++)
+    {
+        if(offsets[i] > offsets[i + 1] || offsets[i] < (3 + numBands) * sizeof(uint32_t))
+        {
+            ERR << "corrupted rvl bands offset table";
+            return -1;
+        }
+    }
+
+    int numPixels = m_width * m_height;
+    std::vector<Band> bands = getBands(numPixels, numBands);
+    short* pixels = (short*)t_uncompressedBuf;
+    std::atomic<bool> isValid(true);
+    runBands(int(numBands), [&](int i) {
+        if(!decodeBand((const int*)(t_buffer + offsets[i]), (const int*)(t_buffer + offsets[i] + (offsets[i + 1] - offsets[i]) / sizeof(int) * sizeof(int)), pixels + bands[i].firstPixel, bands[i].numPixels))
+        {
+            isValid = false;
+        }
+    });
+    if(!isValid)
+    {
+        ERR << "corrupted rvl bands data";
+        return -1;
+    }
+
+    int uncompressedSize = numPixels * sizeof(short);
+    if(m_decompFrameCounter++ % 50 == 0)
+    {
+        INF << "frame " << m_decompFrameCounter << "\tdepth\tdecompression\trvl bands\t" << t_size << "\t/\t" << uncompressedSize;
+    }
+    return uncompressedSize;
+}
@@ -0,0 +1,63 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "ICompression.h"
+#include "RvlCompression.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#define RVL_BANDS_MAGIC 0x424C5652 // "RVLB"
+#define RVL_BANDS_VERSION 1
+#define RVL_BANDS_MAX_BANDS 8
+
+// RVL variant that codes the frame as independent bands of rows, so that the bands are encoded and decoded in parallel.
+// The compressed data starts with a versioned header that is followed by the coded bands:
+//   magic | version | band count | offset of each band from the start of the compressed data | bands
+// Data that does not start with the header is decoded as legacy RVL.
+// The bands are coded by worker threads that live as long as the codec, together with the calling thread.
+class RvlBandsCompression : public ICompression
+{
+public:
+    RvlBandsCompression(int t_width, int t_height, rs2_format t_format, int t_bpp);
+    ~RvlBandsCompression();
+    int compressBuffer(unsigned char* t_buffer, int t_size, unsigned char* t_compressedBuf);
+    int decompressBuffer(unsigned char* t_buffer, int t_size, unsigned char* t_uncompressedBuf);
+    int getMaxCompressedSize(int t_size);
+
+private:
+    struct Band
+    {
+        int firstPixel;
+        int numPixels;
+    };
+
+    std::vector<Band> getBands(int t_numPixels, int t_numBands) const;
+    static void encodeBand(const short* t_pixels, int t_numPixels, std::vector<int>& t_words, std::vector<int>& t_deltas);
+    static bool decodeBand(const int* t_words, const int* t_wordsEnd, short* t_pixels, int t_numPixels);
+    // calls t_job for every band on the workers and the calling thread, and returns when all the bands are done
+    void runBands(int t_numBands, const std::function<void(int)>& t_job);
+    void takeBands(const std::function<void(int)>& t_job, int t_numBands);
+    void workerLoop();
+
+    int m_numBands;
+    std::vector<std::vector<int>> m_bandWords;
+    std::vector<std::vector<int>> m_bandDeltas;
+    RvlCompression m_legacy;
+
+    std::vector<std::thread> m_workers;
+    std::mutex m_workersMutex;
+    std::condition_variable m_jobReady, m_jobDone;
+    const std::function<void(int)>* m_job;
+    int m_jobBands;
+    unsigned long long m_jobSequence;
+    int m_busyWorkers;
+    bool m_isStopping;
+    std::atomic<int> m_nextBand;
+};
@@ -40,6 +40,8 @@ int RvlCompression::decodeVLE()
     {
         if(!m_nibblesWritten)
         {
+            if(m_pBuffer == m_pBufferEnd)
+                return -1; // the data ends in the middle of a value
             m_word = *m_pBuffer++; // load word
             m_nibblesWritten = 8;
         }
@@ -95,25 +97,53 @@ int RvlCompression::compressBuffer(unsigned char* t_buffer, int t_size, unsigned
     return compressWithHeaderSize;
 }
 
+int RvlCompression::getMaxCompressedSize(int t_size)
+{
+    // the output is written before its size is checked. a delta of two pixels takes at most 6 nibbles and a run
+    // length n at most max(n, 1) nibbles, so every pixel takes at most 7 nibbles, with 2 more for the first zeros run
+    // and the last nonzeros run
+    int numPixels = t_size / m_bpp;
+    int nibbles = 7 * numPixels + 2;
+    return sizeof(int) + (nibbles + 7) / 8 * sizeof(int);
+}
+
 int RvlCompression::decompressBuffer(unsigned char* t_buffer, int t_size, unsigned char* t_uncompressedBuf)
 {
+    // the data starts after the size written by the encoder, and is decoded up to the pixels of a frame.
+    // the decoder used to skip one more word and to take half the data size as the number of pixels, which did not match
+    // the encoder. servers before the depth method selection always sent lz4 depth, so no server depends on that layout
     short* currentPtr = (short*)t_uncompressedBuf;
-    m_pBuffer = (int*)t_buffer + 1;
+    m_pBuffer = (int*)t_buffer;
+    m_pBufferEnd = m_pBuffer + t_size / sizeof(int);
     m_nibblesWritten = 0;
     short current, previous = 0;
-    unsigned int compressedSize;
-    int numPixelsToDecode = t_size / 2;
+    int numPixelsToDecode = m_width * m_height;
     while(numPixelsToDecode)
     {
         int zeros = decodeVLE();
+        if(zeros < 0 || zeros > numPixelsToDecode)
+        {
+            ERR << "corrupted rvl data";
+            return -1;
+        }
         numPixelsToDecode -= zeros;
         for(; zeros; zeros--)
             *currentPtr++ = 0;
         int nonzeros = decodeVLE();
+        if(nonzeros < 0 || nonzeros > numPixelsToDecode)
+        {
+            ERR << "corrupted rvl data";
+            return -1;
+        }
         numPixelsToDecode -= nonzeros;
         for(; nonzeros; nonzeros--)
         {
             int positive = decodeVLE();
+            if(positive < 0)
+            {
+                ERR << "corrupted rvl data";
+                return -1;
+            }
             int delta = (positive >> 1) ^ -(positive & 1);
             current = previous + delta;
             *currentPtr++ = current;
@@ -123,7 +153,7 @@ int RvlCompression::decompressBuffer(unsigned char* t_buffer, int t_size, unsign
     int uncompressedSize = int((char*)currentPtr - (char*)t_uncompressedBuf);
     if(m_decompFrameCounter++ % 50 == 0)
     {
-        INF << "frame " << m_decompFrameCounter << "\tdepth\tcompression\tlz4\t" << compressedSize << "\t/\t" << uncompressedSize;
+        INF << "frame " << m_decompFrameCounter << "\tdepth\tdecompression\trvl\t" << t_size << "\t/\t" << uncompressedSize;
     }
     return uncompressedSize;
 }
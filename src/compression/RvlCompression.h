@@ -11,9 +11,10 @@ public:
     RvlCompression(int t_width, int t_height, rs2_format t_format, int t_bpp);
     int compressBuffer(unsigned char* t_buffer, int t_size, unsigned char* t_compressedBuf);
     int decompressBuffer(unsigned char* t_buffer, int t_size, unsigned char* t_uncompressedBuf);
+    int getMaxCompressedSize(int t_size);
 
 private:
     int encodeVLE(int value);
     int decodeVLE();
-    int *m_pBuffer, m_word, m_nibblesWritten;
+    int *m_pBuffer, *m_pBufferEnd, m_word, m_nibblesWritten;
 };
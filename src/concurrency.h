@@ -132,6 +132,14 @@ public:
         _accepting = true;
     }
 
+    void set_capacity(unsigned int cap)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _cap = cap;
+        lock.unlock();
+        _enq_cv.notify_all();
+    }
+
     size_t size()
     {
         std::unique_lock<std::mutex> lock(_mutex);
@@ -348,6 +356,11 @@ public:
         return _queue.size() == 0;
     }
 
+    void set_capacity(unsigned int cap)
+    {
+        _queue.set_capacity(cap);
+    }
+
 private:
     friend cancellable_timer;
     single_consumer_queue<std::function<void(cancellable_timer)>> _queue;
@@ -16,6 +16,7 @@
 #include "backend.h"
 #include "mock/recorder.h"
 #include <media/ros/ros_reader.h>
+#include <media/ros/ros_multi_file_reader.h>
 #include "types.h"
 #include "stream.h"
 #include "environment.h"
@@ -98,7 +99,8 @@ namespace librealsense
                      const char* filename,
                      const char* section,
                      rs2_recording_mode mode,
-                     std::string min_api_version)
+                     std::string min_api_version,
+                     bool virtual_clock)
         : _devices_changed_callback(nullptr, [](rs2_devices_changed_callback*){})
     {
         static bool version_logged=false;
@@ -117,7 +119,7 @@ namespace librealsense
             _backend = std::make_shared<platform::record_backend>(platform::create_backend(), filename, section, mode);
             break;
         case backend_type::playback:
-            _backend = std::make_shared<platform::playback_backend>(filename, section, min_api_version);
+            _backend = std::make_shared<platform::playback_backend>(filename, section, min_api_version, virtual_clock);
             break;
             // Strongly-typed enum. Default is redundant
         }
@@ -515,16 +517,42 @@ namespace librealsense
 
     std::shared_ptr<playback_device_info> context::add_device(const std::string& file)
     {
-        auto it = _playback_devices.find(file);
+        return add_device(file, { file });
+    }
+
+    std::shared_ptr<playback_device_info> context::add_device(const std::vector<std::string>& files)
+    {
+        if (files.empty())
+        {
+            throw librealsense::invalid_value_exception("No files to load");
+        }
+        //Patterns and lists of files are only expanded here, a single file given to add_device(file) is always played as is
+        std::vector<std::string> recording_files;
+        for (auto&& file : files)
+        {
+            auto listed = ros_multi_file_reader::list_files(file);
+            recording_files.insert(recording_files.end(), listed.begin(), listed.end());
+        }
+        return add_device(files.front(), recording_files);
+    }
+
+    std::shared_ptr<playback_device_info> context::add_device(const std::string& name, const std::vector<std::string>& files)
+    {
+        auto it = _playback_devices.find(name);
         if (it != _playback_devices.end() && it->second.lock())
         {
             //Already exists
-            throw librealsense::invalid_value_exception(to_string() << "File \"" << file << "\" already loaded to context");
-        }
-        auto playback_dev = std::make_shared<playback_device>(shared_from_this(), std::make_shared<ros_reader>(file, shared_from_this()));
+            throw librealsense::invalid_value_exception(to_string() << "File \"" << name << "\" already loaded to context");
+        }
+        std::shared_ptr<device_serializer::reader> reader;
+        if (files.size() == 1)
+            reader = std::make_shared<ros_reader>(files.front(), shared_from_this());
+        else
+            reader = std::make_shared<ros_multi_file_reader>(name, files, shared_from_this());
+        auto playback_dev = std::make_shared<playback_device>(shared_from_this(), reader);
         auto dinfo = std::make_shared<playback_device_info>(playback_dev);
         auto prev_playback_devices = _playback_devices;
-        _playback_devices[file] = dinfo;
+        _playback_devices[name] = dinfo;
         on_device_changed({}, {}, prev_playback_devices, _playback_devices);
         return std::move(dinfo);
     }
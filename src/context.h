@@ -110,7 +110,8 @@ namespace librealsense
             const char* filename = nullptr,
             const char* section = nullptr,
             rs2_recording_mode mode = RS2_RECORDING_MODE_COUNT,
-            std::string min_api_version = "0.0.0");
+            std::string min_api_version = "0.0.0",
+            bool virtual_clock = false);
 
         void stop(){ if (!_devices_changed_callbacks.size()) _device_watcher->stop();}
         ~context();
@@ -125,6 +126,7 @@ namespace librealsense
             const std::map<std::string, std::weak_ptr<device_info>>& playback_devices, int mask) const;
 
         std::shared_ptr<playback_device_info> add_device(const std::string& file);
+        std::shared_ptr<playback_device_info> add_device(const std::vector<std::string>& files);
         void remove_device(const std::string& file);
 
         void add_software_device(std::shared_ptr<device_info> software_device);
@@ -134,6 +136,7 @@ namespace librealsense
 #endif
 
     private:
+        std::shared_ptr<playback_device_info> add_device(const std::string& name, const std::vector<std::string>& files);
         void on_device_changed(platform::backend_device_group old,
                                platform::backend_device_group curr,
                                const std::map<std::string, std::weak_ptr<device_info>>& old_playback_devices,
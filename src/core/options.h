@@ -111,7 +111,7 @@ namespace librealsense
         }
 
     protected:
-        std::map<rs2_option, std::shared_ptr<option>> _options;
+        enum_map<rs2_option, std::shared_ptr<option>, RS2_OPTION_COUNT> _options;
         std::function<void(const options_interface&)> _recording_function = [](const options_interface&) {};
     };
 }
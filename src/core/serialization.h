@@ -286,6 +286,10 @@ namespace librealsense
             {
                 return m_device_snapshots;
             }
+            snapshot_collection& get_device_extensions_snapshots()
+            {
+                return m_device_snapshots;
+            }
             std::map<stream_identifier, std::pair<uint32_t, rs2_extrinsics>> get_extrinsics_map() const
             {
                 return m_extrinsics_map;
@@ -346,6 +350,7 @@ namespace librealsense
             virtual void disable_stream(const std::vector<device_serializer::stream_identifier>& stream_ids) = 0;
             virtual const std::string& get_file_name() const = 0;
             virtual std::vector<std::shared_ptr<serialized_data>> fetch_last_frames(const nanoseconds& seek_time) = 0;
+            virtual void set_blocking(bool blocking) = 0;
         };
     }
 }
@@ -28,6 +28,8 @@ public:
     virtual int close() = 0;
     virtual int getOption(const std::string& t_sensorName, rs2_option t_option, float& t_value) = 0;
     virtual int setOption(const std::string& t_sensorName, rs2_option t_option, float t_value) = 0;
+    // asks the server to stop sending the stream over RTP because it is read from shared memory
+    virtual int setSharedMemory(long long int t_streamKey, bool t_isEnabled) = 0;
     virtual DeviceData getDeviceData() = 0;
     virtual std::vector<IpDeviceControlData> getControls() = 0;
 };
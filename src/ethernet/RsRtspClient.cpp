@@ -6,6 +6,7 @@
 #include "RsRtspClient.h"
 #include <RsUsageEnvironment.h>
 #include <ipDeviceCommon/RsCommon.h>
+#include <ipDeviceCommon/RsSharedMemory.h>
 
 #include <algorithm>
 #include <iostream>
@@ -218,6 +219,20 @@ int RsRTSPClient::close()
     {
         std::lock_guard<std::mutex> lk(m_taskSchedulerMutex);
     }
+    // the sinks are destroyed with the session, after the callbacks of the streams may be gone
+    if (m_scs.m_session != NULL)
+    {
+        RsMediaSubsessionIterator iter(*m_scs.m_session);
+        RsMediaSubsession *subsession = iter.next();
+        while (subsession != NULL)
+        {
+            if (subsession->sink != NULL)
+            {
+                ((RsSink *)(subsession->sink))->detachCallback();
+            }
+            subsession = iter.next();
+        }
+    }
     this->envir() << "Closing the stream.\n";
     UsageEnvironment *env = m_env;
     TaskScheduler *scheduler = m_scheduler;
@@ -258,6 +273,30 @@ int RsRTSPClient::setOption(const std::string &t_sensorName, rs2_option t_option
     return m_lastReturnValue.exit_code;
 }
 
+int RsRTSPClient::setSharedMemory(long long int t_streamKey, bool t_isEnabled)
+{
+    // the parameter is sent in the context of the session, the server moves only the stream of this session
+    std::string parameter = std::string(SHARED_MEMORY_PARAMETER) + "_" + std::to_string(t_streamKey);
+    RTSPClient::sendSetParameterCommand(*this->m_scs.m_session, this->continueAfterSETCOMMAND, parameter.c_str(), t_isEnabled ? "1" : "0");
+
+    std::unique_lock<std::mutex> lck(m_commandMtx);
+    m_cv.wait_for(lck, std::chrono::seconds(RTSP_CLIENT_COMMANDS_TIMEOUT_SEC), [this] { return m_commandDone; });
+    // for the next command
+    if (!m_commandDone)
+    {
+        RsRtspReturnValue err = {RsRtspReturnCode::ERROR_TIME_OUT, "client time out"};
+        throw std::runtime_error(format_error_msg(__FUNCTION__, err));
+    }
+    m_commandDone = false;
+
+    if (m_lastReturnValue.exit_code != RsRtspReturnCode::OK)
+    {
+        throw std::runtime_error(format_error_msg(__FUNCTION__, m_lastReturnValue));
+    }
+
+    return m_lastReturnValue.exit_code;
+}
+
 void RsRTSPClient::setGetParamResponse(float t_res)
 {
     m_getParamRes = t_res;
@@ -459,6 +498,14 @@ void RsRTSPClient::continueAfterDESCRIBE(RTSPClient *rtspClient, int resultCode,
             videoStream.intrinsics.fx = subsession->attrVal_int("fx");
             videoStream.intrinsics.fy = subsession->attrVal_int("fy");
             CompressionFactory::getIsEnabled() = subsession->attrVal_bool("compression");
+            // servers that do not send their depth method use lz4, a method this client does not know is decoded as lz4 as well
+            const char *strDepthZipMethodVal = subsession->attrVal_str("depth_zip_method");
+            ZipMethod depthZipMethod = ZipMethod::lz;
+            if (strcmp(strDepthZipMethodVal, "") && !CompressionFactory::getDepthZipMethod(strDepthZipMethodVal, depthZipMethod))
+            {
+                env << "Unknown depth compression method \"" << strDepthZipMethodVal << "\", using lz4\n";
+            }
+            CompressionFactory::getDepthZipMethod() = depthZipMethod;
             videoStream.intrinsics.model = (rs2_distortion)subsession->attrVal_int("model");
 
             for (size_t i = 0; i < 5; i++)
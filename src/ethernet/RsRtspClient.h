@@ -43,6 +43,7 @@ public:
     virtual int close();
     virtual int getOption(const std::string& t_sensorName, rs2_option t_option, float& t_value);
     virtual int setOption(const std::string& t_sensorName, rs2_option t_option, float t_value);
+    virtual int setSharedMemory(long long int t_streamKey, bool t_isEnabled);
     void setGetParamResponse(float t_res);
     virtual DeviceData getDeviceData()
     {
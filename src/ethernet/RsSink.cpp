@@ -2,14 +2,18 @@
 // Copyright(c) 2020 Intel Corporation. All Rights Reserved.
 
 #include "RsSink.h"
+#include <compression/AdaptiveCompression.h>
 #include <ipDeviceCommon/Statistic.h>
 
 #include "stdio.h"
+#include <algorithm>
+#include <chrono>
 #include <string>
 
 #include <NetdevLog.h>
 
 #define WRITE_FRAMES_TO_FILE 0
+#define SINK_STATISTIC_INTERVAL_MS 100 // the reception statistic is collected from every RTP source, so it is not reported on every frame
 
 RsSink* RsSink::createNew(UsageEnvironment& t_env, MediaSubsession& t_subsession, rs2_video_stream t_stream, MemoryPool* t_memPool, char const* t_streamId)
 {
@@ -23,9 +27,12 @@ RsSink::RsSink(UsageEnvironment& t_env, MediaSubsession& t_subsession, rs2_video
 {
     m_stream = t_stream;
     m_streamId = strDup(t_streamId);
-    m_bufferSize = t_stream.width * t_stream.height * t_stream.bpp + sizeof(RsFrameHeader);
+    // an adaptive stream sends its uncompressed frames with the adaptive header in front
+    m_bufferSize = t_stream.width * t_stream.height * t_stream.bpp + sizeof(RsFrameHeader) + sizeof(AdaptiveCompressionHeader);
+    m_decompressedBufferSize = t_stream.width * t_stream.height * t_stream.bpp + sizeof(RsFrameHeader);
     m_receiveBuffer = nullptr;
     m_to = nullptr;
+    m_rtpCallback = NULL;
     std::string urlStr = m_streamId;
     m_afterGettingFunctions.push_back(afterGettingFrameUid0);
     m_afterGettingFunctions.push_back(afterGettingFrameUid1);
@@ -59,10 +66,18 @@ RsSink::RsSink(UsageEnvironment& t_env, MediaSubsession& t_subsession, rs2_video
 
 RsSink::~RsSink()
 {
+    RsSinkStatistic statistic = getStatistic();
+    MemoryPoolStatistic poolStatistic = m_memPool->getStatistic();
+    INF << "stream " << m_stream.uid << " received " << statistic.frames << " frames, " << statistic.corruptedFrames << " corrupted, lost " << statistic.packetsLost << " of "
+        << statistic.packetsExpected << " packets, latency avg " << (statistic.latencyFrames ? statistic.totalLatencyMs / statistic.latencyFrames : 0) << "ms max "
+        << statistic.maxLatencyMs << "ms, decompression avg " << (statistic.frames ? statistic.totalDecompressTimeMs / statistic.frames : 0) << "ms, frame buffers allocated "
+        << poolStatistic.allocatedBuffers << " reused " << poolStatistic.reusedBuffers;
     if(m_receiveBuffer != nullptr)
     {
         m_memPool->returnMem(m_receiveBuffer);
     }
+    m_memPool->trim(m_bufferSize);
+    m_memPool->trim(m_decompressedBufferSize);
     delete[] m_streamId;
     //fclose(fp);
 }
@@ -101,28 +116,33 @@ void RsSink::afterGettingFrameUid3(void* t_clientData, unsigned t_frameSize, uns
 void RsSink::afterGettingFrame(unsigned t_frameSize, unsigned t_numTruncatedBytes, struct timeval t_presentationTime, unsigned /*t_durationInMicroseconds*/)
 {
     RsNetworkHeader* header = (RsNetworkHeader*)m_receiveBuffer;
-    if(header->data.frameSize == t_frameSize - sizeof(RsNetworkHeader))
+    if(t_numTruncatedBytes == 0 && header->data.frameSize == t_frameSize - sizeof(RsNetworkHeader))
     {
+        m_statistic.frames++;
+        recordLatency(t_presentationTime);
         if(this->m_rtpCallback != NULL)
         {
             if(CompressionFactory::isCompressionSupported(m_stream.fmt, m_stream.type) && m_iCompress != nullptr)
             {
-                m_to = m_memPool->getNextMem();
-                if(m_to == nullptr)
-                {
-                    return;
-                }
+                m_to = m_memPool->getNextMem(m_decompressedBufferSize);
+                std::chrono::steady_clock::time_point decompressStart = std::chrono::steady_clock::now();
                 int decompressedSize = m_iCompress->decompressBuffer(m_receiveBuffer + sizeof(RsFrameHeader), header->data.frameSize - sizeof(RsMetadataHeader), m_to + sizeof(RsFrameHeader));
+                m_statistic.totalDecompressTimeMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - decompressStart).count();
                 if(decompressedSize != -1)
                 {
                     // copy metadata
                     memcpy(m_to + sizeof(RsNetworkHeader), m_receiveBuffer + sizeof(RsNetworkHeader), sizeof(RsMetadataHeader));
                     this->m_rtpCallback->on_frame((u_int8_t*)m_to + sizeof(RsNetworkHeader), decompressedSize + sizeof(RsMetadataHeader), t_presentationTime);
                 }
+                else
+                {
+                    m_memPool->returnMem(m_to);
+                }
                 m_memPool->returnMem(m_receiveBuffer);
             }
             else
             {
+                // the receive buffer itself is handed on, the software sensor returns it to the pool when its frame is released
                 this->m_rtpCallback->on_frame(m_receiveBuffer + sizeof(RsNetworkHeader), header->data.frameSize, t_presentationTime);
             }
         }
@@ -135,10 +155,17 @@ void RsSink::afterGettingFrame(unsigned t_frameSize, unsigned t_numTruncatedByte
     }
     else
     {
-                envir() << m_streamId << ":corrupted frame!!!: data size is " << header->data.frameSize << " frame size is " << t_frameSize << "\n";
-                m_memPool->returnMem(m_receiveBuffer);
+        m_statistic.corruptedFrames++;
+        envir() << m_streamId << ":corrupted frame!!!: data size is " << header->data.frameSize << " frame size is " << t_frameSize << "\n";
+        m_memPool->returnMem(m_receiveBuffer);
     }
     m_receiveBuffer = nullptr;
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if(this->m_rtpCallback != NULL && now - m_lastStatisticTime >= std::chrono::milliseconds(SINK_STATISTIC_INTERVAL_MS))
+    {
+        this->m_rtpCallback->on_statistic(getStatistic());
+        m_lastStatisticTime = now;
+    }
 
     // Then continue, to request the next frame of data
     continuePlaying();
@@ -150,11 +177,7 @@ Boolean RsSink::continuePlaying()
         return False; // sanity check (should not happen)
 
     // Request the next frame of data from our input source.  "afterGettingFrame()" will get called later, when it arrives:
-    m_receiveBuffer = m_memPool->getNextMem();
-    if(m_receiveBuffer == nullptr)
-    {
-        return false;
-    }
+    m_receiveBuffer = m_memPool->getNextMem(m_bufferSize);
 
     if(m_stream.uid >= 0 && m_stream.uid < m_afterGettingFunctions.size())
     {
@@ -172,3 +195,56 @@ void RsSink::setCallback(rtp_callback* t_callback)
 {
     this->m_rtpCallback = t_callback;
 }
+
+void RsSink::detachCallback()
+{
+    // the frames received since the last report are counted too
+    if(this->m_rtpCallback != NULL)
+    {
+        this->m_rtpCallback->on_statistic(getStatistic());
+        this->m_rtpCallback = NULL;
+    }
+}
+
+void RsSink::recordLatency(struct timeval t_presentationTime)
+{
+    // before RTCP synchronization the presentation time is only a local guess
+    RTPSource* rtpSource = m_subsession.rtpSource();
+    if(rtpSource == NULL || !rtpSource->hasBeenSynchronizedUsingRTCP())
+    {
+        return;
+    }
+    // the presentation time is a wall clock time
+    double nowMs = std::chrono::duration<double, std::milli>(std::chrono::system_clock::now().time_since_epoch()).count();
+    double latencyMs = nowMs - (t_presentationTime.tv_sec * 1000.0 + t_presentationTime.tv_usec / 1000.0);
+    m_statistic.latencyFrames++;
+    m_statistic.totalLatencyMs += latencyMs;
+    m_statistic.maxLatencyMs = std::max(m_statistic.maxLatencyMs, latencyMs);
+}
+
+RsSinkStatistic RsSink::getStatistic()
+{
+    RsSinkStatistic statistic = m_statistic;
+    RTPSource* rtpSource = m_subsession.rtpSource();
+    if(rtpSource != NULL)
+    {
+        // the loss is counted by the RTP sequence numbers of the packets
+        RTPReceptionStatsDB::Iterator iterator(rtpSource->receptionStatsDB());
+        RTPReceptionStats* receptionStats;
+        while((receptionStats = iterator.next(True)) != NULL)
+        {
+            statistic.packetsExpected += receptionStats->totNumPacketsExpected();
+            statistic.packetsLost += receptionStats->totNumPacketsExpected() - std::min(receptionStats->totNumPacketsExpected(), receptionStats->totNumPacketsReceived());
+        }
+    }
+    std::shared_ptr<AdaptiveCompression> adaptive = std::dynamic_pointer_cast<AdaptiveCompression>(m_iCompress);
+    if(adaptive != nullptr)
+    {
+        AdaptiveCompressionStatistic codecStatistic = adaptive->getStatistic();
+        statistic.compressionSwitches = codecStatistic.switchCount;
+        statistic.avgEncodeTimeMs = codecStatistic.avgEncodeTimeMs;
+        statistic.avgCompressionRatio = codecStatistic.avgCompressionRatio;
+        statistic.sendBacklog = codecStatistic.sendBacklog;
+    }
+    return statistic;
+}
@@ -13,6 +13,8 @@
 
 #include <librealsense2/hpp/rs_internal.hpp>
 
+#include <chrono>
+
 class RsSink : public MediaSink
 {
 public:
@@ -23,6 +25,9 @@ public:
                              char const* t_streamId = NULL); // identifies the stream itself (optional)
 
     void setCallback(rtp_callback* t_callback);
+    // reports the last statistic and stops calling the callback, called once the event loop stopped and before the callback is destroyed
+    void detachCallback();
+    RsSinkStatistic getStatistic();
 
 private:
     RsSink(UsageEnvironment& t_env, MediaSubsession& t_subsession, rs2_video_stream t_stream, MemoryPool* t_mempool, char const* t_streamId);
@@ -34,6 +39,7 @@ private:
     static void afterGettingFrameUid2(void* t_clientData, unsigned t_frameSize, unsigned t_numTruncatedBytes, struct timeval t_presentationTime, unsigned t_durationInMicroseconds);
     static void afterGettingFrameUid3(void* t_clientData, unsigned t_frameSize, unsigned t_numTruncatedBytes, struct timeval t_presentationTime, unsigned t_durationInMicroseconds);
     void afterGettingFrame(unsigned t_frameSize, unsigned t_numTruncatedBytes, struct timeval t_presentationTime, unsigned t_durationInMicroseconds);
+    void recordLatency(struct timeval t_presentationTime);
 
 private:
     // redefined virtual functions:
@@ -43,6 +49,7 @@ private:
     unsigned char* m_receiveBuffer;
     unsigned char* m_to;
     int m_bufferSize;
+    int m_decompressedBufferSize;
     MediaSubsession& m_subsession;
     char* m_streamId;
     FILE* m_fp;
@@ -52,6 +59,8 @@ private:
     std::shared_ptr<ICompression> m_iCompress;
     MemoryPool* m_memPool;
     std::vector<FramedSource::afterGettingFunc*> m_afterGettingFunctions;
+    RsSinkStatistic m_statistic;
+    std::chrono::steady_clock::time_point m_lastStatisticTime;
 };
 
 #endif // RS_SINK_H
@@ -5,10 +5,12 @@
 #include <ipDeviceCommon/Statistic.h>
 
 #include "api.h"
+#include "context.h"
 #include <librealsense2-net/rs_net.h>
 
 #include <chrono>
 #include <list>
+#include <mutex>
 #include <thread>
 #include <iostream>
 #include <string>
@@ -19,6 +21,10 @@ extern std::map<std::pair<int, int>, rs2_extrinsics> minimal_extrinsics_map;
 
 std::string sensors_str[] = {STEREO_SENSOR_NAME, RGB_SENSOR_NAME};
 
+// the ip device behind each net device, the software device does not know about it
+std::mutex net_devices_mutex;
+std::map<const librealsense::device_interface*, ip_device*> net_devices;
+
 //WA for stop
 void ip_device::recover_rtsp_client(int sensor_index)
 {
@@ -59,7 +65,7 @@ void ip_device::stop_sensor_streams(int sensor_index)
     for(long long int key : remote_sensors[sensor_index]->active_streams_keys)
     {
         DBG << "Stopping stream [uid:key] " << streams_collection[key].get()->m_rs_stream.uid << ":" << key << "]";
-        streams_collection[key].get()->is_enabled = false;
+        streams_collection[key].get()->disable();
         if(inject_frames_thread[key].joinable())
             inject_frames_thread[key].join();
     }
@@ -298,6 +304,32 @@ void ip_device::get_option_value(int sensor_index, rs2_option opt, float& val)
     }
 }
 
+rs2_net_stream_statistics ip_device::get_stream_statistics(long long int stream_key)
+{
+    auto stream = streams_collection.find(stream_key);
+    if(stream == streams_collection.end())
+    {
+        throw std::runtime_error("[get_stream_statistics] stream key: " + std::to_string(stream_key) + " is not a stream of the device");
+    }
+    rtp_stream_statistic statistic = stream->second.get()->get_statistic();
+    rs2_net_stream_statistics statistics;
+    statistics.received_frames = statistic.sink.frames;
+    statistics.corrupted_frames = statistic.sink.corruptedFrames;
+    statistics.packets_expected = statistic.sink.packetsExpected;
+    statistics.packets_lost = statistic.sink.packetsLost;
+    statistics.injected_frames = statistic.injected_frames;
+    statistics.dropped_frames = statistic.dropped_frames;
+    statistics.avg_latency_ms = statistic.sink.latencyFrames ? statistic.sink.totalLatencyMs / statistic.sink.latencyFrames : 0;
+    statistics.max_latency_ms = statistic.sink.maxLatencyMs;
+    statistics.avg_decompress_time_ms = statistic.sink.frames ? statistic.sink.totalDecompressTimeMs / statistic.sink.frames : 0;
+    statistics.avg_injection_latency_ms = statistic.injected_frames ? statistic.total_latency_ms / statistic.injected_frames : 0;
+    statistics.compression_switches = statistic.sink.compressionSwitches;
+    statistics.avg_encode_time_ms = statistic.sink.avgEncodeTimeMs;
+    statistics.avg_compression_ratio = statistic.sink.avgCompressionRatio;
+    statistics.send_backlog = statistic.sink.sendBacklog;
+    return statistics;
+}
+
 rs2_video_stream convert_stream_object(rs2::video_stream_profile sp)
 {
     rs2_video_stream retVal;
@@ -337,16 +369,58 @@ void ip_device::update_sensor_state(int sensor_index, std::vector<rs2::stream_pr
             throw std::runtime_error("[update_sensor_state] stream key: " + std::to_string(requested_stream_key) + " is not found. closing device.");
         }
 
+        streams_collection[requested_stream_key].get()->reset_statistic();
         rtp_callbacks[requested_stream_key] = new rs_rtp_callback(streams_collection[requested_stream_key]);
         remote_sensors[sensor_index]->rtsp_client->addStream(streams_collection[requested_stream_key].get()->m_rs_stream, rtp_callbacks[requested_stream_key]);
-        inject_frames_thread[requested_stream_key] = std::thread(&ip_device::inject_frames_loop, this, streams_collection[requested_stream_key]);
+        streams_collection[requested_stream_key].get()->use_shared_memory = false;
+        streams_collection[requested_stream_key].get()->is_enabled = true;
         remote_sensors[sensor_index]->active_streams_keys.push_front(requested_stream_key);
     }
 
     remote_sensors[sensor_index]->rtsp_client->start();
+
+    // the streams are moved to shared memory only once the session plays, the RTP frames cover the switch
+    for(long long int key : remote_sensors[sensor_index]->active_streams_keys)
+    {
+        std::shared_ptr<RsSharedMemoryRing> ring = open_shared_memory(sensor_index, key);
+        if(ring)
+        {
+            inject_frames_thread[key] = std::thread(&ip_device::inject_shared_memory_loop, this, streams_collection[key], ring);
+        }
+        else
+        {
+            inject_frames_thread[key] = std::thread(&ip_device::inject_frames_loop, this, streams_collection[key]);
+        }
+    }
     INF << "Stream started for sensor " << sensor_index;
 }
 
+std::shared_ptr<RsSharedMemoryRing> ip_device::open_shared_memory(int sensor_index, long long int stream_key)
+{
+    // the rings of the server are visible only on its own host
+    if(ip_address.compare(0, 4, "127.") != 0 && ip_address.compare(0, 11, "::ffff:127.") != 0 && ip_address != "::1" && ip_address != "localhost")
+    {
+        return nullptr;
+    }
+    std::shared_ptr<RsSharedMemoryRing> ring = RsSharedMemoryRing::open(RsSharedMemoryRing::getName(ip_port, stream_key));
+    if(!ring)
+    {
+        return nullptr;
+    }
+    try
+    {
+        remote_sensors[sensor_index]->rtsp_client->setSharedMemory(stream_key, true);
+    }
+    catch(const std::exception& ex)
+    {
+        WRN << "Stream " << stream_key << " stays on RTP: " << ex.what();
+        return nullptr;
+    }
+    streams_collection[stream_key].get()->use_shared_memory = true;
+    INF << "Stream " << stream_key << " is read from shared memory";
+    return ring;
+}
+
 int stream_type_to_sensor_id(rs2_stream type)
 {
     if(type == RS2_STREAM_INFRARED || type == RS2_STREAM_DEPTH)
@@ -358,37 +432,79 @@ void ip_device::inject_frames_loop(std::shared_ptr<rs_rtp_stream> rtp_stream)
 {
     try
     {
-        rtp_stream.get()->is_enabled = true;
-
         rtp_stream.get()->frame_data_buff.frame_number = 0;
         int uid = rtp_stream.get()->m_rs_stream.uid;
-        rs2_stream type = rtp_stream.get()->m_rs_stream.type;
-        int sensor_id = stream_type_to_sensor_id(type);
 
         while(rtp_stream.get()->is_enabled == true)
         {
-            if(rtp_stream.get()->queue_size() != 0)
+            // sleep until a frame arrives instead of polling the queue
+            Raw_Frame frame;
+            if(!rtp_stream.get()->wait_frame(frame, std::chrono::milliseconds(RTP_QUEUE_WAIT_TIMEOUT_MS)))
             {
-                Raw_Frame* frame = rtp_stream.get()->extract_frame();
-                rtp_stream.get()->frame_data_buff.pixels = frame->m_buffer;
+                continue;
+            }
+
+            inject_frame(rtp_stream, frame.m_buffer, *frame.m_metadata);
+
+            // the pixels are now owned by the software sensor and returned to the pool by the frame deleter
+            rtp_stream.get()->record_injection(frame);
+        }
 
-                rtp_stream.get()->frame_data_buff.timestamp = frame->m_metadata->data.timestamp;
+        rtp_stream_statistic statistic = rtp_stream.get()->get_statistic();
+        INF << "Stream " << uid << " injected " << statistic.injected_frames << " frames, dropped " << statistic.dropped_frames
+            << ", latency from arrival avg " << (statistic.injected_frames ? statistic.total_latency_ms / statistic.injected_frames : 0)
+            << "ms max " << statistic.max_latency_ms << "ms";
+        rtp_stream.get()->reset_queue();
+        DBG << "Polling data at stream " << rtp_stream.get()->m_rs_stream.uid << " completed";
+    }
+    catch(const std::exception& ex)
+    {
+        ERR << ex.what();
+    }
+}
 
-                rtp_stream.get()->frame_data_buff.frame_number++;
-                rtp_stream.get()->frame_data_buff.domain = frame->m_metadata->data.timestampDomain;
+void ip_device::inject_shared_memory_loop(std::shared_ptr<rs_rtp_stream> rtp_stream, std::shared_ptr<RsSharedMemoryRing> ring)
+{
+    try
+    {
+        rtp_stream.get()->frame_data_buff.frame_number = 0;
+        int uid = rtp_stream.get()->m_rs_stream.uid;
+        uint64_t last_sequence = 0;
+        unsigned long long skipped_frames = 0;
 
-                remote_sensors[sensor_id]->sw_sensor->set_metadata(RS2_FRAME_METADATA_FRAME_TIMESTAMP, rtp_stream.get()->frame_data_buff.timestamp);
-                remote_sensors[sensor_id]->sw_sensor->set_metadata(RS2_FRAME_METADATA_ACTUAL_FPS, frame->m_metadata->data.actualFps);
-                remote_sensors[sensor_id]->sw_sensor->set_metadata(RS2_FRAME_METADATA_FRAME_COUNTER, rtp_stream.get()->frame_data_buff.frame_number);
-                remote_sensors[sensor_id]->sw_sensor->set_metadata(RS2_FRAME_METADATA_FRAME_EMITTER_MODE, 1);
+        // the slots are handed to the software sensor as is and released by its frame deleter
+        void (*rtp_deleter)(void*) = rtp_stream.get()->frame_data_buff.deleter;
+        rtp_stream.get()->frame_data_buff.deleter = RsSharedMemoryRing::releaseFrame;
+        while(rtp_stream.get()->is_enabled == true)
+        {
+            if(!ring->waitFrame(last_sequence, std::chrono::milliseconds(RTP_QUEUE_WAIT_TIMEOUT_MS)))
+            {
+                if(!ring->isAlive())
+                {
+                    WRN << "Shared memory of stream " << uid << " was closed by the server";
+                    break;
+                }
+                continue;
+            }
 
-                remote_sensors[sensor_id]->sw_sensor->set_metadata(RS2_FRAME_METADATA_TIME_OF_ARRIVAL, std::chrono::duration<double, std::milli>(std::chrono::system_clock::now().time_since_epoch()).count());
-                remote_sensors[sensor_id]->sw_sensor->on_video_frame(rtp_stream.get()->frame_data_buff);
+            uint64_t sequence = 0;
+            RsSharedMemorySlot* slot = ring->acquireLatest(sequence);
+            if(slot == nullptr)
+            {
+                continue;
+            }
+            if(last_sequence != 0 && sequence > last_sequence + 1)
+            {
+                skipped_frames += sequence - last_sequence - 1;
             }
+            last_sequence = sequence;
+
+            inject_frame(rtp_stream, RsSharedMemoryRing::getFrameData(slot), slot->metadata);
         }
+        rtp_stream.get()->frame_data_buff.deleter = rtp_deleter;
 
+        INF << "Stream " << uid << " injected " << rtp_stream.get()->frame_data_buff.frame_number << " frames from shared memory, skipped " << skipped_frames;
         rtp_stream.get()->reset_queue();
-        DBG << "Polling data at stream " << rtp_stream.get()->m_rs_stream.uid << " completed";
     }
     catch(const std::exception& ex)
     {
@@ -396,6 +512,27 @@ void ip_device::inject_frames_loop(std::shared_ptr<rs_rtp_stream> rtp_stream)
     }
 }
 
+void ip_device::inject_frame(std::shared_ptr<rs_rtp_stream> rtp_stream, void* pixels, const RsMetadataHeader& metadata)
+{
+    int sensor_id = stream_type_to_sensor_id(rtp_stream.get()->m_rs_stream.type);
+
+    rtp_stream.get()->frame_data_buff.pixels = pixels;
+
+    rtp_stream.get()->frame_data_buff.timestamp = metadata.data.timestamp;
+
+    rtp_stream.get()->frame_data_buff.frame_number++;
+    rtp_stream.get()->frame_data_buff.domain = metadata.data.timestampDomain;
+
+    // the metadata go with the frame, the streams of a sensor are injected from several threads
+    std::vector<rs2_software_metadata> frame_metadata = {
+        {RS2_FRAME_METADATA_FRAME_TIMESTAMP, (rs2_metadata_type)rtp_stream.get()->frame_data_buff.timestamp},
+        {RS2_FRAME_METADATA_ACTUAL_FPS, metadata.data.actualFps},
+        {RS2_FRAME_METADATA_FRAME_COUNTER, rtp_stream.get()->frame_data_buff.frame_number},
+        {RS2_FRAME_METADATA_FRAME_EMITTER_MODE, 1},
+        {RS2_FRAME_METADATA_TIME_OF_ARRIVAL, (rs2_metadata_type)std::chrono::duration<double, std::milli>(std::chrono::system_clock::now().time_since_epoch()).count()}};
+    remote_sensors[sensor_id]->sw_sensor->on_video_frame(rtp_stream.get()->frame_data_buff, frame_metadata);
+}
+
 rs2_device* rs2_create_net_device(int api_version, const char* address, rs2_error** error) BEGIN_API_CALL
 {
     verify_version_compatibility(api_version);
@@ -407,8 +544,19 @@ rs2_device* rs2_create_net_device(int api_version, const char* address, rs2_erro
     rs2::software_device sw_dev = rs2::software_device([](rs2_device*) {});
     // create IP instance
     ip_device* ip_dev = new ip_device(sw_dev, addr);
+    const librealsense::device_interface* device = sw_dev.get().get()->device.get();
+    {
+        std::lock_guard<std::mutex> lock(net_devices_mutex);
+        net_devices[device] = ip_dev;
+    }
     // set client destruction functioun
-    sw_dev.set_destruction_callback([ip_dev] { delete ip_dev; });
+    sw_dev.set_destruction_callback([ip_dev, device] {
+        {
+            std::lock_guard<std::mutex> lock(net_devices_mutex);
+            net_devices.erase(device);
+        }
+        delete ip_dev;
+    });
     // register device info to sw device
     DeviceData data = ip_dev->remote_sensors[0]->rtsp_client->getDeviceData();
     sw_dev.update_info(RS2_CAMERA_INFO_NAME, data.name + " IP Device");
@@ -419,3 +567,28 @@ rs2_device* rs2_create_net_device(int api_version, const char* address, rs2_erro
     return sw_dev.get().get();
 }
 HANDLE_EXCEPTIONS_AND_RETURN(nullptr, api_version, address)
+
+void rs2_get_net_stream_statistics(const rs2_device* device, const rs2_stream_profile* profile, rs2_net_stream_statistics* statistics, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_NOT_NULL(profile);
+    VALIDATE_NOT_NULL(statistics);
+
+    auto video_profile = VALIDATE_INTERFACE(profile->profile, librealsense::video_stream_profile_interface);
+    rs2_video_stream stream;
+    stream.type = video_profile->get_stream_type();
+    stream.fmt = video_profile->get_format();
+    stream.fps = video_profile->get_framerate();
+    stream.index = video_profile->get_stream_index();
+    stream.width = video_profile->get_width();
+    stream.height = video_profile->get_height();
+
+    std::lock_guard<std::mutex> lock(net_devices_mutex);
+    auto net_device = net_devices.find(device->device.get());
+    if(net_device == net_devices.end())
+    {
+        throw std::runtime_error("device is not a net device");
+    }
+    *statistics = net_device->second->get_stream_statistics(RsRTSPClient::getStreamProfileUniqueKey(stream));
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, device, profile, statistics)
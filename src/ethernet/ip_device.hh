@@ -6,9 +6,11 @@
 #include "RsRtspClient.h"
 #include "ip_sensor.hh"
 #include "rs_rtp_callback.hh"
+#include <ipDeviceCommon/RsSharedMemory.h>
 
 #include "option.h"
 #include "software-device.h"
+#include <librealsense2-net/rs_net.h>
 #include <librealsense2/hpp/rs_internal.hpp>
 #include <librealsense2/rs.hpp>
 
@@ -37,6 +39,9 @@ public:
 
     ip_sensor* remote_sensors[NUM_OF_SENSORS];
 
+    // the statistics of the last time the stream was started, throws when the device has no such stream
+    rs2_net_stream_statistics get_stream_statistics(long long int stream_key);
+
 private:
     bool is_device_alive;
 
@@ -60,6 +65,11 @@ private:
     void polling_state_loop();
 
     void inject_frames_loop(std::shared_ptr<rs_rtp_stream> rtp_stream);
+    void inject_shared_memory_loop(std::shared_ptr<rs_rtp_stream> rtp_stream, std::shared_ptr<RsSharedMemoryRing> ring);
+    void inject_frame(std::shared_ptr<rs_rtp_stream> rtp_stream, void* pixels, const RsMetadataHeader& metadata);
+
+    // the ring of the stream when rs-server runs on this host with shared memory enabled, otherwise nullptr
+    std::shared_ptr<RsSharedMemoryRing> open_shared_memory(int sensor_index, long long int stream_key);
 
     void stop_sensor_streams(int sensor_id);
 
@@ -7,7 +7,12 @@
 
 void rs_rtp_callback::on_frame(unsigned char* buffer, ssize_t size, struct timeval presentationTime)
 {
-    m_rtp_stream.get()->insert_frame(new Raw_Frame((char*)buffer, size, presentationTime));
+    m_rtp_stream.get()->insert_frame(Raw_Frame((char*)buffer, size, presentationTime));
+}
+
+void rs_rtp_callback::on_statistic(const RsSinkStatistic& statistic)
+{
+    m_rtp_stream.get()->set_sink_statistic(statistic);
 }
 
 rs_rtp_callback::~rs_rtp_callback() {}
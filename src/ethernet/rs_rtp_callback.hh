@@ -30,6 +30,8 @@ public:
 
     void on_frame(unsigned char* buffer, ssize_t size, struct timeval presentationTime);
 
+    void on_statistic(const RsSinkStatistic& statistic);
+
     int arrived_frames()
     {
         return arrive_frames_counter;
@@ -11,26 +11,44 @@
 
 #include <NetdevLog.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+
 const int RTP_QUEUE_MAX_SIZE = 30;
+const int RTP_QUEUE_WAIT_TIMEOUT_MS = 100;
 
+// queued by value, only the buffer is allocated per frame and it comes from the memory pool
 struct Raw_Frame
 {
+    Raw_Frame()
+        : m_metadata(nullptr)
+        , m_buffer(nullptr)
+        , m_size(0)
+        , m_timestamp({0, 0}){};
     Raw_Frame(char* buffer, int size, struct timeval timestamp)
         : m_metadata((RsMetadataHeader*)buffer)
         , m_buffer(buffer + sizeof(RsMetadataHeader))
         , m_size(size)
-        , m_timestamp(timestamp){};
-    Raw_Frame(const Raw_Frame&);
-    Raw_Frame& operator=(const Raw_Frame&);
-    ~Raw_Frame()
-    {
-        delete[] m_buffer;
-    };
+        , m_timestamp(timestamp)
+        , m_arrival_time(std::chrono::steady_clock::now()){};
+    // the buffer belongs to the memory pool, it is returned by whoever consumes the frame
 
     RsMetadataHeader* m_metadata;
     char* m_buffer;
     unsigned int m_size;
     struct timeval m_timestamp;
+    std::chrono::steady_clock::time_point m_arrival_time;
+};
+
+struct rtp_stream_statistic
+{
+    unsigned long long injected_frames = 0;
+    unsigned long long dropped_frames = 0;
+    double total_latency_ms = 0; // from the arrival of the frame to the end of on_video_frame
+    double max_latency_ms = 0;
+    RsSinkStatistic sink; // reception of the frames, reported by the RTP sink
 };
 
 class rs_rtp_stream
@@ -48,6 +66,8 @@ public:
         frame_data_buff.deleter = this->frame_deleter;
 
         m_rs_stream = rs_stream;
+        is_enabled = false;
+        use_shared_memory = false;
     }
 
     const rs2::stream_profile get_stream_profile()
@@ -60,16 +80,36 @@ public:
         return m_rs_stream.type;
     }
 
-    void insert_frame(Raw_Frame* new_raw_frame)
+    void insert_frame(const Raw_Frame& new_raw_frame)
     {
-        if(queue_size() > RTP_QUEUE_MAX_SIZE)
+        if(use_shared_memory)
+        {
+            // the frames are read from shared memory, RTP frames that were already on the way are not needed
+            release_frame(new_raw_frame);
+            return;
+        }
+        bool is_queued = false;
+        {
+            std::lock_guard<std::mutex> lock(this->stream_lock);
+            if(frames_queue.size() <= (size_t)RTP_QUEUE_MAX_SIZE)
+            {
+                frames_queue.push(new_raw_frame);
+                is_queued = true;
+            }
+            else
+            {
+                statistic.dropped_frames++;
+            }
+        }
+
+        if(!is_queued)
         {
             ERR << "Queue is full. Dropping frame for: " << this->m_rs_stream.uid;
+            release_frame(new_raw_frame);
         }
         else
         {
-            std::lock_guard<std::mutex> lock(this->stream_lock);
-            frames_queue.push(new_raw_frame);
+            queue_cv.notify_one();
         }
     }
 
@@ -77,20 +117,63 @@ public:
     // the key is generated by RsRTSPClient::getStreamProfileUniqueKey function
     std::map<long long int, rs2_extrinsics> extrinsics_map;
 
-    Raw_Frame* extract_frame()
+    // blocks until a frame arrives, the stream is disabled or the timeout expires, returns false when there is no frame
+    bool wait_frame(Raw_Frame& frame, std::chrono::milliseconds timeout)
     {
-        std::lock_guard<std::mutex> lock(this->stream_lock);
-        Raw_Frame* frame = frames_queue.front();
+        std::unique_lock<std::mutex> lock(this->stream_lock);
+        queue_cv.wait_for(lock, timeout, [this] { return !frames_queue.empty() || !is_enabled; });
+        if(frames_queue.empty())
+        {
+            return false;
+        }
+        frame = frames_queue.front();
         frames_queue.pop();
-        return frame;
+        return true;
+    }
+
+    void disable()
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->stream_lock);
+            is_enabled = false;
+        }
+        queue_cv.notify_all();
+    }
+
+    void record_injection(const Raw_Frame& frame)
+    {
+        double latency_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frame.m_arrival_time).count();
+        std::lock_guard<std::mutex> lock(this->stream_lock);
+        statistic.injected_frames++;
+        statistic.total_latency_ms += latency_ms;
+        statistic.max_latency_ms = std::max(statistic.max_latency_ms, latency_ms);
+    }
+
+    // the statistic of the last time the stream was started, kept after it stops
+    rtp_stream_statistic get_statistic()
+    {
+        std::lock_guard<std::mutex> lock(this->stream_lock);
+        return statistic;
+    }
+
+    void set_sink_statistic(const RsSinkStatistic& sink_statistic)
+    {
+        std::lock_guard<std::mutex> lock(this->stream_lock);
+        statistic.sink = sink_statistic;
+    }
+
+    void reset_statistic()
+    {
+        std::lock_guard<std::mutex> lock(this->stream_lock);
+        statistic = rtp_stream_statistic();
     }
 
     void reset_queue()
     {
+        std::lock_guard<std::mutex> lock(this->stream_lock);
         while(!frames_queue.empty())
         {
-            Raw_Frame* frame = frames_queue.front();
-            get_memory_pool().returnMem((unsigned char*)frame->m_buffer - sizeof(RsFrameHeader));
+            release_frame(frames_queue.front());
             frames_queue.pop();
         }
         INF << "Frames queue cleaned for " << m_rs_stream.uid;
@@ -104,11 +187,12 @@ public:
 
     static MemoryPool& get_memory_pool()
     {
-        static MemoryPool memory_pool_instance = MemoryPool();
+        static MemoryPool memory_pool_instance;
         return memory_pool_instance;
     }
 
-    bool is_enabled;
+    std::atomic<bool> is_enabled;
+    std::atomic<bool> use_shared_memory;
 
     rs2_video_stream m_rs_stream;
 
@@ -117,14 +201,23 @@ public:
 private:
     static void frame_deleter(void* p)
     {
-        get_memory_pool().returnMem((unsigned char*)p - sizeof(RsFrameHeader));
+        get_memory_pool().returnFrameMem(p);
+    }
+
+    static void release_frame(const Raw_Frame& frame)
+    {
+        frame_deleter(frame.m_buffer);
     }
 
     rs2::stream_profile m_stream_profile;
 
     std::mutex stream_lock;
 
-    std::queue<Raw_Frame*> frames_queue;
+    std::condition_variable queue_cv;
+
+    std::queue<Raw_Frame> frames_queue;
+
+    rtp_stream_statistic statistic;
 
     std::vector<uint8_t> pixels_buff;
 };
@@ -8,9 +8,28 @@
 #include <queue>
 #include <time.h>
 
+struct RsSinkStatistic
+{
+    unsigned long long frames = 0;
+    unsigned long long corruptedFrames = 0; // truncated or with a size that does not match their header
+    unsigned long long packetsExpected = 0;
+    unsigned long long packetsLost = 0;
+    // from the presentation time of the frame at the server to its reassembly, once RTCP synchronized the clocks
+    unsigned long long latencyFrames = 0;
+    double totalLatencyMs = 0;
+    double maxLatencyMs = 0;
+    double totalDecompressTimeMs = 0;
+    // the codec of an adaptive stream, as the server reported it in the frames
+    unsigned long long compressionSwitches = 0;
+    double avgEncodeTimeMs = 0;
+    double avgCompressionRatio = 0;
+    int sendBacklog = 0;
+};
+
 class rtp_callback
 {
 public:
     void virtual on_frame(unsigned char* buffer, ssize_t size, struct timeval presentationTime) = 0;
-
+    // the statistic of the stream so far, called by the sink periodically while it receives frames and once when it is closed
+    void virtual on_statistic(const RsSinkStatistic& statistic) = 0;
 };
@@ -12,6 +12,7 @@ namespace librealsense
     {
         std::atomic<uint32_t>* max_frame_queue_size;
         std::atomic<uint32_t> published_frames_count;
+        uint32_t unbounded_warning_count;
         small_heap<T, RS2_USER_QUEUE_SIZE> published_frames;
         std::shared_ptr<metadata_parser_map> _metadata_parsers = nullptr;
         callbacks_heap callback_inflight;
@@ -88,7 +89,8 @@ namespace librealsense
 
                 frame->keep();
 
-                if (recycle_frames)
+                // frames that reference external memory, e.g. the user buffers of software sensors, have no buffer to reuse
+                if (recycle_frames && !f->data.empty())
                 {
                     freelist.push_back(std::move(*f));
                 }
@@ -118,6 +120,12 @@ namespace librealsense
                 LOG_DEBUG("User didn't release frame resource.");
                 return nullptr;
             }
+            // an unbounded archive never drops a frame, so warn each time the frames held by the user double
+            if (!max_frames && published_frames_count >= unbounded_warning_count)
+            {
+                LOG_WARNING(published_frames_count << " frames were published and not released yet, the frames are not released as fast as they arrive");
+                unbounded_warning_count *= 2;
+            }
             auto new_frame = (max_frames ? published_frames.allocate() : new T());
 
             if (new_frame)
@@ -170,6 +178,7 @@ namespace librealsense
             _metadata_parsers(parsers)
         {
             published_frames_count = 0;
+            unbounded_warning_count = RS2_USER_QUEUE_SIZE;
         }
 
         callback_invocation_holder begin_callback() override
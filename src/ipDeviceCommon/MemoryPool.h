@@ -7,92 +7,141 @@
 
 #include <iostream>
 #include <mutex>
-#include <queue>
+#include <unordered_map>
+#include <vector>
 
 #include "NetdevLog.h"
 
-#define POOL_SIZE 100
+// free buffers kept for reuse per buffer size, a stream needs a few of them once the buffers of its frames in flight are allocated
+#define POOL_MAX_FREE_BUFFERS_PER_SIZE 8
+// bytes of all the free buffers kept for reuse, the buffers returned beyond it are released
+#define POOL_MAX_FREE_BYTES (64 * 1024 * 1024)
+// the size of a buffer and a marker are kept in front of it, the padding keeps the frame data 16 bytes aligned
+#define POOL_BLOCK_HEADER_SIZE 16
+#define POOL_BLOCK_MAGIC 0x4C4F4F50
 
+struct MemoryPoolStatistic
+{
+    unsigned long long allocatedBuffers = 0;
+    unsigned long long reusedBuffers = 0;
+    unsigned long long freeBytes = 0;
+};
+
+// Fixed size buffers for the frames of the streams. The buffers of each size are recycled, so every stream reuses
+// buffers of its own frame size once its first frames have been received, instead of allocating a buffer per frame.
+// A buffer can be returned from any thread, e.g. by the deleter of the software sensor frame that holds it.
+// The free buffers are capped per size and in total, and the buffers of a size are released when its stream stops.
 class MemoryPool
 {
 
 public:
-    MemoryPool()
+    MemoryPool() {}
+
+    // the buffers belong to a single pool, the frames return them to it
+    MemoryPool(const MemoryPool&) = delete;
+    MemoryPool& operator=(const MemoryPool&) = delete;
+    MemoryPool(MemoryPool&&) = delete;
+    MemoryPool& operator=(MemoryPool&&) = delete;
+
+    unsigned char* getNextMem(unsigned int t_size)
     {
-        // //alloc memory
-        // std::unique_lock<std::mutex> lk(m_mutex);
-        // for(int i = 0; i < POOL_SIZE; i++)
-        // {
-        //     unsigned char *mem = new unsigned char[sizeof(RsFrameHeader) + MAX_FRAME_SIZE]; //TODO:to use OutPacketBuffer::maxSize;
-        //     m_pool.push(mem);
-        // }
-        // lk.unlock();
+        {
+            std::unique_lock<std::mutex> lk(m_mutex);
+            auto freeBlocks = m_pool.find(t_size);
+            if(freeBlocks != m_pool.end() && !freeBlocks->second.empty())
+            {
+                unsigned char* mem = freeBlocks->second.back();
+                freeBlocks->second.pop_back();
+                m_statistic.reusedBuffers++;
+                m_statistic.freeBytes -= t_size;
+                return mem;
+            }
+            m_statistic.allocatedBuffers++;
+        }
+        unsigned char* block = new unsigned char[POOL_BLOCK_HEADER_SIZE + t_size];
+        ((unsigned int*)block)[0] = t_size;
+        ((unsigned int*)block)[1] = POOL_BLOCK_MAGIC;
+        return block + POOL_BLOCK_HEADER_SIZE;
     }
 
-    MemoryPool(const MemoryPool& obj)
+    void returnMem(unsigned char* t_mem)
     {
-        m_pool = obj.m_pool;
+        if(t_mem == nullptr)
+        {
+            ERR << "returnMem: invalid address";
+            return;
+        }
+        unsigned char* block = t_mem - POOL_BLOCK_HEADER_SIZE;
+        if(((unsigned int*)block)[1] != POOL_BLOCK_MAGIC)
+        {
+            // not the start of a pool buffer, e.g. the data of a frame given without the offset of its header
+            ERR << "returnMem: address is not a buffer of the pool";
+            return;
+        }
+        unsigned int size = ((unsigned int*)block)[0];
+        {
+            std::unique_lock<std::mutex> lk(m_mutex);
+            std::vector<unsigned char*>& freeBlocks = m_pool[size];
+            if(freeBlocks.size() < POOL_MAX_FREE_BUFFERS_PER_SIZE && m_statistic.freeBytes + size <= POOL_MAX_FREE_BYTES)
+            {
+                freeBlocks.push_back(t_mem);
+                m_statistic.freeBytes += size;
+                return;
+            }
+        }
+        ((unsigned int*)block)[1] = 0;
+        delete[] block;
     }
 
-    MemoryPool& operator=(const MemoryPool&& obj)
+    // returns the buffer of a received frame from the address of its data, which follows the frame header in the buffer
+    void returnFrameMem(void* t_frameData)
     {
-        m_pool = obj.m_pool;
-        return *this;
+        returnMem((unsigned char*)t_frameData - sizeof(RsFrameHeader));
     }
 
-    unsigned char* getNextMem()
+    // releases the free buffers of a size, called when the stream that uses them stops. the buffers of its frames that
+    // are still held are kept for reuse when they are returned, up to the limits of the pool
+    void trim(unsigned int t_size)
     {
-        // unsigned char* mem = nullptr;
-        // std::unique_lock<std::mutex> lk(m_mutex);
-        // if(!m_pool.empty())
-        // {
-        //     mem = m_pool.front();
-        //     m_pool.pop();
-        // }
-        // else
-        // {
-        //     ERR << "getNextMem: pool is empty";
-        // }
-        // lk.unlock();
-        // return mem;
-        return new unsigned char[sizeof(RsFrameHeader) + MAX_FRAME_SIZE]; 
+        std::vector<unsigned char*> freeBlocks;
+        {
+            std::unique_lock<std::mutex> lk(m_mutex);
+            auto sizeBlocks = m_pool.find(t_size);
+            if(sizeBlocks == m_pool.end())
+            {
+                return;
+            }
+            freeBlocks.swap(sizeBlocks->second);
+            m_pool.erase(sizeBlocks);
+            m_statistic.freeBytes -= (unsigned long long)t_size * freeBlocks.size();
+        }
+        for(unsigned char* mem : freeBlocks)
+        {
+            delete[](mem - POOL_BLOCK_HEADER_SIZE);
+        }
     }
 
-    void returnMem(unsigned char* t_mem)
+    MemoryPoolStatistic getStatistic()
     {
-        // if(t_mem != nullptr)
-        // {
-        //     std::unique_lock<std::mutex> lk(m_mutex);
-        //     m_pool.push(t_mem);
-        //     lk.unlock();
-        // }
-        // else
-        // {
-        //     ERR << "returnMem: invalid address";
-        // }
-        delete[] t_mem;
+        std::unique_lock<std::mutex> lk(m_mutex);
+        return m_statistic;
     }
 
     ~MemoryPool()
     {
-        // std::unique_lock<std::mutex> lk(m_mutex);
-        // while(!m_pool.empty())
-        // {
-        //     unsigned char* mem = m_pool.front();
-        //     m_pool.pop();
-        //     if(mem != nullptr)
-        //     {
-        //         delete mem;
-        //     }
-        //     else
-        //     {
-        //         ERR << "~memory_pool: invalid address";
-        //     }
-        // }
-        // lk.unlock();
+        std::unique_lock<std::mutex> lk(m_mutex);
+        for(auto& freeBlocks : m_pool)
+        {
+            for(unsigned char* mem : freeBlocks.second)
+            {
+                delete[](mem - POOL_BLOCK_HEADER_SIZE);
+            }
+        }
+        m_pool.clear();
     }
 
 private:
-    std::queue<unsigned char*> m_pool;
+    std::unordered_map<unsigned int, std::vector<unsigned char*>> m_pool;
     std::mutex m_mutex;
+    MemoryPoolStatistic m_statistic;
 };
@@ -0,0 +1,462 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "RsSharedMemory.h"
+#include "NetdevLog.h"
+
+#include <cerrno>
+#include <climits>
+#include <condition_variable>
+#include <cstring>
+#include <future>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#define SHARED_MEMORY_ALIGNMENT 64
+
+struct RsSharedMemoryMapping
+{
+    RsSharedMemoryMapping(void* t_address, size_t t_size)
+        : m_address(t_address)
+        , m_size(t_size)
+        , m_outstandingFrames(0)
+        , m_isClosed(false)
+        , m_readerIndex(-1)
+        , m_isLeaseReleased(false)
+    {}
+    ~RsSharedMemoryMapping()
+    {
+        // all the frames of the reader were released, its entry is free for the next reader
+        if(m_leaseThread.joinable())
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_leaseMutex);
+                m_isLeaseReleased = true;
+            }
+            m_leaseCondition.notify_one();
+            m_leaseThread.join();
+        }
+#ifdef __linux__
+        munmap(m_address, m_size);
+#endif
+    }
+
+    void* m_address;
+    size_t m_size;
+    int m_outstandingFrames;
+    bool m_isClosed;
+    int m_readerIndex; // entry of the reader in the ring, -1 for the writer
+
+    // a robust mutex is released by the thread that locked it, so the lock of the entry is held by a thread of the mapping
+    std::thread m_leaseThread;
+    std::mutex m_leaseMutex;
+    std::condition_variable m_leaseCondition;
+    bool m_isLeaseReleased;
+};
+
+namespace
+{
+    // the mappings of the readers by address, a mapping stays until the frames that point into it are released
+    std::mutex& getMappingsMutex()
+    {
+        static std::mutex mappingsMutex;
+        return mappingsMutex;
+    }
+
+    std::map<uintptr_t, std::shared_ptr<RsSharedMemoryMapping>>& getMappings()
+    {
+        static std::map<uintptr_t, std::shared_ptr<RsSharedMemoryMapping>> mappings;
+        return mappings;
+    }
+
+    size_t align(size_t t_size)
+    {
+        return (t_size + SHARED_MEMORY_ALIGNMENT - 1) / SHARED_MEMORY_ALIGNMENT * SHARED_MEMORY_ALIGNMENT;
+    }
+
+#ifdef __linux__
+    void futexWake(std::atomic<uint32_t>* t_word)
+    {
+        syscall(SYS_futex, (uint32_t*)t_word, FUTEX_WAKE, INT32_MAX, nullptr, nullptr, 0);
+    }
+
+    void futexWait(std::atomic<uint32_t>* t_word, uint32_t t_value, std::chrono::nanoseconds t_timeout)
+    {
+        struct timespec timeout;
+        timeout.tv_sec = std::chrono::duration_cast<std::chrono::seconds>(t_timeout).count();
+        timeout.tv_nsec = (t_timeout - std::chrono::seconds(timeout.tv_sec)).count();
+        syscall(SYS_futex, (uint32_t*)t_word, FUTEX_WAIT, t_value, &timeout, nullptr, 0);
+    }
+#endif
+} // namespace
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2, "the shared memory ring needs lock free atomics");
+
+RsSharedMemoryRing::RsSharedMemoryRing(const std::string& t_name, std::shared_ptr<RsSharedMemoryMapping> t_mapping, bool t_isWriter)
+    : m_name(t_name)
+    , m_mapping(t_mapping)
+    , m_header((RsSharedMemoryHeader*)t_mapping->m_address)
+    , m_isWriter(t_isWriter)
+    , m_readerIndex(-1)
+    , m_nextSlot(0)
+    , m_droppedFrames(0)
+{
+    if(!m_isWriter)
+    {
+        std::lock_guard<std::mutex> lock(getMappingsMutex());
+        getMappings()[(uintptr_t)m_mapping->m_address] = m_mapping;
+    }
+}
+
+RsSharedMemoryRing::~RsSharedMemoryRing()
+{
+    if(m_isWriter)
+    {
+#ifdef __linux__
+        m_header->isAlive = 0;
+        m_header->futex++;
+        futexWake(&m_header->futex);
+        shm_unlink(m_name.c_str());
+#endif
+        return;
+    }
+    std::lock_guard<std::mutex> lock(getMappingsMutex());
+    m_mapping->m_isClosed = true;
+    if(m_mapping->m_outstandingFrames == 0)
+    {
+        getMappings().erase((uintptr_t)m_mapping->m_address);
+    }
+}
+
+std::string RsSharedMemoryRing::getName(unsigned int t_port, long long int t_profileKey)
+{
+    return "/rs-server-" + std::to_string(t_port) + "-" + std::to_string(t_profileKey);
+}
+
+std::shared_ptr<RsSharedMemoryRing> RsSharedMemoryRing::create(const std::string& t_name, uint32_t t_slotCount, uint32_t t_frameSize)
+{
+#ifdef __linux__
+    size_t headerSize = align(sizeof(RsSharedMemoryHeader));
+    size_t slotSize = align(sizeof(RsSharedMemorySlot) + t_frameSize);
+    size_t size = headerSize + t_slotCount * slotSize;
+
+    // a ring left by a server that did not exit cleanly is replaced, its readers keep their own mapping
+    shm_unlink(t_name.c_str());
+    int fd = shm_open(t_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0660);
+    if(fd == -1)
+    {
+        ERR << "cannot create shared memory " << t_name << ": " << strerror(errno);
+        return nullptr;
+    }
+    fchmod(fd, 0660); // not masked by the umask, the readers run as the user or in the group of the server
+    void* address = MAP_FAILED;
+    if(ftruncate(fd, size) == 0)
+    {
+        address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if(address == MAP_FAILED)
+    {
+        ERR << "cannot map shared memory " << t_name << ": " << strerror(errno);
+        shm_unlink(t_name.c_str());
+        return nullptr;
+    }
+
+    // the memory is zeroed, so the sequences and the references of the slots start cleared
+    RsSharedMemoryHeader* header = (RsSharedMemoryHeader*)address;
+    header->version = SHARED_MEMORY_VERSION;
+    header->slotCount = t_slotCount;
+    header->slotSize = slotSize;
+    header->isAlive = 1;
+    pthread_mutexattr_t lockAttributes;
+    pthread_mutexattr_init(&lockAttributes);
+    pthread_mutexattr_setpshared(&lockAttributes, PTHREAD_PROCESS_SHARED);
+    pthread_mutexattr_setrobust(&lockAttributes, PTHREAD_MUTEX_ROBUST);
+    for(uint32_t i = 0; i < SHARED_MEMORY_READERS; i++)
+    {
+        pthread_mutex_init(&header->readerLocks[i], &lockAttributes);
+    }
+    pthread_mutexattr_destroy(&lockAttributes);
+    // the readers accept the ring only once the magic is there
+    std::atomic_thread_fence(std::memory_order_release);
+    header->magic = SHARED_MEMORY_MAGIC;
+    return std::shared_ptr<RsSharedMemoryRing>(new RsSharedMemoryRing(t_name, std::make_shared<RsSharedMemoryMapping>(address, size), true));
+#else
+    WRN << "shared memory transport is supported on Linux only";
+    return nullptr;
+#endif
+}
+
+std::shared_ptr<RsSharedMemoryRing> RsSharedMemoryRing::open(const std::string& t_name)
+{
+#ifdef __linux__
+    int fd = shm_open(t_name.c_str(), O_RDWR, 0);
+    if(fd == -1)
+    {
+        return nullptr;
+    }
+    struct stat status;
+    void* address = MAP_FAILED;
+    if(fstat(fd, &status) == 0 && status.st_size >= (off_t)sizeof(RsSharedMemoryHeader))
+    {
+        address = mmap(nullptr, status.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if(address == MAP_FAILED)
+    {
+        return nullptr;
+    }
+
+    auto mapping = std::make_shared<RsSharedMemoryMapping>(address, status.st_size);
+    RsSharedMemoryHeader* header = (RsSharedMemoryHeader*)address;
+    uint32_t magic = header->magic;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if(magic != SHARED_MEMORY_MAGIC || header->version != SHARED_MEMORY_VERSION || !header->isAlive ||
+       align(sizeof(RsSharedMemoryHeader)) + (size_t)header->slotCount * header->slotSize > (size_t)status.st_size)
+    {
+        WRN << "shared memory " << t_name << " is not a ring of this version";
+        return nullptr;
+    }
+    std::shared_ptr<RsSharedMemoryRing> ring(new RsSharedMemoryRing(t_name, mapping, false));
+    if(!ring->takeReaderEntry())
+    {
+        WRN << "shared memory " << t_name << " has " << SHARED_MEMORY_READERS << " readers already";
+        return nullptr;
+    }
+    return ring;
+#else
+    return nullptr;
+#endif
+}
+
+RsSharedMemorySlot* RsSharedMemoryRing::getSlot(uint32_t t_index) const
+{
+    return (RsSharedMemorySlot*)((unsigned char*)m_header + align(sizeof(RsSharedMemoryHeader)) + (size_t)t_index * m_header->slotSize);
+}
+
+bool RsSharedMemoryRing::isSlotFree(RsSharedMemorySlot* t_slot) const
+{
+    for(uint32_t i = 0; i < SHARED_MEMORY_READERS; i++)
+    {
+        if(t_slot->references[i] != 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool RsSharedMemoryRing::takeReaderEntry()
+{
+#ifdef __linux__
+    std::promise<int> entry;
+    std::future<int> takenEntry = entry.get_future();
+    RsSharedMemoryHeader* header = m_header;
+    RsSharedMemoryMapping* mapping = m_mapping.get();
+    // the thread holds the lock of the entry until the mapping is destroyed, which joins it
+    m_mapping->m_leaseThread = std::thread(
+        [this, header, mapping](std::promise<int> t_entry) {
+            int index = -1;
+            for(int i = 0; i < SHARED_MEMORY_READERS && index == -1; i++)
+            {
+                int result = pthread_mutex_trylock(&header->readerLocks[i]);
+                if(result == EOWNERDEAD)
+                {
+                    // the references of a reader that died are left in the entry
+                    clearReferences(i);
+                    pthread_mutex_consistent(&header->readerLocks[i]);
+                    result = 0;
+                }
+                if(result == 0)
+                {
+                    index = i;
+                }
+            }
+            // the ring is not used past this point, it may be gone before the mapping
+            t_entry.set_value(index);
+            if(index == -1)
+            {
+                return;
+            }
+            std::unique_lock<std::mutex> lock(mapping->m_leaseMutex);
+            mapping->m_leaseCondition.wait(lock, [mapping]() { return mapping->m_isLeaseReleased; });
+            pthread_mutex_unlock(&header->readerLocks[index]);
+        },
+        std::move(entry));
+    m_readerIndex = takenEntry.get();
+    if(m_readerIndex != -1)
+    {
+        std::lock_guard<std::mutex> lock(getMappingsMutex());
+        m_mapping->m_readerIndex = m_readerIndex;
+        return true;
+    }
+#endif
+    return false;
+}
+
+bool RsSharedMemoryRing::reclaimDeadReaders()
+{
+    bool isReclaimed = false;
+#ifdef __linux__
+    for(uint32_t i = 0; i < SHARED_MEMORY_READERS; i++)
+    {
+        // the lock of a live reader is held, the lock of a reader that died is handed over with EOWNERDEAD
+        int result = pthread_mutex_trylock(&m_header->readerLocks[i]);
+        if(result == EOWNERDEAD)
+        {
+            WRN << "shared memory " << m_name << " releases the frames of reader " << i << " that died";
+            clearReferences(i);
+            pthread_mutex_consistent(&m_header->readerLocks[i]);
+            isReclaimed = true;
+        }
+        if(result == 0 || result == EOWNERDEAD)
+        {
+            pthread_mutex_unlock(&m_header->readerLocks[i]);
+        }
+    }
+#endif
+    return isReclaimed;
+}
+
+void RsSharedMemoryRing::clearReferences(uint32_t t_readerIndex)
+{
+    for(uint32_t i = 0; i < m_header->slotCount; i++)
+    {
+        getSlot(i)->references[t_readerIndex] = 0;
+    }
+}
+
+RsSharedMemorySlot* RsSharedMemoryRing::takeFreeSlot()
+{
+    for(uint32_t i = 0; i < m_header->slotCount; i++)
+    {
+        uint32_t index = (m_nextSlot + i) % m_header->slotCount;
+        RsSharedMemorySlot* slot = getSlot(index);
+        if(!isSlotFree(slot))
+        {
+            continue;
+        }
+        // a reader that referenced the slot before the sequence was cleared still holds it, the slot is skipped.
+        // a reader that references it afterwards sees the cleared sequence and lets it go
+        slot->sequence = 0;
+        if(!isSlotFree(slot))
+        {
+            continue;
+        }
+        m_nextSlot = (index + 1) % m_header->slotCount;
+        return slot;
+    }
+    return nullptr;
+}
+
+bool RsSharedMemoryRing::publish(const RsMetadataHeader& t_metadata, const void* t_data, uint32_t t_size)
+{
+#ifdef __linux__
+    if(sizeof(RsSharedMemorySlot) + t_size > m_header->slotSize)
+    {
+        m_droppedFrames++;
+        return false;
+    }
+    RsSharedMemorySlot* slot = takeFreeSlot();
+    // the slots held by readers that crashed are never released by them
+    if(slot == nullptr && reclaimDeadReaders())
+    {
+        slot = takeFreeSlot();
+    }
+    if(slot != nullptr)
+    {
+        slot->metadata = t_metadata;
+        slot->size = t_size;
+        memcpy(getFrameData(slot), t_data, t_size);
+
+        uint64_t sequence = m_header->lastSequence + 1;
+        slot->sequence = sequence;
+        m_header->lastSequence = sequence;
+        m_header->futex++;
+        futexWake(&m_header->futex);
+        return true;
+    }
+#endif
+    m_droppedFrames++;
+    return false;
+}
+
+bool RsSharedMemoryRing::waitFrame(uint64_t t_lastSequence, std::chrono::milliseconds t_timeout)
+{
+#ifdef __linux__
+    auto deadline = std::chrono::steady_clock::now() + t_timeout;
+    while(true)
+    {
+        uint32_t futexValue = m_header->futex;
+        if(m_header->lastSequence > t_lastSequence)
+        {
+            return true;
+        }
+        auto remaining = deadline - std::chrono::steady_clock::now();
+        if(!m_header->isAlive || remaining <= std::chrono::nanoseconds::zero())
+        {
+            return false;
+        }
+        futexWait(&m_header->futex, futexValue, remaining);
+    }
+#else
+    return false;
+#endif
+}
+
+RsSharedMemorySlot* RsSharedMemoryRing::acquireLatest(uint64_t& t_sequence)
+{
+    t_sequence = m_header->lastSequence;
+    for(uint32_t i = 0; t_sequence && i < m_header->slotCount; i++)
+    {
+        RsSharedMemorySlot* slot = getSlot(i);
+        if(slot->sequence != t_sequence)
+        {
+            continue;
+        }
+        slot->references[m_readerIndex]++;
+        if(slot->sequence != t_sequence)
+        {
+            slot->references[m_readerIndex]--;
+            return nullptr;
+        }
+        std::lock_guard<std::mutex> lock(getMappingsMutex());
+        m_mapping->m_outstandingFrames++;
+        return slot;
+    }
+    return nullptr;
+}
+
+void RsSharedMemoryRing::releaseFrame(void* t_data)
+{
+    RsSharedMemorySlot* slot = (RsSharedMemorySlot*)((unsigned char*)t_data - sizeof(RsSharedMemorySlot));
+
+    std::lock_guard<std::mutex> lock(getMappingsMutex());
+    auto& mappings = getMappings();
+    auto mapping = mappings.upper_bound((uintptr_t)t_data);
+    if(mapping == mappings.begin())
+    {
+        return;
+    }
+    mapping--;
+    slot->references[mapping->second->m_readerIndex]--;
+    if(--mapping->second->m_outstandingFrames == 0 && mapping->second->m_isClosed)
+    {
+        mappings.erase(mapping);
+    }
+}
+
+bool RsSharedMemoryRing::isAlive() const
+{
+    return m_header->isAlive != 0;
+}
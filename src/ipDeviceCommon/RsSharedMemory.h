@@ -0,0 +1,107 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <ipDeviceCommon/RsCommon.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+
+#ifdef __linux__
+#include <pthread.h>
+#endif
+
+#define SHARED_MEMORY_MAGIC 0x4D485352 // "RSHM"
+#define SHARED_MEMORY_VERSION 3
+#define SHARED_MEMORY_SLOTS 8
+#define SHARED_MEMORY_READERS 8 // readers of a ring at the same time, the other clients read the stream over RTP
+#define SHARED_MEMORY_PARAMETER "shm" // session parameter that moves a stream of the session to the shared memory
+
+#pragma pack(push, 8)
+struct RsSharedMemoryHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t slotCount;
+    uint32_t slotSize; // bytes of a slot, including RsSharedMemorySlot
+    std::atomic<uint64_t> lastSequence; // sequence of the newest published frame
+    std::atomic<uint32_t> futex; // changes on every publish and on close, the readers wait on it
+    std::atomic<uint32_t> isAlive;
+#ifdef __linux__
+    // robust process shared mutexes, each held by a reader for as long as it uses its entry
+    pthread_mutex_t readerLocks[SHARED_MEMORY_READERS];
+#endif
+};
+
+struct RsSharedMemorySlot
+{
+    std::atomic<uint64_t> sequence; // 0 while the slot is written
+    std::atomic<uint32_t> references[SHARED_MEMORY_READERS]; // frames of this slot that each reader did not release
+    uint32_t size;
+    RsMetadataHeader metadata;
+    // the frame data follows
+};
+#pragma pack(pop)
+
+struct RsSharedMemoryMapping;
+
+// Ring of frame slots in POSIX shared memory, written by rs-server and read by the clients on the same host.
+// The readers hand the slots to the software sensor as is, and a slot is not written again before all the frames
+// that reference it are released. When all the slots are referenced the writer drops the frame, so a slow reader
+// never blocks the writer or the other readers.
+// Each reader takes an entry of the ring by locking its robust mutex and counts its references in its own column of the
+// slots. When all the slots are referenced the writer releases the references of the entries whose lock was left by a
+// reader that died (EOWNERDEAD), so a reader that crashed does not hold its slots forever, whatever pid namespace it
+// runs in. The ring is readable by the user and the group of the server only. Supported on Linux only.
+class RsSharedMemoryRing
+{
+public:
+    ~RsSharedMemoryRing();
+
+    static std::string getName(unsigned int t_port, long long int t_profileKey);
+    // returns nullptr when the ring cannot be created or opened
+    static std::shared_ptr<RsSharedMemoryRing> create(const std::string& t_name, uint32_t t_slotCount, uint32_t t_frameSize);
+    static std::shared_ptr<RsSharedMemoryRing> open(const std::string& t_name);
+
+    // writer
+    bool publish(const RsMetadataHeader& t_metadata, const void* t_data, uint32_t t_size);
+    unsigned long long getDroppedFrames() const
+    {
+        return m_droppedFrames;
+    }
+
+    // reader, waits until a frame newer than t_lastSequence is published or the writer closes the ring
+    bool waitFrame(uint64_t t_lastSequence, std::chrono::milliseconds t_timeout);
+    // references the newest frame, returns nullptr when it was overwritten meanwhile
+    RsSharedMemorySlot* acquireLatest(uint64_t& t_sequence);
+    // releases the slot of the given frame data, it is the deleter of the frames handed to the software sensor
+    static void releaseFrame(void* t_data);
+    static unsigned char* getFrameData(RsSharedMemorySlot* t_slot)
+    {
+        return (unsigned char*)t_slot + sizeof(RsSharedMemorySlot);
+    }
+    bool isAlive() const;
+
+private:
+    RsSharedMemoryRing(const std::string& t_name, std::shared_ptr<RsSharedMemoryMapping> t_mapping, bool t_isWriter);
+    RsSharedMemorySlot* getSlot(uint32_t t_index) const;
+    bool isSlotFree(RsSharedMemorySlot* t_slot) const;
+    // returns a slot that no reader references, with its sequence cleared, or nullptr
+    RsSharedMemorySlot* takeFreeSlot();
+    // takes a free entry of the readers, or the entry of a reader that died
+    bool takeReaderEntry();
+    // releases the references of the readers that died, returns true when there were any
+    bool reclaimDeadReaders();
+    void clearReferences(uint32_t t_readerIndex);
+
+    std::string m_name;
+    std::shared_ptr<RsSharedMemoryMapping> m_mapping;
+    RsSharedMemoryHeader* m_header;
+    bool m_isWriter;
+    int m_readerIndex; // entry of the reader in the ring, -1 for the writer
+    uint32_t m_nextSlot;
+    unsigned long long m_droppedFrames;
+};
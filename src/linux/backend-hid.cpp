@@ -434,6 +434,7 @@ namespace librealsense
               _sampling_frequency_name(""),
               _callback(nullptr),
               _is_capturing(false),
+              _previous_watermark(0),
               _pm_dispatcher(16)    // queue for async power management commands
         {
             init(frequency);
@@ -447,9 +448,11 @@ namespace librealsense
                     // Ensure PM sync
                     _pm_dispatcher.flush();
                     stop_capture();
+                    _pm_dispatcher.flush();
                 } catch(...){}
 
                 clear_buffer();
+                restore_iio_watermark();
             }
             catch(...){}
 
@@ -542,6 +545,7 @@ namespace librealsense
                         }
                         else if (FD_ISSET(_fd, &fds))
                         {
+                            // everything the kernel buffered up to the watermark is read at once
                             read_size = read(_fd, raw_data.data(), raw_data_size);
                             if (read_size < 0 )
                                 continue;
@@ -552,11 +556,25 @@ namespace librealsense
                             continue;
                         }
 
-                        // TODO: code refactoring to reduce latency
-                        for (auto i = 0; i < read_size / channel_size; ++i)
+                        auto samples = read_size / channel_size;
+                        if (!samples)
+                            continue;
+
+                        // The batch arrives with the wakeup, the samples before the last one are stamped back
+                        // by their distance from it on the IIO timestamps (nsec)
+                        auto now_ts = std::chrono::duration<double, std::milli>(std::chrono::system_clock::now().time_since_epoch()).count();
+                        auto last_iio_ts = metadata ? *(reinterpret_cast<uint64_t *>(&raw_data[channel_size * (samples - 1) + 16])) : 0;
+
+                        for (auto i = 0; i < samples; ++i)
                         {
-                            auto now_ts = std::chrono::duration<double, std::milli>(std::chrono::system_clock::now().time_since_epoch()).count();
                             auto p_raw_data = raw_data.data() + channel_size * i;
+                            auto sample_ts = now_ts;
+                            if (metadata)
+                            {
+                                auto iio_ts = *(reinterpret_cast<uint64_t *>(&p_raw_data[16]));
+                                if (iio_ts <= last_iio_ts)
+                                    sample_ts -= (last_iio_ts - iio_ts) / 1000000.;
+                            }
                             sensor_data sens_data{};
                             sens_data.sensor = hid_sensor{get_sensor_name()};
 
@@ -577,7 +595,7 @@ namespace librealsense
 //                            meta_data.report_type.imu_report.usb_counter = p_raw_data[31];
 
                             sens_data.fo = {hid_data_size, metadata? meta_data.header.length: uint8_t(0),
-                                            p_raw_data,  metadata? &meta_data : nullptr, now_ts};
+                                            p_raw_data,  metadata? &meta_data : nullptr, sample_ts};
                             //Linux HID provides timestamps in nanosec. Convert to usec (FW default)
                             if (metadata)
                             {
@@ -652,6 +670,39 @@ namespace librealsense
             _channels.clear();
         }
 
+        uint32_t iio_hid_sensor::get_iio_watermark()
+        {
+            auto watermark = getenv("RS2_IIO_WATERMARK");
+            if (!watermark || atoi(watermark) <= 1)
+                return 1;
+            return std::min(static_cast<uint32_t>(atoi(watermark)), hid_buf_len / 2);
+        }
+
+        void iio_hid_sensor::set_iio_watermark()
+        {
+            // The attribute is missing on kernels older than 4.2, those wake up on every sample
+            auto path = _iio_device_path + "/buffer/watermark";
+            std::ifstream watermark_file(path);
+            if (!watermark_file.good())
+                return;
+            watermark_file >> _previous_watermark;
+            watermark_file.close();
+
+            // Written even for the default, a previous session may have left a larger value behind
+            auto watermark = get_iio_watermark();
+            if (!write_fs_attribute(path, watermark))
+                LOG_WARNING("HID watermark " << watermark << " is not supported by " << _iio_device_path);
+        }
+
+        void iio_hid_sensor::restore_iio_watermark()
+        {
+            if (!_previous_watermark)
+                return;
+
+            write_fs_attribute(_iio_device_path + "/buffer/watermark", _previous_watermark);
+            _previous_watermark = 0;
+        }
+
         void iio_hid_sensor::set_frequency(uint32_t frequency)
         {
             auto sampling_frequency_path = _iio_device_path + "/" + _sampling_frequency_name;
@@ -784,6 +835,9 @@ namespace librealsense
 
             set_frequency(frequency);
             write_fs_attribute(_iio_device_path + "/buffer/length", hid_buf_len);
+
+            // Batch the wakeups, at the cost of up to watermark samples of latency.
+            set_iio_watermark();
         }
 
         // calculate the storage size of a scan
@@ -149,6 +149,13 @@ namespace librealsense
             void set_frequency(uint32_t frequency);
             void set_power(bool on);
 
+            // samples the kernel buffers before waking the reader up, set by RS2_IIO_WATERMARK (default 1)
+            static uint32_t get_iio_watermark();
+
+            // applies get_iio_watermark() to the buffer, keeping the value found there for restore_iio_watermark()
+            void set_iio_watermark();
+            void restore_iio_watermark();
+
             void signal_stop();
 
             bool has_metadata();
@@ -181,6 +188,7 @@ namespace librealsense
             std::list<hid_input*> _channels;
             hid_callback _callback;
             std::atomic<bool> _is_capturing;
+            uint32_t _previous_watermark;   // 0 when the buffer has no watermark attribute
             std::unique_ptr<std::thread> _hid_thread;
             std::unique_ptr<std::thread> _pm_thread;    // Delayed initialization due to power-up sequence
             dispatcher                  _pm_dispatcher; // Asynchronous power management
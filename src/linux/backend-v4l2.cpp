@@ -42,6 +42,9 @@
 #include <list>
 
 #include <sys/signalfd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <poll.h>
 #include <signal.h>
 #pragma GCC diagnostic ignored "-Woverflow"
 
@@ -671,6 +674,193 @@ namespace librealsense
             }
         }
 
+        static const auto frames_timeout = std::chrono::seconds(5);
+        static const int reactor_poll_interval_ms = 1000;
+        static const uint64_t reactor_stop_id = 0;
+
+        std::shared_ptr<v4l_capture_reactor> v4l_capture_reactor::get_instance()
+        {
+            static std::mutex instance_mutex;
+            static std::weak_ptr<v4l_capture_reactor> instance;
+
+            auto threads = getenv("RS2_V4L2_REACTOR_THREADS");
+            if (!threads || atoi(threads) <= 0)
+                return nullptr;
+
+            // the reactor lives while devices are streaming through it
+            std::lock_guard<std::mutex> lock(instance_mutex);
+            auto reactor = instance.lock();
+            if (!reactor)
+            {
+                reactor = std::make_shared<v4l_capture_reactor>(static_cast<size_t>(atoi(threads)));
+                instance = reactor;
+            }
+            return reactor;
+        }
+
+        v4l_capture_reactor::v4l_capture_reactor(size_t threads)
+            : _is_running(true), _next_id(reactor_stop_id + 1)
+        {
+            _epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+            if (_epoll_fd < 0)
+                throw linux_backend_exception("v4l_capture_reactor: epoll_create1 failed");
+
+            _stop_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+            if (_stop_fd < 0)
+            {
+                ::close(_epoll_fd);
+                throw linux_backend_exception("v4l_capture_reactor: eventfd failed");
+            }
+
+            // level triggered, so the stop wakes up all the threads
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.u64 = reactor_stop_id;
+            if (epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _stop_fd, &event) < 0)
+            {
+                ::close(_stop_fd);
+                ::close(_epoll_fd);
+                throw linux_backend_exception("v4l_capture_reactor: epoll_ctl failed for the stop event");
+            }
+
+            for (size_t i = 0; i < threads; i++)
+                _threads.emplace_back([this]() { run(); });
+            LOG_INFO("V4L capture reactor started with " << threads << " threads");
+        }
+
+        v4l_capture_reactor::~v4l_capture_reactor()
+        {
+            _is_running = false;
+            uint64_t value = 1;
+            if (write(_stop_fd, &value, sizeof(value)) < 0)
+                LOG_ERROR("v4l_capture_reactor: could not signal the threads to stop");
+            for (auto&& thread : _threads)
+                if (thread.joinable()) thread.join();
+            ::close(_stop_fd);
+            ::close(_epoll_fd);
+        }
+
+        uint64_t v4l_capture_reactor::add(int fd, std::function<void()> on_ready, std::function<void()> on_timeout)
+        {
+            auto reg = std::make_shared<registration>();
+            reg->fd = fd;
+            reg->on_ready = std::move(on_ready);
+            reg->on_timeout = std::move(on_timeout);
+            reg->active = true;
+            reg->last_event = std::chrono::steady_clock::now();
+
+            uint64_t id;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                id = _next_id++;
+                _registrations[id] = reg;
+            }
+
+            epoll_event event{};
+            event.events = EPOLLIN | EPOLLET | EPOLLONESHOT;
+            event.data.u64 = id;
+            if (epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _registrations.erase(id);
+                throw linux_backend_exception(to_string() << "v4l_capture_reactor: epoll_ctl failed for fd " << fd);
+            }
+            return id;
+        }
+
+        void v4l_capture_reactor::remove(uint64_t id)
+        {
+            auto reg = find(id);
+            if (!reg)
+                return;
+
+            if (epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, reg->fd, nullptr) < 0)
+                LOG_WARNING("v4l_capture_reactor: epoll_ctl(EPOLL_CTL_DEL) failed for fd " << reg->fd);
+
+            // waits for a handler that is running
+            {
+                std::lock_guard<std::mutex> lock(reg->mutex);
+                reg->active = false;
+            }
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            _registrations.erase(id);
+        }
+
+        std::shared_ptr<v4l_capture_reactor::registration> v4l_capture_reactor::find(uint64_t id)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto it = _registrations.find(id);
+            return it == _registrations.end() ? nullptr : it->second;
+        }
+
+        void v4l_capture_reactor::run()
+        {
+            const int max_events = 16;
+            epoll_event events[max_events];
+            while (_is_running)
+            {
+                int count = epoll_wait(_epoll_fd, events, max_events, reactor_poll_interval_ms);
+                if (count < 0 && errno != EINTR)
+                {
+                    LOG_ERROR("v4l_capture_reactor: epoll_wait failed, errno " << errno);
+                    break;
+                }
+
+                for (int i = 0; i < count && _is_running; i++)
+                {
+                    auto id = events[i].data.u64;
+                    if (id == reactor_stop_id)
+                        continue;
+
+                    auto reg = find(id);
+                    if (!reg)
+                        continue;
+
+                    std::lock_guard<std::mutex> lock(reg->mutex);
+                    if (!reg->active)
+                        continue;
+                    reg->last_event = std::chrono::steady_clock::now();
+                    reg->on_ready();
+
+                    // the handler drained the node, arm it for the next frame
+                    epoll_event event{};
+                    event.events = EPOLLIN | EPOLLET | EPOLLONESHOT;
+                    event.data.u64 = id;
+                    if (epoll_ctl(_epoll_fd, EPOLL_CTL_MOD, reg->fd, &event) < 0)
+                        LOG_ERROR("v4l_capture_reactor: epoll_ctl(EPOLL_CTL_MOD) failed for fd " << reg->fd);
+                }
+
+                check_timeouts();
+            }
+        }
+
+        void v4l_capture_reactor::check_timeouts()
+        {
+            // one thread checks at a time
+            std::unique_lock<std::mutex> timeouts_lock(_timeouts_mutex, std::try_to_lock);
+            if (!timeouts_lock.owns_lock())
+                return;
+
+            std::vector<std::shared_ptr<registration>> registrations;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                for (auto&& reg : _registrations)
+                    registrations.push_back(reg.second);
+            }
+
+            auto now = std::chrono::steady_clock::now();
+            for (auto&& reg : registrations)
+            {
+                std::unique_lock<std::mutex> lock(reg->mutex, std::try_to_lock);
+                if (lock.owns_lock() && reg->active && now - reg->last_event > frames_timeout)
+                {
+                    reg->last_event = now;
+                    reg->on_timeout();
+                }
+            }
+        }
+
         v4l_uvc_device::v4l_uvc_device(const uvc_device_info& info, bool use_memory_map)
             : _name(""), _info(),
               _is_capturing(false),
@@ -679,6 +869,8 @@ namespace librealsense
               _thread(nullptr),
               _named_mtx(nullptr),
               _use_memory_map(use_memory_map),
+              _newest_frame_only(false),
+              _dropped_frames(0),
               _fd(-1),
               _stop_pipe_fd{}
         {
@@ -701,6 +893,7 @@ namespace librealsense
         v4l_uvc_device::~v4l_uvc_device()
         {
             _is_capturing = false;
+            if (_reactor) _reactor->remove(_reactor_id);
             if (_thread && _thread->joinable()) _thread->join();
             for (auto&& fd : _fds)
             {
@@ -798,7 +991,18 @@ namespace librealsense
                 streamon();
 
                 _is_capturing = true;
-                _thread = std::unique_ptr<std::thread>(new std::thread([this](){ capture_loop(); }));
+                {
+                    std::lock_guard<std::mutex> lock(_wakeup_latency_mutex);
+                    _wakeup_count = 0;
+                    _wakeup_latency_total = _wakeup_latency_max = 0;
+                }
+                _dropped_frames = 0;
+                _has_sequence = false;
+                _reactor = v4l_capture_reactor::get_instance();
+                if (_reactor)
+                    _reactor_id = _reactor->add(_fd, [this]() { on_frames_ready(); }, [this]() { notify_frames_timeout(); });
+                else
+                    _thread = std::unique_ptr<std::thread>(new std::thread([this](){ capture_loop(); }));
             }
         }
 
@@ -812,11 +1016,26 @@ namespace librealsense
             _is_capturing = false;
             _is_started = false;
 
-            // Stop nn-demand frames polling
-            signal_stop();
+            if (_reactor)
+            {
+                _reactor->remove(_reactor_id);
+                _reactor.reset();
+            }
+            else
+            {
+                // Stop nn-demand frames polling
+                signal_stop();
+
+                _thread->join();
+                _thread.reset();
+            }
 
-            _thread->join();
-            _thread.reset();
+            auto wakeup_latency = get_wakeup_latency();
+            if (wakeup_latency.frames)
+                LOG_INFO(_name << " frames wakeup latency avg " << wakeup_latency.average_ms
+                    << " ms, max " << wakeup_latency.max_ms << " ms over " << wakeup_latency.frames << " frames");
+            if (_dropped_frames)
+                LOG_INFO(_name << " dropped " << _dropped_frames << " frames at the kernel boundary");
 
             // Notify kernel
             streamoff();
@@ -920,123 +1139,208 @@ namespace librealsense
                             return;
                         }
                     }
-                    else // Check and acquire data buffers from kernel
+                    else if(FD_ISSET(_fd, &fds))
                     {
-                        bool md_extracted = false;
-                        buffers_mgr buf_mgr(_use_memory_map);
-                        // RAII to handle exceptions
-                        std::unique_ptr<int, std::function<void(int*)> > md_poller(new int(0),
-                            [this,&buf_mgr,&md_extracted,&fds](int* d)
-                            {
-                                if (!md_extracted) acquire_metadata(buf_mgr,fds);
-                                delete d;
-                            });
+                        FD_CLR(_fd,&fds);
+                        acquire_frame(fds);
+                    }
+                    else
+                    {
+                        LOG_WARNING("FD_ISSET signal false - no data on video node sink");
+                    }
+                }
+                else // (val==0)
+                {
+                    notify_frames_timeout();
+                }
+            }
+        }
 
-                        if(FD_ISSET(_fd, &fds))
-                        {
-                            FD_CLR(_fd,&fds);
-                            v4l2_buffer buf = {};
-                            buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-                            buf.memory = _use_memory_map ? V4L2_MEMORY_MMAP : V4L2_MEMORY_USERPTR;
-                            if(xioctl(_fd, VIDIOC_DQBUF, &buf) < 0)
-                            {
-                                LOG_DEBUG_V4L("Dequeued empty buf for fd " << std::dec << _fd);
-                                if(errno == EAGAIN)
-                                    return;
+        void v4l_uvc_device::notify_frames_timeout()
+        {
+            LOG_WARNING("Frames didn't arrived within 5 seconds");
+            librealsense::notification n = {RS2_NOTIFICATION_CATEGORY_FRAMES_TIMEOUT, 0, RS2_LOG_SEVERITY_WARN,  "Frames didn't arrived within 5 seconds"};
 
-                                throw linux_backend_exception(to_string() << "xioctl(VIDIOC_DQBUF) failed for fd: " << _fd);
-                            }
-                            LOG_DEBUG_V4L("Dequeued buf " << std::dec << buf.index << " for fd " << _fd << " seq " << buf.sequence);
+            _error_handler(n);
+        }
 
-                            auto buffer = _buffers[buf.index];
-                            buf_mgr.handle_buffer(e_video_buf,_fd, buf,buffer);
+        void v4l_uvc_device::on_frames_ready()
+        {
+            // the node is edge triggered, all the frames it has ready are dequeued before it is armed again
+            try
+            {
+                fd_set fds{};
+                while (_is_capturing)
+                {
+                    FD_ZERO(&fds);
+                    if (!acquire_frame(fds))
+                        break;
+                }
+            }
+            catch (const std::exception& ex)
+            {
+                LOG_ERROR(ex.what());
 
-                            if (_is_started)
-                            {
-                                if(buf.bytesused == 0)
-                                {
-                                    LOG_INFO("Empty video frame arrived");
-                                    return;
-                                }
+                librealsense::notification n = {RS2_NOTIFICATION_CATEGORY_UNKNOWN_ERROR, 0, RS2_LOG_SEVERITY_ERROR, ex.what()};
 
-                                // Relax the required frame size for compressed formats, i.e. MJPG, Z16H
-                                // Drop partial and overflow frames (assumes D4XX metadata only)
-                                bool compressed_format = val_in_range(_profile.format, { 0x4d4a5047U , 0x5a313648U});
-                                bool partial_frame = (!compressed_format && (buf.bytesused < buffer->get_full_length() - MAX_META_DATA_SIZE));
-                                bool overflow_frame = (buf.bytesused ==  buffer->get_length_frame_only() + MAX_META_DATA_SIZE);
-                                if (partial_frame || overflow_frame)
-                                {
-                                    auto percentage = (100 * buf.bytesused) / buffer->get_full_length();
-                                    std::stringstream s;
-                                    if (partial_frame)
-                                    {
-                                        s << "Incomplete video frame detected!\nSize " << buf.bytesused
-                                            << " out of " << buffer->get_full_length() << " bytes (" << percentage << "%)";
-                                        if (overflow_frame)
-                                        {
-                                            s << ". Overflow detected: payload size " << buffer->get_length_frame_only();
-                                            LOG_ERROR("Corrupted UVC frame data, underflow and overflow reported:\n" << s.str().c_str());
-                                        }
-                                    }
-                                    else
-                                    {
-                                        if (overflow_frame)
-                                            s << "overflow video frame detected!\nSize " << buf.bytesused
-                                                << ", payload size " << buffer->get_length_frame_only();
-                                    }
-                                    librealsense::notification n = { RS2_NOTIFICATION_CATEGORY_FRAME_CORRUPTED, 0, RS2_LOG_SEVERITY_WARN, s.str()};
-
-                                    _error_handler(n);
-                                }
-                                else
-                                {
-                                    auto timestamp = (double)buf.timestamp.tv_sec*1000.f + (double)buf.timestamp.tv_usec/1000.f;
-                                    timestamp = monotonic_to_realtime(timestamp);
-
-                                    // Read metadata. For metadata note performs a blocking call to ensure video and metadata sync
-                                    acquire_metadata(buf_mgr,fds,compressed_format);
-                                    md_extracted = true;
-
-                                    //if (val > 1)
-                                    //    LOG_INFO("Frame buf ready, md size: " << std::dec << (int)buf_mgr.metadata_size() << " seq. id: " << buf.sequence);
-                                    frame_object fo{ std::min(buf.bytesused - buf_mgr.metadata_size(), buffer->get_length_frame_only()), buf_mgr.metadata_size(),
-                                        buffer->get_frame_start(), buf_mgr.metadata_start(), timestamp };
-
-                                    buffer->attach_buffer(buf);
-                                    buf_mgr.handle_buffer(e_video_buf,-1); // transfer new buffer request to the frame callback
-
-                                    if (buf_mgr.verify_vd_md_sync())
-                                    {
-                                        //Invoke user callback and enqueue next frame
-                                        _callback(_profile, fo, [buf_mgr]() mutable {
-                                            buf_mgr.request_next_frame();
-                                        });
-                                    }
-                                    else
-                                    {
-                                        LOG_WARNING("Video frame dropped, video and metadata buffers inconsistency");
-                                    }
-                                }
-                            }
-                            else
-                            {
-                                LOG_INFO("Video frame arrived in idle mode."); // TODO - verification
-                            }
-                        }
-                        else
+                _error_handler(n);
+            }
+        }
+
+        void v4l_uvc_device::record_wakeup_latency(const v4l2_buffer& buf)
+        {
+            if ((buf.flags & V4L2_BUF_FLAG_TIMESTAMP_MASK) != V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC)
+                return;
+
+            struct timespec mono_time;
+            if (clock_gettime(CLOCK_MONOTONIC, &mono_time))
+                return;
+
+            double latency = (mono_time.tv_sec - buf.timestamp.tv_sec) * 1000. + (mono_time.tv_nsec / 1000 - buf.timestamp.tv_usec) / 1000.;
+            std::lock_guard<std::mutex> lock(_wakeup_latency_mutex);
+            _wakeup_count++;
+            _wakeup_latency_total += latency;
+            _wakeup_latency_max = std::max(_wakeup_latency_max, latency);
+        }
+
+        v4l_uvc_device::wakeup_latency_statistic v4l_uvc_device::get_wakeup_latency() const
+        {
+            std::lock_guard<std::mutex> lock(_wakeup_latency_mutex);
+            wakeup_latency_statistic statistic;
+            statistic.frames = _wakeup_count;
+            statistic.average_ms = _wakeup_count ? _wakeup_latency_total / _wakeup_count : 0;
+            statistic.max_ms = _wakeup_latency_max;
+            return statistic;
+        }
+
+        void v4l_uvc_device::record_dropped_frames(const v4l2_buffer& buf)
+        {
+            // the driver advances the sequence also for the frames it had no queued buffer for
+            if (_has_sequence && (buf.sequence > _last_sequence + 1))
+                _dropped_frames += buf.sequence - _last_sequence - 1;
+            _last_sequence = buf.sequence;
+            _has_sequence = true;
+        }
+
+        bool v4l_uvc_device::is_frame_pending() const
+        {
+            pollfd fd = { _fd, POLLIN, 0 };
+            return (::poll(&fd, 1, 0) > 0) && (fd.revents & POLLIN);
+        }
+
+        bool v4l_uvc_device::acquire_frame(fd_set& fds)
+        {
+            bool md_extracted = false;
+            buffers_mgr buf_mgr(_use_memory_map);
+            // RAII to handle exceptions
+            std::unique_ptr<int, std::function<void(int*)> > md_poller(new int(0),
+                [this,&buf_mgr,&md_extracted,&fds](int* d)
+                {
+                    if (!md_extracted) acquire_metadata(buf_mgr,fds);
+                    delete d;
+                });
+
+            v4l2_buffer buf = {};
+            buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+            buf.memory = _use_memory_map ? V4L2_MEMORY_MMAP : V4L2_MEMORY_USERPTR;
+            if(xioctl(_fd, VIDIOC_DQBUF, &buf) < 0)
+            {
+                LOG_DEBUG_V4L("Dequeued empty buf for fd " << std::dec << _fd);
+                if(errno == EAGAIN)
+                {
+                    // nothing was dequeued, so there is no metadata to match
+                    md_extracted = true;
+                    return false;
+                }
+
+                throw linux_backend_exception(to_string() << "xioctl(VIDIOC_DQBUF) failed for fd: " << _fd);
+            }
+            LOG_DEBUG_V4L("Dequeued buf " << std::dec << buf.index << " for fd " << _fd << " seq " << buf.sequence);
+            record_wakeup_latency(buf);
+            record_dropped_frames(buf);
+
+            auto buffer = _buffers[buf.index];
+            buf_mgr.handle_buffer(e_video_buf,_fd, buf,buffer);
+
+            if (_is_started)
+            {
+                if(buf.bytesused == 0)
+                {
+                    LOG_INFO("Empty video frame arrived");
+                    return true;
+                }
+
+                // Relax the required frame size for compressed formats, i.e. MJPG, Z16H
+                // Drop partial and overflow frames (assumes D4XX metadata only)
+                bool compressed_format = val_in_range(_profile.format, { 0x4d4a5047U , 0x5a313648U});
+                bool partial_frame = (!compressed_format && (buf.bytesused < buffer->get_full_length() - MAX_META_DATA_SIZE));
+                bool overflow_frame = (buf.bytesused ==  buffer->get_length_frame_only() + MAX_META_DATA_SIZE);
+                if (partial_frame || overflow_frame)
+                {
+                    auto percentage = (100 * buf.bytesused) / buffer->get_full_length();
+                    std::stringstream s;
+                    if (partial_frame)
+                    {
+                        s << "Incomplete video frame detected!\nSize " << buf.bytesused
+                            << " out of " << buffer->get_full_length() << " bytes (" << percentage << "%)";
+                        if (overflow_frame)
                         {
-                            LOG_WARNING("FD_ISSET signal false - no data on video node sink");
+                            s << ". Overflow detected: payload size " << buffer->get_length_frame_only();
+                            LOG_ERROR("Corrupted UVC frame data, underflow and overflow reported:\n" << s.str().c_str());
                         }
                     }
+                    else
+                    {
+                        if (overflow_frame)
+                            s << "overflow video frame detected!\nSize " << buf.bytesused
+                                << ", payload size " << buffer->get_length_frame_only();
+                    }
+                    librealsense::notification n = { RS2_NOTIFICATION_CATEGORY_FRAME_CORRUPTED, 0, RS2_LOG_SEVERITY_WARN, s.str()};
+
+                    _error_handler(n);
                 }
-                else // (val==0)
+                else
                 {
-                    LOG_WARNING("Frames didn't arrived within 5 seconds");
-                    librealsense::notification n = {RS2_NOTIFICATION_CATEGORY_FRAMES_TIMEOUT, 0, RS2_LOG_SEVERITY_WARN,  "Frames didn't arrived within 5 seconds"};
+                    auto timestamp = (double)buf.timestamp.tv_sec*1000.f + (double)buf.timestamp.tv_usec/1000.f;
+                    timestamp = monotonic_to_realtime(timestamp);
 
-                    _error_handler(n);
+                    // Read metadata. For metadata note performs a blocking call to ensure video and metadata sync
+                    acquire_metadata(buf_mgr,fds,compressed_format);
+                    md_extracted = true;
+
+                    if (_newest_frame_only && is_frame_pending())
+                    {
+                        // a newer frame is already waiting, this one and its metadata are re-queued unread
+                        _dropped_frames++;
+                        return true;
+                    }
+
+                    //if (val > 1)
+                    //    LOG_INFO("Frame buf ready, md size: " << std::dec << (int)buf_mgr.metadata_size() << " seq. id: " << buf.sequence);
+                    frame_object fo{ std::min(buf.bytesused - buf_mgr.metadata_size(), buffer->get_length_frame_only()), buf_mgr.metadata_size(),
+                        buffer->get_frame_start(), buf_mgr.metadata_start(), timestamp };
+
+                    buffer->attach_buffer(buf);
+                    buf_mgr.handle_buffer(e_video_buf,-1); // transfer new buffer request to the frame callback
+
+                    if (buf_mgr.verify_vd_md_sync())
+                    {
+                        //Invoke user callback and enqueue next frame
+                        _callback(_profile, fo, [buf_mgr]() mutable {
+                            buf_mgr.request_next_frame();
+                        });
+                    }
+                    else
+                    {
+                        LOG_WARNING("Video frame dropped, video and metadata buffers inconsistency");
+                    }
                 }
             }
+            else
+            {
+                LOG_INFO("Video frame arrived in idle mode."); // TODO - verification
+            }
+            return true;
         }
 
         void v4l_uvc_device::acquire_metadata(buffers_mgr & buf_mgr,fd_set &, bool compressed_format)
@@ -38,6 +38,8 @@
 #include <linux/videodev2.h>
 #include <regex>
 #include <list>
+#include <map>
+#include <mutex>
 
 // Metadata streaming nodes are available with kernels 4.16+
 #ifdef V4L2_META_FMT_UVC
@@ -215,6 +217,50 @@ namespace librealsense
             std::array<kernel_buf_guard, e_max_kernel_buf_type> buffers;
         };
 
+        // Multiplexes the capture of all the streaming V4L2 devices on a few threads, instead of a capture thread per device.
+        // The devices are watched with a single edge-triggered epoll set, each device node is armed for one event at a time,
+        // so its handler never runs on two threads at once and drains all the ready buffers before the node is re-armed.
+        // Enabled only by setting the RS2_V4L2_REACTOR_THREADS environment variable to the number of capture threads, it is
+        // read when a device starts streaming and there is no API option for it.
+        class v4l_capture_reactor
+        {
+        public:
+            // the reactor shared by the streaming devices, nullptr when the reactor is not enabled
+            static std::shared_ptr<v4l_capture_reactor> get_instance();
+
+            explicit v4l_capture_reactor(size_t threads);
+            ~v4l_capture_reactor();
+
+            // on_timeout is called when the fd is not ready for frames_timeout
+            uint64_t add(int fd, std::function<void()> on_ready, std::function<void()> on_timeout);
+            // once it returns the handlers of the fd are not running and will not be called again
+            void remove(uint64_t id);
+
+        private:
+            struct registration
+            {
+                int fd;
+                std::function<void()> on_ready;
+                std::function<void()> on_timeout;
+                std::mutex mutex;
+                bool active;
+                std::chrono::steady_clock::time_point last_event;
+            };
+
+            void run();
+            void check_timeouts();
+            std::shared_ptr<registration> find(uint64_t id);
+
+            int _epoll_fd;
+            int _stop_fd;
+            std::atomic<bool> _is_running;
+            std::vector<std::thread> _threads;
+            std::mutex _mutex;
+            std::map<uint64_t, std::shared_ptr<registration>> _registrations;
+            uint64_t _next_id;
+            std::mutex _timeouts_mutex;
+        };
+
         class v4l_uvc_interface
         {
             virtual void capture_loop() = 0;
@@ -261,6 +307,9 @@ namespace librealsense
 
             void poll();
 
+            // dequeues a frame that the video node has ready, returns false when there is none
+            bool acquire_frame(fd_set& fds);
+
             void set_power_state(power_state state) override;
             power_state get_power_state() const override { return _state; }
 
@@ -283,6 +332,19 @@ namespace librealsense
             std::string get_device_location() const override { return _device_path; }
             usb_spec get_usb_specification() const override { return _device_usb_spec; }
 
+            void set_newest_frame_only(bool newest_only) override { _newest_frame_only = newest_only; }
+            uint64_t get_dropped_frames_count() const override { return _dropped_frames; }
+
+            struct wakeup_latency_statistic
+            {
+                uint64_t frames = 0;
+                double average_ms = 0;
+                double max_ms = 0;
+            };
+            // delay from the kernel timestamp of the video buffers to their dequeue by the capture thread or the reactor,
+            // since the device started streaming
+            wakeup_latency_statistic get_wakeup_latency() const;
+
         protected:
             static uint32_t get_cid(rs2_option option);
 
@@ -302,6 +364,12 @@ namespace librealsense
             virtual void stop_data_capture() override;
             virtual void acquire_metadata(buffers_mgr & buf_mgr,fd_set &fds, bool compressed_format = false) override;
 
+            void on_frames_ready();
+            void notify_frames_timeout();
+            void record_wakeup_latency(const v4l2_buffer& buf);
+            void record_dropped_frames(const v4l2_buffer& buf);
+            bool is_frame_pending() const;
+
             power_state _state = D3;
             std::string _name = "";
             std::string _device_path = "";
@@ -319,6 +387,18 @@ namespace librealsense
             bool _use_memory_map;
             int _max_fd = 0;                    // specifies the maximal pipe number the polling process will monitor
             std::vector<int>  _fds;             // list the file descriptors to be monitored during frames polling
+            std::shared_ptr<v4l_capture_reactor> _reactor; // captures the frames instead of _thread when enabled
+            uint64_t _reactor_id = 0;
+            // delay from the kernel timestamp of the video buffers to their dequeue
+            mutable std::mutex _wakeup_latency_mutex;
+            uint64_t _wakeup_count = 0;
+            double _wakeup_latency_total = 0;
+            double _wakeup_latency_max = 0;
+            std::atomic<bool> _newest_frame_only;
+            // frames the driver had no buffer for, and stale frames released unread
+            std::atomic<uint64_t> _dropped_frames;
+            uint32_t _last_sequence = 0;
+            bool _has_sequence = false;
 
         private:
             int _fd = 0;          // prevent unintentional abuse in derived class
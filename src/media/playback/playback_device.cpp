@@ -341,6 +341,15 @@ void playback_device::set_real_time(bool real_time)
 {
     LOG_INFO("Set real time to " << ((real_time) ? "True" : "False"));
     m_real_time = real_time;
+    for (auto&& sensor : m_sensors)
+    {
+        sensor.second->set_real_time(real_time);
+    }
+    //The reader is only accessed from the reading thread
+    (*m_read_thread)->invoke([this, real_time](dispatcher::cancellable_timer t)
+    {
+        m_reader->set_blocking(!real_time);
+    });
 }
 
 bool playback_device::is_real_time() const
@@ -30,7 +30,9 @@ playback_sensor::playback_sensor(device_interface& parent_device, const device_s
     m_sensor_description(sensor_description),
     m_sensor_id(sensor_description.get_sensor_index()),
     m_parent_device(parent_device),
-    _default_queue_size(1)
+    _default_queue_size(1),
+    _non_real_time_queue_size(16),
+    m_real_time(true)
 {
     register_sensor_streams(m_sensor_description.get_stream_profiles());
     register_sensor_infos(m_sensor_description);
@@ -82,13 +84,16 @@ void playback_sensor::open(const stream_profiles& requests)
         }
     }
     std::vector<device_serializer::stream_identifier> opened_streams;
-    //For each stream, create a dedicated dispatching thread
-    for (auto&& profile : requests)
     {
-        m_dispatchers.emplace(std::make_pair(profile->get_unique_id(), std::make_shared<dispatcher>(_default_queue_size)));
-        m_dispatchers[profile->get_unique_id()]->start();
-        device_serializer::stream_identifier f{ get_device_index(), m_sensor_id, profile->get_stream_type(), static_cast<uint32_t>(profile->get_stream_index()) };
-        opened_streams.push_back(f);
+        std::lock_guard<std::mutex> l(m_mutex);
+        //For each stream, create a dedicated dispatching thread
+        for (auto&& profile : requests)
+        {
+            m_dispatchers.emplace(std::make_pair(profile->get_unique_id(), std::make_shared<dispatcher>(get_queue_size())));
+            m_dispatchers[profile->get_unique_id()]->start();
+            device_serializer::stream_identifier f{ get_device_index(), m_sensor_id, profile->get_stream_type(), static_cast<uint32_t>(profile->get_stream_index()) };
+            opened_streams.push_back(f);
+        }
     }
     set_active_streams(requests);
     opened(opened_streams);
@@ -98,18 +103,21 @@ void playback_sensor::close()
 {
     LOG_DEBUG("Close sensor " << m_sensor_id);
     std::vector<device_serializer::stream_identifier> closed_streams;
-    for (auto&& dispatcher : m_dispatchers)
     {
-        dispatcher.second->flush();
-        for (auto available_profile : m_available_profiles)
+        std::lock_guard<std::mutex> l(m_mutex);
+        for (auto&& dispatcher : m_dispatchers)
         {
-            if (available_profile->get_unique_id() == dispatcher.first)
+            dispatcher.second->flush();
+            for (auto available_profile : m_available_profiles)
             {
-                closed_streams.push_back({ get_device_index(), m_sensor_id, available_profile->get_stream_type(), static_cast<uint32_t>(available_profile->get_stream_index()) });
+                if (available_profile->get_unique_id() == dispatcher.first)
+                {
+                    closed_streams.push_back({ get_device_index(), m_sensor_id, available_profile->get_stream_type(), static_cast<uint32_t>(available_profile->get_stream_index()) });
+                }
             }
         }
+        m_dispatchers.clear();
     }
-    m_dispatchers.clear();
     set_active_streams({});
     closed(closed_streams);
 }
@@ -178,6 +186,24 @@ void playback_sensor::update_option(rs2_option id, std::shared_ptr<option> optio
     register_option(id, option);
 }
 
+void playback_sensor::set_real_time(bool real_time)
+{
+    //In non real time mode frames are enqueued with blocking, so a deeper queue lets each stream
+    //read ahead without dropping frames, and a slow consumer of one stream does not stall the others
+    //until its own queue is full
+    std::lock_guard<std::mutex> l(m_mutex);
+    m_real_time = real_time;
+    for (auto&& dispatcher : m_dispatchers)
+    {
+        dispatcher.second->set_capacity(get_queue_size());
+    }
+}
+
+unsigned int playback_sensor::get_queue_size() const
+{
+    return m_real_time ? _default_queue_size : _non_real_time_queue_size;
+}
+
 void playback_sensor::flush_pending_frames()
 {
     for (auto&& dispatcher : m_dispatchers)
@@ -50,6 +50,7 @@ namespace librealsense
         void unregister_before_start_callback(int token) override;
         void raise_notification(const notification& n);
         bool streams_contains_one_frame_or_more();
+        void set_real_time(bool real_time);
         virtual processing_blocks get_recommended_processing_blocks() const override
         {
             auto processing_blocks_snapshot = m_sensor_description.get_sensor_extensions_snapshots().find(RS2_EXTENSION_RECOMMENDED_FILTERS);
@@ -71,7 +72,7 @@ namespace librealsense
         void register_sensor_streams(const stream_profiles& vector);
         void register_sensor_infos(const device_serializer::sensor_snapshot& sensor_snapshot);
         void register_sensor_options(const device_serializer::sensor_snapshot& sensor_snapshot);
-        
+        unsigned int get_queue_size() const;
 
 
         frame_callback_ptr m_user_callback;
@@ -88,6 +89,8 @@ namespace librealsense
         stream_profiles m_active_streams;
         mutable std::mutex m_active_profile_mutex;
         const unsigned int _default_queue_size;
+        const unsigned int _non_real_time_queue_size;
+        std::atomic<bool> m_real_time;
 
     public:
         //handle frame use 3 lambda functions that determines if and when a frame should be published.
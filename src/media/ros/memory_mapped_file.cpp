@@ -0,0 +1,80 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "memory_mapped_file.h"
+#include "types.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace librealsense
+{
+#ifdef _WIN32
+    memory_mapped_file::memory_mapped_file(const std::string& file_path)
+        : _data(nullptr), _size(0), _file(INVALID_HANDLE_VALUE), _mapping(nullptr)
+    {
+        _file = CreateFileA(file_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (_file == INVALID_HANDLE_VALUE)
+            throw io_exception(to_string() << "Failed to open " << file_path << " for mapping");
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(_file, &size) || size.QuadPart == 0 ||
+            !(_mapping = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr)))
+        {
+            CloseHandle(_file);
+            throw io_exception(to_string() << "Failed to map " << file_path);
+        }
+
+        _data = static_cast<const uint8_t*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!_data)
+        {
+            CloseHandle(_mapping);
+            CloseHandle(_file);
+            throw io_exception(to_string() << "Failed to map a view of " << file_path);
+        }
+        _size = static_cast<uint64_t>(size.QuadPart);
+    }
+
+    memory_mapped_file::~memory_mapped_file()
+    {
+        UnmapViewOfFile(_data);
+        CloseHandle(_mapping);
+        CloseHandle(_file);
+    }
+#else
+    memory_mapped_file::memory_mapped_file(const std::string& file_path)
+        : _data(nullptr), _size(0)
+    {
+        auto fd = open(file_path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw io_exception(to_string() << "Failed to open " << file_path << " for mapping");
+
+        struct stat st;
+        if (fstat(fd, &st) < 0 || st.st_size == 0)
+        {
+            close(fd);
+            throw io_exception(to_string() << "Failed to query the size of " << file_path);
+        }
+
+        // The mapping stays valid after the descriptor is closed
+        auto addr = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (addr == MAP_FAILED)
+            throw io_exception(to_string() << "Failed to map " << file_path);
+
+        _data = static_cast<const uint8_t*>(addr);
+        _size = static_cast<uint64_t>(st.st_size);
+    }
+
+    memory_mapped_file::~memory_mapped_file()
+    {
+        munmap(const_cast<uint8_t*>(_data), static_cast<size_t>(_size));
+    }
+#endif
+}
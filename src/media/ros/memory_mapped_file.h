@@ -0,0 +1,32 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#pragma once
+#include <cstdint>
+#include <string>
+
+namespace librealsense
+{
+    // Read-only mapping of a whole file into the process address space.
+    // Frames that reference the mapped pages hold a shared_ptr to the mapping to keep it alive.
+    class memory_mapped_file
+    {
+    public:
+        explicit memory_mapped_file(const std::string& file_path);
+        ~memory_mapped_file();
+
+        memory_mapped_file(const memory_mapped_file&) = delete;
+        memory_mapped_file& operator=(const memory_mapped_file&) = delete;
+
+        const uint8_t* data() const { return _data; }
+        uint64_t size() const { return _size; }
+
+    private:
+        const uint8_t* _data;
+        uint64_t _size;
+#ifdef _WIN32
+        void* _file;
+        void* _mapping;
+#endif
+    };
+}
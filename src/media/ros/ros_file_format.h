@@ -10,6 +10,7 @@
 #include "sensor_msgs/Image.h"
 #include "diagnostic_msgs/KeyValue.h"
 #include "std_msgs/UInt32.h"
+#include "std_msgs/UInt64.h"
 #include "std_msgs/Float32.h"
 #include "std_msgs/Float32MultiArray.h"
 #include "std_msgs/String.h"
@@ -243,6 +244,10 @@ namespace librealsense
         {
             return create_from({ "file_version" });
         }
+        static std::string segment_start_topic()
+        {
+            return create_from({ "segment_start" });
+        }
         static std::string device_info_topic(uint32_t device_id)
         {
             return create_from({ device_prefix(device_id),  "info" });
@@ -560,6 +565,23 @@ namespace librealsense
         return rs2rosinternal::Time(secs.count());
     }
 
+    /**
+    * Name of the n-th file of a recording that was split into several files.
+    * The first file keeps the requested name, the following ones get an index suffix (e.g. "rec.bag", "rec_1.bag", "rec_2.bag")
+    */
+    inline std::string get_segment_file_name(const std::string& file, uint32_t segment_index)
+    {
+        if (segment_index == 0)
+            return file;
+
+        auto extension_pos = file.find_last_of('.');
+        auto separator_pos = file.find_last_of("/\\");
+        if (extension_pos == std::string::npos || (separator_pos != std::string::npos && extension_pos < separator_pos))
+            return to_string() << file << "_" << segment_index;
+
+        return to_string() << file.substr(0, extension_pos) << "_" << segment_index << file.substr(extension_pos);
+    }
+
     namespace legacy_file_format
     {
         constexpr const char* USB_DESCRIPTOR = "{ 0x94b5fb99, 0x79f2, 0x4d66,{ 0x85, 0x06, 0xb1, 0x5e, 0x8b, 0x8c, 0x9d, 0xa1 } }";
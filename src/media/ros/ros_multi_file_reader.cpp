@@ -0,0 +1,461 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include <cctype>
+#include <fstream>
+#include "ros_multi_file_reader.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dirent.h>
+#endif
+
+namespace librealsense
+{
+    using namespace device_serializer;
+
+    static std::vector<std::string> list_directory(const std::string& directory)
+    {
+        std::vector<std::string> names;
+#ifdef _WIN32
+        WIN32_FIND_DATAA entry;
+        auto handle = FindFirstFileA((directory + "\\*").c_str(), &entry);
+        if (handle == INVALID_HANDLE_VALUE)
+            throw io_exception(to_string() << "Failed to list directory \"" << directory << "\"");
+        do
+        {
+            if (!(entry.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+                names.push_back(entry.cFileName);
+        } while (FindNextFileA(handle, &entry));
+        FindClose(handle);
+#else
+        auto dir = opendir(directory.c_str());
+        if (!dir)
+            throw io_exception(to_string() << "Failed to list directory \"" << directory << "\"");
+        while (auto entry = readdir(dir))
+        {
+            std::string name(entry->d_name);
+            if (name != "." && name != "..")
+                names.push_back(name);
+        }
+        closedir(dir);
+#endif
+        return names;
+    }
+
+    bool ros_multi_file_reader::wildcard_match(const std::string& pattern, const std::string& name)
+    {
+        size_t p = 0, n = 0;
+        size_t star = std::string::npos, star_match = 0;
+        while (n < name.size())
+        {
+            if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n]))
+            {
+                ++p;
+                ++n;
+            }
+            else if (p < pattern.size() && pattern[p] == '*')
+            {
+                star = p++;
+                star_match = n;
+            }
+            else if (star != std::string::npos)
+            {
+                //Let the last '*' consume one more character and retry
+                p = star + 1;
+                n = ++star_match;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        while (p < pattern.size() && pattern[p] == '*')
+            ++p;
+        return p == pattern.size();
+    }
+
+    bool ros_multi_file_reader::natural_less(const std::string& a, const std::string& b)
+    {
+        size_t i = 0, j = 0;
+        while (i < a.size() && j < b.size())
+        {
+            if (isdigit(static_cast<unsigned char>(a[i])) && isdigit(static_cast<unsigned char>(b[j])))
+            {
+                auto a_start = a.find_first_not_of('0', i);
+                auto b_start = b.find_first_not_of('0', j);
+                auto a_end = a.find_first_not_of("0123456789", i);
+                auto b_end = b.find_first_not_of("0123456789", j);
+                a_end = a_end == std::string::npos ? a.size() : a_end;
+                b_end = b_end == std::string::npos ? b.size() : b_end;
+                a_start = std::min(a_start, a_end);
+                b_start = std::min(b_start, b_end);
+                auto a_digits = a.substr(a_start, a_end - a_start);
+                auto b_digits = b.substr(b_start, b_end - b_start);
+                if (a_digits.size() != b_digits.size())
+                    return a_digits.size() < b_digits.size();
+                if (a_digits != b_digits)
+                    return a_digits < b_digits;
+                i = a_end;
+                j = b_end;
+            }
+            else
+            {
+                if (a[i] != b[j])
+                    return a[i] < b[j];
+                ++i;
+                ++j;
+            }
+        }
+        return (a.size() - i) < (b.size() - j);
+    }
+
+    static bool is_absolute_path(const std::string& path)
+    {
+        return (!path.empty() && (path[0] == '/' || path[0] == '\\')) || (path.size() > 1 && path[1] == ':');
+    }
+
+    std::vector<std::string> ros_multi_file_reader::list_files(const std::string& path)
+    {
+        auto separator_pos = path.find_last_of("/\\");
+        auto directory = separator_pos == std::string::npos ? std::string() : path.substr(0, separator_pos + 1);
+        auto name = path.substr(directory.size());
+
+        if (name.find_first_of("*?") != std::string::npos)
+        {
+            std::vector<std::string> files;
+            for (auto&& entry : list_directory(directory.empty() ? "." : directory))
+            {
+                if (wildcard_match(name, entry))
+                    files.push_back(directory + entry);
+            }
+            if (files.empty())
+                throw invalid_value_exception(to_string() << "No files match \"" << path << "\"");
+            std::sort(files.begin(), files.end(), natural_less);
+            return files;
+        }
+
+        //Anything that is not a bag file is expected to be a text file that lists the files of the recording
+        std::ifstream manifest(path);
+        std::string line;
+        if (!std::getline(manifest, line) || line.compare(0, 7, "#ROSBAG") == 0)
+            return { path };
+
+        std::vector<std::string> files;
+        do
+        {
+            auto begin = line.find_first_not_of(" \t\r");
+            auto end = line.find_last_not_of(" \t\r");
+            if (begin == std::string::npos || line[begin] == '#')
+                continue;
+            auto file = line.substr(begin, end - begin + 1);
+            files.push_back(is_absolute_path(file) ? file : directory + file);
+        } while (std::getline(manifest, line));
+
+        if (files.empty())
+            throw invalid_value_exception(to_string() << "\"" << path << "\" is neither a bag file nor a list of bag files");
+        return files;
+    }
+
+    ros_multi_file_reader::ros_multi_file_reader(const std::string& name, const std::vector<std::string>& files, const std::shared_ptr<context>& ctx) :
+        m_name(name),
+        m_files(files),
+        m_loaded_duration(0),
+        m_recorded_duration(0),
+        m_context(ctx),
+        m_current_index(0),
+        m_next_index(0),
+        m_blocking(false)
+    {
+        if (m_files.empty())
+        {
+            throw invalid_value_exception("No files to play");
+        }
+
+        //The first file holds the device description, the other files are opened once the playback reaches them
+        load_time_ranges(1);
+        m_first_segment = std::make_shared<ros_reader>(m_files.front(), ctx);
+        m_current_segment = m_first_segment;
+        LOG_INFO("Playing " << m_files.size() << " files as a single recording");
+    }
+
+    ros_multi_file_reader::~ros_multi_file_reader()
+    {
+        //The file being opened in the background holds the context, so it is not left running past the reader
+        if (m_next_segment.valid())
+            m_next_segment.wait();
+    }
+
+    device_snapshot ros_multi_file_reader::query_device_description(const nanoseconds& time)
+    {
+        if (time == get_static_file_info_timestamp())
+            return m_first_segment->query_device_description(time);
+
+        return m_current_segment->query_device_description(to_segment_time(time));
+    }
+
+    std::shared_ptr<serialized_data> ros_multi_file_reader::read_next_data()
+    {
+        while (true)
+        {
+            prefetch_segment(m_current_index + 1);
+            auto data = m_current_segment->read_next_data();
+            if (!data->is<serialized_end_of_file>() || m_enabled_streams.empty() || m_current_index + 1 >= m_files.size())
+            {
+                return to_recording_time(data, m_current_index);
+            }
+            LOG_DEBUG("End of " << m_files[m_current_index] << ", continuing to " << m_files[m_current_index + 1]);
+            switch_to_segment(m_current_index + 1);
+        }
+    }
+
+    void ros_multi_file_reader::seek_to_time(const nanoseconds& seek_time)
+    {
+        auto index = find_segment(seek_time);
+        if (index != m_current_index)
+        {
+            switch_to_segment(index);
+        }
+        m_current_segment->seek_to_file_time(to_segment_time(seek_time));
+    }
+
+    std::vector<std::shared_ptr<serialized_data>> ros_multi_file_reader::fetch_last_frames(const nanoseconds& seek_time)
+    {
+        auto frames = m_current_segment->fetch_last_frames(to_segment_time(seek_time));
+        for (auto&& frame : frames)
+        {
+            frame = to_recording_time(frame, m_current_index);
+        }
+
+        //A stream with no frame up to the requested time in the current file shows the last frame it has in an earlier file
+        std::vector<device_serializer::stream_identifier> missing_streams;
+        for (auto&& stream_id : m_enabled_streams)
+        {
+            if (std::none_of(frames.begin(), frames.end(), [&](const std::shared_ptr<serialized_data>& f) { return f->as<serialized_frame>()->stream_id == stream_id; }))
+                missing_streams.push_back(stream_id);
+        }
+        for (size_t index = m_current_index; index-- > 0 && !missing_streams.empty();)
+        {
+            auto segment = m_first_segment;
+            if (index != 0)
+            {
+                segment = std::make_shared<ros_reader>(m_files[index], m_context);
+                segment->enable_stream(missing_streams);
+            }
+            for (auto&& frame : segment->fetch_last_frames(segment_end_time(index)))
+            {
+                auto stream_it = std::find(missing_streams.begin(), missing_streams.end(), frame->as<serialized_frame>()->stream_id);
+                if (stream_it == missing_streams.end())
+                    continue;
+                missing_streams.erase(stream_it);
+                frames.push_back(to_recording_time(frame, index));
+            }
+        }
+        return frames;
+    }
+
+    nanoseconds ros_multi_file_reader::query_duration() const
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_time_ranges_mutex);
+            if (m_offsets.size() == m_files.size())
+                return m_loaded_duration;
+            if (m_recorded_duration > nanoseconds::zero())
+                return m_recorded_duration;
+
+            //The last file of a split recording knows where it starts, so the other files need not be opened
+            auto last_range = ros_reader::query_file_time_range(m_files.back());
+            if (last_range.continues_recording)
+            {
+                m_recorded_duration = last_range.segment_start + last_range.end - m_begin_times.front();
+                return m_recorded_duration;
+            }
+        }
+        load_time_ranges(m_files.size());
+        std::lock_guard<std::mutex> lock(m_time_ranges_mutex);
+        return m_loaded_duration;
+    }
+
+    void ros_multi_file_reader::reset()
+    {
+        if (m_current_index != 0)
+        {
+            m_previous_segment = m_current_segment;
+            m_current_segment = m_first_segment;
+            m_current_index = 0;
+        }
+        m_first_segment->reset();
+    }
+
+    void ros_multi_file_reader::enable_stream(const std::vector<device_serializer::stream_identifier>& stream_ids)
+    {
+        for (auto&& stream_id : stream_ids)
+        {
+            if (std::find(m_enabled_streams.begin(), m_enabled_streams.end(), stream_id) == m_enabled_streams.end())
+                m_enabled_streams.push_back(stream_id);
+        }
+        m_current_segment->enable_stream(stream_ids);
+        //The first file is kept in sync since reset() goes back to it
+        if (m_current_segment != m_first_segment)
+            m_first_segment->enable_stream(stream_ids);
+    }
+
+    void ros_multi_file_reader::disable_stream(const std::vector<device_serializer::stream_identifier>& stream_ids)
+    {
+        for (auto&& stream_id : stream_ids)
+        {
+            m_enabled_streams.erase(std::remove(m_enabled_streams.begin(), m_enabled_streams.end(), stream_id), m_enabled_streams.end());
+        }
+        m_current_segment->disable_stream(stream_ids);
+        if (m_current_segment != m_first_segment)
+            m_first_segment->disable_stream(stream_ids);
+    }
+
+    const std::string& ros_multi_file_reader::get_file_name() const
+    {
+        return m_name;
+    }
+
+    void ros_multi_file_reader::set_blocking(bool blocking)
+    {
+        m_blocking = blocking;
+        m_current_segment->set_blocking(blocking);
+        if (m_current_segment != m_first_segment)
+            m_first_segment->set_blocking(blocking);
+    }
+
+    void ros_multi_file_reader::switch_to_segment(size_t index)
+    {
+        load_time_ranges(index + 1);
+        //Frames of the file that was played may still be waiting in the sensors queues, so it is kept alive until the next switch
+        m_previous_segment = m_current_segment;
+        if (index == 0)
+        {
+            m_current_segment = m_first_segment;
+        }
+        else
+        {
+            m_current_segment = open_segment(index);
+            m_current_segment->set_blocking(m_blocking);
+            if (!m_enabled_streams.empty())
+                m_current_segment->enable_stream(m_enabled_streams);
+        }
+        m_current_index = index;
+    }
+
+    std::shared_ptr<ros_reader> ros_multi_file_reader::open_segment(size_t index)
+    {
+        if (m_next_segment.valid() && m_next_index == index)
+        {
+            return m_next_segment.get();
+        }
+        return std::make_shared<ros_reader>(m_files[index], m_context);
+    }
+
+    void ros_multi_file_reader::prefetch_segment(size_t index)
+    {
+        if (index >= m_files.size() || (m_next_segment.valid() && m_next_index == index))
+            return;
+        //Replacing a future of std::async waits for it, so a file still being opened is left to finish and is not used
+        if (m_next_segment.valid() && m_next_segment.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            return;
+
+        auto file = m_files[index];
+        auto ctx = m_context;
+        m_next_index = index;
+        m_next_segment = std::async(std::launch::async, [file, ctx]()
+        {
+            return std::make_shared<ros_reader>(file, ctx);
+        });
+    }
+
+    void ros_multi_file_reader::load_time_ranges(size_t count) const
+    {
+        std::lock_guard<std::mutex> lock(m_time_ranges_mutex);
+        while (m_offsets.size() < std::min(count, m_files.size()))
+            load_next_time_range();
+    }
+
+    void ros_multi_file_reader::load_next_time_range() const
+    {
+        //Only the frames time range is read here. A recording time t in file i is the time t - offset[i] + begin[i] of that file
+        auto index = m_offsets.size();
+        auto range = ros_reader::query_file_time_range(m_files[index]);
+        //The first frame of a file follows the last frame of the previous file, and never shares its timestamp
+        const nanoseconds min_gap = std::chrono::microseconds(1);
+        auto offset = nanoseconds::zero();
+        if (index > 0)
+        {
+            offset = m_loaded_duration + min_gap;
+            //Files the writer split keep the time between the frames on both sides of the split
+            if (range.continues_recording)
+                offset = std::max(offset, range.segment_start + range.begin - m_begin_times.front());
+        }
+        m_offsets.push_back(offset);
+        m_begin_times.push_back(range.begin);
+        m_loaded_duration = offset + range.end - range.begin;
+    }
+
+    size_t ros_multi_file_reader::find_segment(const nanoseconds& time) const
+    {
+        std::lock_guard<std::mutex> lock(m_time_ranges_mutex);
+        while (m_loaded_duration < time && m_offsets.size() < m_files.size())
+            load_next_time_range();
+        if (time > m_loaded_duration)
+        {
+            throw invalid_value_exception(to_string() << "Requested time is out of playback length. (Requested = " << time.count() << ", Duration = " << m_loaded_duration.count() << ")");
+        }
+        //A time between two files belongs to the end of the earlier one, and the playback continues to the next file from there
+        auto it = std::upper_bound(std::next(m_offsets.begin()), m_offsets.end(), time);
+        return std::distance(m_offsets.begin(), it) - 1;
+    }
+
+    nanoseconds ros_multi_file_reader::segment_end_time(size_t index) const
+    {
+        std::lock_guard<std::mutex> lock(m_time_ranges_mutex);
+        auto end = index + 1 < m_offsets.size() ? m_offsets[index + 1] : m_loaded_duration;
+        return end - m_offsets[index] + m_begin_times[index];
+    }
+
+    nanoseconds ros_multi_file_reader::to_segment_time(const nanoseconds& time) const
+    {
+        std::lock_guard<std::mutex> lock(m_time_ranges_mutex);
+        return std::max(time - m_offsets[m_current_index] + m_begin_times[m_current_index], nanoseconds::zero());
+    }
+
+    std::shared_ptr<serialized_data> ros_multi_file_reader::to_recording_time(std::shared_ptr<serialized_data> data, size_t index) const
+    {
+        nanoseconds offset, shift;
+        {
+            std::lock_guard<std::mutex> lock(m_time_ranges_mutex);
+            offset = m_offsets[index];
+            shift = offset - m_begin_times[index];
+        }
+        auto timestamp = data->get_timestamp();
+        if (shift == nanoseconds::zero() || timestamp == get_static_file_info_timestamp())
+            return data;
+
+        //Options and notifications recorded before the first frame of the file are placed at its start
+        timestamp = std::max(timestamp + shift, offset);
+
+        if (data->is<serialized_invalid_frame>())
+        {
+            auto invalid_frame = std::static_pointer_cast<serialized_invalid_frame>(data);
+            return std::make_shared<serialized_invalid_frame>(timestamp, invalid_frame->stream_id);
+        }
+        if (auto frame = data->as<serialized_frame>())
+        {
+            return std::make_shared<serialized_frame>(timestamp, frame->stream_id, std::move(frame->frame));
+        }
+        if (auto option = data->as<serialized_option>())
+        {
+            return std::make_shared<serialized_option>(timestamp, option->sensor_id, option->option_id, option->option);
+        }
+        if (auto notification = data->as<serialized_notification>())
+        {
+            return std::make_shared<serialized_notification>(timestamp, notification->sensor_id, notification->notif);
+        }
+        return data;
+    }
+}
@@ -0,0 +1,84 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#pragma once
+#include <future>
+#include <mutex>
+#include "ros_reader.h"
+
+namespace librealsense
+{
+    using namespace device_serializer;
+
+    /**
+    * Plays a recording that is split into several files as one continuous recording.
+    * A file that the writer split from a recording is placed at the time it starts in that recording, any other file
+    * starts right after the end of the previous file. Only the first file is opened on construction, the time range of
+    * the other files is read when playback reaches them (the duration reads only the last file, unless it is not part of
+    * a split recording), and the file that follows the one being played is opened in the background so that moving
+    * between files does not stall the playback
+    */
+    class ros_multi_file_reader : public device_serializer::reader
+    {
+    public:
+        ros_multi_file_reader(const std::string& name, const std::vector<std::string>& files, const std::shared_ptr<context>& ctx);
+        ~ros_multi_file_reader();
+        device_snapshot query_device_description(const nanoseconds& time) override;
+        std::shared_ptr<serialized_data> read_next_data() override;
+        void seek_to_time(const nanoseconds& seek_time) override;
+        std::vector<std::shared_ptr<serialized_data>> fetch_last_frames(const nanoseconds& seek_time) override;
+        nanoseconds query_duration() const override;
+        void reset() override;
+        void enable_stream(const std::vector<device_serializer::stream_identifier>& stream_ids) override;
+        void disable_stream(const std::vector<device_serializer::stream_identifier>& stream_ids) override;
+        const std::string& get_file_name() const override;
+        void set_blocking(bool blocking) override;
+
+        /**
+        * Lists the files of a recording given either a single file, a pattern with '*' and '?' wildcards in the file name
+        * (e.g. "/data/session_*.bag", sorted with numbers compared by value) or a text file that lists one file per line
+        */
+        static std::vector<std::string> list_files(const std::string& path);
+
+        /**
+        * Matches a file name against a pattern where '*' stands for any sequence of characters and '?' for any one character
+        */
+        static bool wildcard_match(const std::string& pattern, const std::string& name);
+
+        /**
+        * Orders "rec_2.bag" before "rec_10.bag" by comparing runs of digits by their value
+        */
+        static bool natural_less(const std::string& a, const std::string& b);
+
+    private:
+        void switch_to_segment(size_t index);
+        std::shared_ptr<ros_reader> open_segment(size_t index);
+        void prefetch_segment(size_t index);
+        void load_time_ranges(size_t count) const;
+        void load_next_time_range() const;
+        size_t find_segment(const nanoseconds& time) const;
+        nanoseconds segment_end_time(size_t index) const;
+        nanoseconds to_segment_time(const nanoseconds& time) const;
+        std::shared_ptr<serialized_data> to_recording_time(std::shared_ptr<serialized_data> data, size_t index) const;
+
+        std::string m_name;
+        std::vector<std::string> m_files;
+        //Time ranges are read on demand and only ever appended, in files order
+        mutable std::mutex m_time_ranges_mutex;
+        mutable std::vector<nanoseconds> m_offsets;
+        mutable std::vector<nanoseconds> m_begin_times;
+        mutable nanoseconds m_loaded_duration;
+        mutable nanoseconds m_recorded_duration;
+        std::shared_ptr<context> m_context;
+
+        std::shared_ptr<ros_reader> m_first_segment;
+        std::shared_ptr<ros_reader> m_current_segment;
+        std::shared_ptr<ros_reader> m_previous_segment;
+        size_t m_current_index;
+        std::future<std::shared_ptr<ros_reader>> m_next_segment;
+        size_t m_next_index;
+
+        std::vector<device_serializer::stream_identifier> m_enabled_streams;
+        bool m_blocking;
+    };
+}
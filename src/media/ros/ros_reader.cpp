@@ -25,12 +25,14 @@ namespace librealsense
         m_total_duration(0),
         m_file_path(file),
         m_context(ctx),
-        m_version(0)
+        m_version(0),
+        m_blocking(false)
     {
         try
         {
             reset(); //Note: calling a virtual function inside c'tor, safe while base function is pure virtual
-            m_total_duration = get_file_duration(m_file, m_version);
+            auto frames_time_range = get_frames_time_range(m_file, m_version);
+            m_total_duration = frames_time_range.second - frames_time_range.first;
         }
         catch (const std::exception& e)
         {
@@ -96,9 +98,16 @@ namespace librealsense
         {
             throw invalid_value_exception(to_string() << "Requested time is out of playback length. (Requested = " << seek_time.count() << ", Duration = " << m_total_duration.count() << ")");
         }
+        seek_to_file_time(seek_time);
+    }
+
+    void ros_reader::seek_to_file_time(const nanoseconds& seek_time)
+    {
         auto seek_time_as_secs = std::chrono::duration_cast<std::chrono::duration<double>>(seek_time);
         auto seek_time_as_rostime = rs2rosinternal::Time(seek_time_as_secs.count());
 
+        //The frames time index is not used here: the view has to merge every enabled topic, including options and
+        //notifications that are not indexed, and View::addQuery already finds the start of each topic by a binary search over the bag index
         m_samples_view.reset(new rosbag::View(m_file, FalseQuery()));
 
         //Using cached topics here and not querying them (before reseting) since a previous call to seek
@@ -114,33 +123,59 @@ namespace librealsense
     std::vector<std::shared_ptr<serialized_data>> ros_reader::fetch_last_frames(const nanoseconds& seek_time)
     {
         std::vector<std::shared_ptr<serialized_data>> result;
-        rosbag::View view(m_file, FalseQuery());
         auto as_rostime = to_rostime(seek_time);
         auto start_time = to_rostime(get_static_file_info_timestamp());
 
-        for (auto topic : m_enabled_streams_topics)
-        {
-            view.addQuery(m_file, rosbag::TopicQuery(topic), start_time, as_rostime);
-        }
-        std::map<device_serializer::stream_identifier, rs2rosinternal::Time> last_frames;
-        for (auto&& m : view)
+        std::map<device_serializer::stream_identifier, std::shared_ptr<serialized_frame>> last_frames;
+        for (auto&& topic : m_enabled_streams_topics)
         {
-            if (m.isType<sensor_msgs::Image>() || m.isType<sensor_msgs::Imu>())
-            {
-                auto id = ros_topic::get_stream_identifier(m.getTopic());
-                last_frames[id] = m.getTime();
-            }
+            auto&& times = get_frames_time_index(topic);
+            //Find the last frame of the topic within [start_time, seek_time] without iterating over the preceding messages
+            auto it = std::upper_bound(times.begin(), times.end(), as_rostime);
+            if (it == times.begin() || *std::prev(it) < start_time)
+                continue;
+
+            auto frame_time = *std::prev(it);
+            rosbag::View view(m_file, rosbag::TopicQuery(topic), frame_time, frame_time);
+            if (view.begin() == view.end())
+                continue;
+            auto new_frame = create_frame(*view.begin());
+            last_frames[new_frame->stream_id] = new_frame;
         }
         for (auto&& kvp : last_frames)
         {
-            auto topic = ros_topic::frame_data_topic(kvp.first);
-            rosbag::View view(m_file, rosbag::TopicQuery(topic), kvp.second, kvp.second);
-            auto msg = view.begin();
-            auto new_frame = create_frame(*msg);
-            result.push_back(new_frame);
+            result.push_back(kvp.second);
         }
         return result;
     }
+
+    const std::vector<rs2rosinternal::Time>& ros_reader::get_frames_time_index(const std::string& topic)
+    {
+        auto it = m_frames_time_index.find(topic);
+        if (it != m_frames_time_index.end())
+        {
+            return it->second;
+        }
+
+        //Index entries are kept in memory by the bag, so collecting the timestamps does not read any message data.
+        //Topics that do not hold image or imu frames get an empty index so they are skipped on later lookups
+        std::vector<rs2rosinternal::Time> times;
+        rosbag::View view(m_file, rosbag::TopicQuery(topic));
+        if (view.begin() != view.end())
+        {
+            auto first = *view.begin();
+            if (first.isType<sensor_msgs::Image>() || first.isType<sensor_msgs::Imu>())
+            {
+                for (auto&& m : view)
+                {
+                    times.push_back(m.getTime());
+                }
+            }
+        }
+        LOG_DEBUG("Indexed " << times.size() << " frames of topic " << topic);
+        return m_frames_time_index.emplace(topic, std::move(times)).first->second;
+    }
+
     nanoseconds ros_reader::query_duration() const
     {
         return m_total_duration;
@@ -150,10 +185,22 @@ namespace librealsense
     {
         m_file.close();
         m_file.open(m_file_path, rosbag::BagMode::Read);
+        if (!m_mapped_file)
+        {
+            try
+            {
+                m_mapped_file = std::make_shared<memory_mapped_file>(m_file_path);
+            }
+            catch (const std::exception& e)
+            {
+                LOG_WARNING("Uncompressed frames will be copied from the file: " << e.what());
+            }
+        }
         m_version = read_file_version(m_file);
         m_samples_view = nullptr;
-        m_frame_source = std::make_shared<frame_source>(m_version == 1 ? 128 : 32);
+        m_frame_source = std::make_shared<frame_source>(get_frames_pool_size());
         m_frame_source->init(m_metadata_parser_map);
+        set_blocking(m_blocking);
         m_initial_device_description = read_device_description(get_static_file_info_timestamp(), true);
     }
 
@@ -241,6 +288,19 @@ namespace librealsense
         return m_file_path;
     }
 
+    void ros_reader::set_blocking(bool blocking)
+    {
+        //A blocking reader must never drop a frame because the frames pool is exhausted,
+        //so the pool is left unbounded and the blocking playback dispatchers apply the back pressure
+        m_blocking = blocking;
+        m_frame_source->set_max_publish_list_size(blocking ? 0 : get_frames_pool_size());
+    }
+
+    uint32_t ros_reader::get_frames_pool_size() const
+    {
+        return m_version == 1 ? 128 : 32;
+    }
+
     std::shared_ptr<serialized_frame> ros_reader::create_frame(const rosbag::MessageInstance& msg)
     {
         auto next_msg_topic = msg.getTopic();
@@ -283,7 +343,31 @@ namespace librealsense
         return std::make_shared<serialized_frame>(timestamp, stream_id, std::move(frame));
     }
 
-    nanoseconds ros_reader::get_file_duration(const rosbag::Bag& file, uint32_t version)
+    ros_reader::file_time_range ros_reader::query_file_time_range(const std::string& file)
+    {
+        try
+        {
+            rosbag::Bag bag;
+            bag.open(file, rosbag::BagMode::Read);
+            auto frames_time_range = get_frames_time_range(bag, read_file_version(bag));
+            file_time_range range{ frames_time_range.first, frames_time_range.second, false, nanoseconds::zero() };
+
+            rosbag::View segment_start_view(bag, rosbag::TopicQuery(ros_topic::segment_start_topic()));
+            if (segment_start_view.size() != 0)
+            {
+                auto msg = instantiate_msg<std_msgs::UInt64>(*segment_start_view.begin());
+                range.continues_recording = true;
+                range.segment_start = nanoseconds(msg->data);
+            }
+            return range;
+        }
+        catch (const std::exception& e)
+        {
+            throw io_exception(to_string() << "Failed to read frames time range of \"" << file << "\": " << e.what());
+        }
+    }
+
+    std::pair<nanoseconds, nanoseconds> ros_reader::get_frames_time_range(const rosbag::Bag& file, uint32_t version)
     {
         std::function<bool(rosbag::ConnectionInfo const* info)> query;
         if (version == legacy_file_format::file_version())
@@ -291,8 +375,11 @@ namespace librealsense
         else
             query = FrameQuery();
         rosbag::View all_frames_view(file, query);
-        auto streaming_duration = all_frames_view.getEndTime() - all_frames_view.getBeginTime();
-        return nanoseconds(streaming_duration.toNSec());
+        if (all_frames_view.size() == 0)
+        {
+            return { nanoseconds::zero(), nanoseconds::zero() };
+        }
+        return { nanoseconds(all_frames_view.getBeginTime().toNSec()), nanoseconds(all_frames_view.getEndTime().toNSec()) };
     }
 
     void ros_reader::get_legacy_frame_metadata(const rosbag::Bag& bag,
@@ -401,14 +488,99 @@ namespace librealsense
         return remaining;
     }
 
+    bool ros_reader::find_mapped_message(uint64_t record_pos, uint64_t& data_pos, uint32_t& data_size) const
+    {
+        //A record is its header length, its header fields, its data length and its data.
+        //The connection records a chunk may hold before a message are skipped
+        auto file_data = m_mapped_file->data();
+        auto file_size = m_mapped_file->size();
+        while (true)
+        {
+            uint32_t header_size;
+            if (record_pos + sizeof(header_size) > file_size)
+                return false;
+            memcpy(&header_size, file_data + record_pos, sizeof(header_size));
+            auto header_pos = record_pos + sizeof(header_size);
+            if (header_pos + header_size + sizeof(data_size) > file_size)
+                return false;
+            memcpy(&data_size, file_data + header_pos + header_size, sizeof(data_size));
+            data_pos = header_pos + header_size + sizeof(data_size);
+            if (data_pos + data_size > file_size)
+                return false;
+
+            //Each field is its length followed by "name=value", the op field holds a single byte
+            int op = -1;
+            for (auto field_pos = header_pos; field_pos + sizeof(uint32_t) <= header_pos + header_size;)
+            {
+                uint32_t field_size;
+                memcpy(&field_size, file_data + field_pos, sizeof(field_size));
+                field_pos += sizeof(field_size);
+                if (field_pos + field_size > header_pos + header_size)
+                    return false;
+                if (field_size == 4 && memcmp(file_data + field_pos, "op=", 3) == 0)
+                    op = file_data[field_pos + 3];
+                field_pos += field_size;
+            }
+
+            if (op == rosbag::OP_MSG_DATA)
+                return true;
+            if (op != rosbag::OP_CONNECTION && op != rosbag::OP_MSG_DEF)
+                return false;
+            record_pos = data_pos + data_size;
+        }
+    }
+
+    bool ros_reader::try_read_mapped_image(const rosbag::MessageInstance &image_data, sensor_msgs::Image& msg, const uint8_t*& pixels) const
+    {
+        uint64_t record_pos;
+        uint64_t data_pos;
+        uint32_t data_size;
+        if (!m_mapped_file || !image_data.getUncompressedRecordPosition(record_pos) || !find_mapped_message(record_pos, data_pos, data_size))
+        {
+            return false;
+        }
+
+        //Deserialize every field but the pixels, which are referenced in place
+        rs2rosinternal::serialization::IStream stream(const_cast<uint8_t*>(m_mapped_file->data() + data_pos), data_size);
+        stream.next(msg.header);
+        stream.next(msg.height);
+        stream.next(msg.width);
+        stream.next(msg.encoding);
+        stream.next(msg.is_bigendian);
+        stream.next(msg.step);
+        uint32_t pixels_size;
+        stream.next(pixels_size);
+        if (pixels_size > stream.getLength())
+        {
+            throw io_exception(to_string() << "Invalid image message size (Topic: " << image_data.getTopic() << ")");
+        }
+        //Only a full raw image is referenced, the frame exposes step * height bytes.
+        //Shorter or compressed images (e.g. Z16H) are copied into a buffer of their own size
+        if (pixels_size != uint64_t(msg.step) * msg.height)
+        {
+            return false;
+        }
+        pixels = stream.getData();
+        return true;
+    }
+
     frame_holder ros_reader::create_image_from_message(const rosbag::MessageInstance &image_data) const
     {
         LOG_DEBUG("Trying to create an image frame from message");
-        auto msg = instantiate_msg<sensor_msgs::Image>(image_data);
+        //Images in uncompressed chunks are referenced directly from the mapped file instead of being copied.
+        //Other images are deserialized into a message of their own, and the frame takes its pixels
+        const uint8_t* mapped_pixels = nullptr;
+        sensor_msgs::Image mapped_msg;
+        sensor_msgs::Image::Ptr copied_msg;
+        if (!try_read_mapped_image(image_data, mapped_msg, mapped_pixels))
+        {
+            copied_msg = instantiate_msg<sensor_msgs::Image>(image_data);
+        }
+        sensor_msgs::Image& msg = mapped_pixels ? mapped_msg : *copied_msg;
         frame_additional_data additional_data{};
-        std::chrono::duration<double, std::milli> timestamp_ms(std::chrono::duration<double>(msg->header.stamp.toSec()));
+        std::chrono::duration<double, std::milli> timestamp_ms(std::chrono::duration<double>(msg.header.stamp.toSec()));
         additional_data.timestamp = timestamp_ms.count();
-        additional_data.frame_number = msg->header.seq;
+        additional_data.frame_number = msg.header.seq;
         additional_data.fisheye_ae_mode = false;
 
         stream_identifier stream_id;
@@ -427,22 +599,31 @@ namespace librealsense
         }
 
         frame_interface* frame = m_frame_source->alloc_frame((stream_id.stream_type == RS2_STREAM_DEPTH) ? RS2_EXTENSION_DEPTH_FRAME : RS2_EXTENSION_VIDEO_FRAME,
-            msg->data.size(), additional_data, true);
+            mapped_pixels ? 0 : msg.data.size(), additional_data, mapped_pixels == nullptr);
         if (frame == nullptr)
         {
             LOG_WARNING("Failed to allocate new frame");
             return nullptr;
         }
         librealsense::video_frame* video_frame = static_cast<librealsense::video_frame*>(frame);
-        video_frame->assign(msg->width, msg->height, msg->step, msg->step / msg->width * 8);
+        video_frame->assign(msg.width, msg.height, msg.step, msg.step / msg.width * 8);
         rs2_format stream_format;
-        convert(msg->encoding, stream_format);
+        convert(msg.encoding, stream_format);
         //attaching a temp stream to the frame. Playback sensor should assign the real stream
         frame->set_stream(std::make_shared<video_stream_profile>(platform::stream_profile{}));
         frame->get_stream()->set_format(stream_format);
         frame->get_stream()->set_stream_index(int(stream_id.stream_index));
         frame->get_stream()->set_stream_type(stream_id.stream_type);
-        video_frame->data = std::move(msg->data);
+        if (mapped_pixels)
+        {
+            //The frame keeps the mapping alive until it is released
+            auto mapped_file = m_mapped_file;
+            frame->attach_continuation(frame_continuation{ [mapped_file]() {}, mapped_pixels, size_t(msg.step) * msg.height });
+        }
+        else
+        {
+            video_frame->data = std::move(msg.data);
+        }
         librealsense::frame_holder fh{ video_frame };
         LOG_DEBUG("Created image frame: " << stream_id << " " << video_frame->get_width() << "x" << video_frame->get_height() << " " << stream_format);
 
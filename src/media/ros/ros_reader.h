@@ -5,6 +5,7 @@
 #include <core/serialization.h>
 #include "rosbag/view.h"
 #include "ros_file_format.h"
+#include "memory_mapped_file.h"
 
 namespace librealsense
 {
@@ -23,13 +24,33 @@ namespace librealsense
         virtual void enable_stream(const std::vector<device_serializer::stream_identifier>& stream_ids) override;
         virtual void disable_stream(const std::vector<device_serializer::stream_identifier>& stream_ids) override;
         const std::string& get_file_name() const override;
+        void set_blocking(bool blocking) override;
+
+        /**
+        * Seeks to a time of the file without checking it against the playback duration,
+        * for readers that place the file on a timeline of their own
+        */
+        void seek_to_file_time(const nanoseconds& seek_time);
+
+        struct file_time_range
+        {
+            nanoseconds begin;          // Timestamp of the first frame of the file
+            nanoseconds end;            // Timestamp of the last frame of the file
+            bool continues_recording;   // Whether the file continues a recording that the writer split into several files
+            nanoseconds segment_start;  // Time of the split recording at which the timeline of the file starts
+        };
+
+        /**
+        * Returns the timestamps of the first and the last frames of the file, without reading the device description
+        */
+        static file_time_range query_file_time_range(const std::string& file);
 
     private:
 
         template <typename ROS_TYPE>
-        static typename ROS_TYPE::ConstPtr instantiate_msg(const rosbag::MessageInstance& msg)
+        static typename ROS_TYPE::Ptr instantiate_msg(const rosbag::MessageInstance& msg)
         {
-            typename ROS_TYPE::ConstPtr msg_instnance_ptr = msg.instantiate<ROS_TYPE>();
+            typename ROS_TYPE::Ptr msg_instnance_ptr = msg.instantiate<ROS_TYPE>();
             if (msg_instnance_ptr == nullptr)
             {
                 throw io_exception(to_string()
@@ -42,7 +63,9 @@ namespace librealsense
         }
 
         std::shared_ptr<serialized_frame> create_frame(const rosbag::MessageInstance& msg);
-        static nanoseconds get_file_duration(const rosbag::Bag& file, uint32_t version);
+        uint32_t get_frames_pool_size() const;
+        const std::vector<rs2rosinternal::Time>& get_frames_time_index(const std::string& topic);
+        static std::pair<nanoseconds, nanoseconds> get_frames_time_range(const rosbag::Bag& file, uint32_t version);
         static void get_legacy_frame_metadata(const rosbag::Bag& bag,
             const device_serializer::stream_identifier& stream_id,
             const rosbag::MessageInstance &msg,
@@ -69,6 +92,8 @@ namespace librealsense
             const rosbag::MessageInstance &msg,
             frame_additional_data& additional_data);
         frame_holder create_image_from_message(const rosbag::MessageInstance &image_data) const;
+        bool find_mapped_message(uint64_t record_pos, uint64_t& data_pos, uint32_t& data_size) const;
+        bool try_read_mapped_image(const rosbag::MessageInstance &image_data, sensor_msgs::Image& msg, const uint8_t*& pixels) const;
         frame_holder create_motion_sample(const rosbag::MessageInstance &motion_data) const;
         static inline float3 to_float3(const geometry_msgs::Vector3& v);
         static inline float4 to_float4(const geometry_msgs::Quaternion& q);
@@ -138,10 +163,13 @@ namespace librealsense
         std::string                             m_file_path;
         std::shared_ptr<frame_source>           m_frame_source;
         rosbag::Bag                             m_file;
+        std::shared_ptr<memory_mapped_file>     m_mapped_file;
         std::unique_ptr<rosbag::View>           m_samples_view;
         rosbag::View::iterator                  m_samples_itrator;
         std::vector<std::string>                m_enabled_streams_topics;
+        std::map<std::string, std::vector<rs2rosinternal::Time>> m_frames_time_index;
         std::shared_ptr<context>                m_context;
         uint32_t                                m_version;
+        bool                                    m_blocking;
     };
 }
@@ -17,62 +17,206 @@ namespace librealsense
 {
     using namespace device_serializer;
 
-    ros_writer::ros_writer(const std::string& file, bool compress_while_record) : m_file_path(file)
+    ros_writer::ros_writer(const std::string& file, bool compress_while_record, uint64_t max_segment_size, nanoseconds max_segment_duration) :
+        m_file_path(file),
+        m_compress_while_record(compress_while_record),
+        m_max_segment_size(max_segment_size),
+        m_max_segment_duration(max_segment_duration),
+        m_segment_index(0),
+        m_segment_start(0),
+        m_last_frame_time(0),
+        m_segment_has_frames(false)
     {
         LOG_INFO("Compression while record is set to " << (compress_while_record ? "ON" : "OFF"));
-        m_bag.open(file, rosbag::BagMode::Write);
-        if (compress_while_record)
+        open_segment(file);
+    }
+
+    ros_writer::~ros_writer()
+    {
+        if (m_closing_thread.joinable())
         {
-            m_bag.setCompression(rosbag::CompressionType::LZ4);
+            m_closing_thread.join();
+        }
+    }
+
+    void ros_writer::open_segment(const std::string& file)
+    {
+        m_bag = std::make_shared<rosbag::Bag>();
+        m_bag->open(file, rosbag::BagMode::Write);
+        if (m_compress_while_record)
+        {
+            m_bag->setCompression(rosbag::CompressionType::LZ4);
         }
         write_file_version();
     }
 
+    bool ros_writer::is_segment_full(const nanoseconds& timestamp) const
+    {
+        if (!m_segment_has_frames)
+            return false;
+
+        if (m_max_segment_size > 0 && m_bag->getSize() >= m_max_segment_size)
+            return true;
+
+        return m_max_segment_duration > nanoseconds::zero() && timestamp - m_segment_start >= m_max_segment_duration;
+    }
+
+    void ros_writer::start_next_segment()
+    {
+        //Closing a bag writes its index, which takes a while for large files.
+        //This is done on the side so that the frames that follow are written to the next file right away
+        if (m_closing_thread.joinable())
+        {
+            m_closing_thread.join();
+        }
+        auto full_bag = m_bag;
+        m_bag.reset();
+        m_closing_thread = std::thread([full_bag]()
+        {
+            try
+            {
+                full_bag->close();
+            }
+            catch (const std::exception& e)
+            {
+                LOG_ERROR("Failed to close recorded file. " << e.what());
+            }
+        });
+
+        m_segment_index++;
+        m_segment_start = m_last_frame_time;
+        m_segment_has_frames = false;
+        m_extrinsics_msgs.clear();
+        m_written_options_descriptions.clear();
+
+        auto file = get_segment_file_name(m_file_path, m_segment_index);
+        open_segment(file);
+
+        //The time the recording reached when the file starts, so a reader places the file without reading the files before it
+        std_msgs::UInt64 segment_start;
+        segment_start.data = m_segment_start.count();
+        write_message(ros_topic::segment_start_topic(), get_static_file_info_timestamp(), segment_start);
+
+        //Every file starts with the latest known state of the device, so it can be played on its own
+        write_device_state();
+        LOG_INFO("Recording continues to file " << file);
+    }
+
+    nanoseconds ros_writer::to_segment_time(const nanoseconds& timestamp) const
+    {
+        if (m_segment_index == 0)
+            return timestamp;
+
+        //Data captured before the split but written after it is placed at the beginning of the new file
+        return std::max<nanoseconds>(timestamp - m_segment_start, std::chrono::microseconds(1));
+    }
+
+    void ros_writer::update_device_description(uint32_t sensor_index, rs2_extension type, const std::shared_ptr<extension_snapshot>& snapshot, bool is_device)
+    {
+        if (auto profile = As<stream_profile_interface>(snapshot))
+        {
+            stream_identifier stream_id{ get_device_index(), sensor_index, profile->get_stream_type(), static_cast<uint32_t>(profile->get_stream_index()) };
+            m_stream_profiles[stream_id] = std::make_pair(type, snapshot);
+            return;
+        }
+
+        if (is_device)
+        {
+            m_device_description.get_device_extensions_snapshots()[type] = snapshot;
+            return;
+        }
+
+        for (auto&& sensor_snapshot : m_device_description.get_sensors_snapshots())
+        {
+            if (sensor_snapshot.get_sensor_index() == sensor_index)
+            {
+                sensor_snapshot.get_sensor_extensions_snapshots()[type] = snapshot;
+                return;
+            }
+        }
+    }
+
     void ros_writer::write_device_description(const librealsense::device_snapshot& device_description)
     {
-        for (auto&& device_extension_snapshot : device_description.get_device_extensions_snapshots().get_snapshots())
+        m_device_description = device_description;
+        //The stream profiles are kept per stream, apart from the other snapshots of their sensor
+        for (auto&& sensors_snapshot : device_description.get_sensors_snapshots())
+        {
+            for (auto&& sensor_extension_snapshot : sensors_snapshot.get_sensor_extensions_snapshots().get_snapshots())
+            {
+                if (Is<stream_profile_interface>(sensor_extension_snapshot.second))
+                {
+                    update_device_description(sensors_snapshot.get_sensor_index(), sensor_extension_snapshot.first, sensor_extension_snapshot.second, false);
+                }
+            }
+        }
+        write_device_state();
+    }
+
+    void ros_writer::write_device_state()
+    {
+        for (auto&& device_extension_snapshot : m_device_description.get_device_extensions_snapshots().get_snapshots())
         {
             write_extension_snapshot(get_device_index(), get_static_file_info_timestamp(), device_extension_snapshot.first, device_extension_snapshot.second);
         }
 
-        for (auto&& sensors_snapshot : device_description.get_sensors_snapshots())
+        for (auto&& sensors_snapshot : m_device_description.get_sensors_snapshots())
         {
             for (auto&& sensor_extension_snapshot : sensors_snapshot.get_sensor_extensions_snapshots().get_snapshots())
             {
+                if (Is<stream_profile_interface>(sensor_extension_snapshot.second))
+                    continue;
                 write_extension_snapshot(get_device_index(), sensors_snapshot.get_sensor_index(), get_static_file_info_timestamp(), sensor_extension_snapshot.first, sensor_extension_snapshot.second);
             }
         }
+
+        //Each stream profile is written once, from the latest snapshot of its stream
+        for (auto&& stream_profile : m_stream_profiles)
+        {
+            auto&& stream_id = stream_profile.first;
+            write_extension_snapshot(stream_id.device_index, stream_id.sensor_index, get_static_file_info_timestamp(), stream_profile.second.first, stream_profile.second.second);
+        }
     }
 
     void ros_writer::write_frame(const stream_identifier& stream_id, const nanoseconds& timestamp, frame_holder&& frame)
     {
+        if (is_segment_full(timestamp))
+        {
+            start_next_segment();
+        }
+        m_last_frame_time = std::max(m_last_frame_time, timestamp);
+        m_segment_has_frames = true;
+        auto segment_time = to_segment_time(timestamp);
+
         if (Is<video_frame>(frame.frame))
         {
-            write_video_frame(stream_id, timestamp, std::move(frame));
+            write_video_frame(stream_id, segment_time, std::move(frame));
             return;
         }
 
         if (Is<motion_frame>(frame.frame))
         {
-            write_motion_frame(stream_id, timestamp, std::move(frame));
+            write_motion_frame(stream_id, segment_time, std::move(frame));
             return;
         }
 
         if (Is<pose_frame>(frame.frame))
         {
-            write_pose_frame(stream_id, timestamp, std::move(frame));
+            write_pose_frame(stream_id, segment_time, std::move(frame));
             return;
         }
     }
 
     void ros_writer::write_snapshot(uint32_t device_index, const nanoseconds& timestamp, rs2_extension type, const std::shared_ptr<extension_snapshot>& snapshot)
     {
-        write_extension_snapshot(device_index, -1, timestamp, type, snapshot);
+        update_device_description(-1, type, snapshot, true);
+        write_extension_snapshot(device_index, -1, to_segment_time(timestamp), type, snapshot);
     }
 
     void ros_writer::write_snapshot(const sensor_identifier& sensor_id, const nanoseconds& timestamp, rs2_extension type, const std::shared_ptr<extension_snapshot>& snapshot)
     {
-        write_extension_snapshot(sensor_id.device_index, sensor_id.sensor_index, timestamp, type, snapshot);
+        update_device_description(sensor_id.sensor_index, type, snapshot, false);
+        write_extension_snapshot(sensor_id.device_index, sensor_id.sensor_index, to_segment_time(timestamp), type, snapshot);
     }
 
     const std::string& ros_writer::get_file_name() const
@@ -145,7 +289,7 @@ namespace librealsense
     void ros_writer::write_notification(const sensor_identifier& sensor_id, const nanoseconds& timestamp, const notification& n)
     {
         realsense_msgs::Notification noti_msg = to_notification_msg(n);
-        write_message(ros_topic::notification_topic({ sensor_id.device_index, sensor_id.sensor_index }, n.category), timestamp, noti_msg);
+        write_message(ros_topic::notification_topic({ sensor_id.device_index, sensor_id.sensor_index }, n.category), to_segment_time(timestamp), noti_msg);
     }
 
     void ros_writer::write_additional_frame_messages(const stream_identifier& stream_id, const nanoseconds& timestamp, frame_interface* frame)
@@ -200,34 +344,52 @@ namespace librealsense
         {
             throw io_exception("Null frame passed to write_motion_frame");
         }
-
-        imu_msg.header.seq = static_cast<uint32_t>(frame.frame->get_frame_number());
-        std::chrono::duration<double, std::milli> timestamp_ms(frame.frame->get_frame_timestamp());
-        imu_msg.header.stamp = rs2rosinternal::Time(std::chrono::duration<double>(timestamp_ms).count());
-        std::string TODO_CORRECT_ME = "0";
-        imu_msg.header.frame_id = TODO_CORRECT_ME;
-        auto data_ptr = reinterpret_cast<const float*>(frame.frame->get_frame_data());
-        if (stream_id.stream_type == RS2_STREAM_ACCEL)
-        {
-            imu_msg.linear_acceleration.x = data_ptr[0];
-            imu_msg.linear_acceleration.y = data_ptr[1];
-            imu_msg.linear_acceleration.z = data_ptr[2];
-        }
-
-        else if (stream_id.stream_type == RS2_STREAM_GYRO)
-        {
-            imu_msg.angular_velocity.x = data_ptr[0];
-            imu_msg.angular_velocity.y = data_ptr[1];
-            imu_msg.angular_velocity.z = data_ptr[2];
-        }
-        else
+        if (stream_id.stream_type != RS2_STREAM_ACCEL && stream_id.stream_type != RS2_STREAM_GYRO)
         {
             throw io_exception("Unsupported stream type for a motion frame");
         }
 
+        // A batch is recorded as its separate samples, each written at the time and with the timestamp of its own,
+        // so it plays back as single samples. The samples share the metadata of the batch
+        auto motion = As<librealsense::motion_frame>(frame.frame);
+        auto samples = motion ? motion->get_samples_count() : 1;
+        auto timestamps = motion ? motion->get_samples_timestamps() : nullptr;
+        auto frame_number = frame.frame->get_frame_number();
+        auto data_ptr = reinterpret_cast<const float*>(frame.frame->get_frame_data());
         auto topic = ros_topic::frame_data_topic(stream_id);
-        write_message(topic, timestamp, imu_msg);
-        write_additional_frame_messages(stream_id, timestamp, frame);
+
+        for (int i = 0; i < samples; i++)
+        {
+            auto sample_time = timestamp;
+            std::chrono::duration<double, std::milli> timestamp_ms(frame.frame->get_frame_timestamp());
+            if (samples > 1)
+            {
+                timestamp_ms = std::chrono::duration<double, std::milli>(timestamps[i]);
+                auto sample_offset = std::chrono::duration<double, std::milli>(timestamps[samples - 1] - timestamps[i]);
+                sample_time = std::max(nanoseconds(0), timestamp - std::chrono::duration_cast<nanoseconds>(sample_offset));
+            }
+
+            imu_msg.header.seq = static_cast<uint32_t>(frame_number - (samples - 1 - i));
+            imu_msg.header.stamp = rs2rosinternal::Time(std::chrono::duration<double>(timestamp_ms).count());
+            std::string TODO_CORRECT_ME = "0";
+            imu_msg.header.frame_id = TODO_CORRECT_ME;
+            auto sample_data = data_ptr + 3 * i;
+            if (stream_id.stream_type == RS2_STREAM_ACCEL)
+            {
+                imu_msg.linear_acceleration.x = sample_data[0];
+                imu_msg.linear_acceleration.y = sample_data[1];
+                imu_msg.linear_acceleration.z = sample_data[2];
+            }
+            else
+            {
+                imu_msg.angular_velocity.x = sample_data[0];
+                imu_msg.angular_velocity.y = sample_data[1];
+                imu_msg.angular_velocity.z = sample_data[2];
+            }
+
+            write_message(topic, sample_time, imu_msg);
+            write_additional_frame_messages(stream_id, sample_time, frame);
+        }
     }
 
     inline geometry_msgs::Vector3 ros_writer::to_vector3(const float3& f)
@@ -4,6 +4,7 @@
 #pragma once
 #include "rosbag/bag.h"
 #include "ros_file_format.h"
+#include <thread>
 
 namespace librealsense
 {
@@ -12,7 +13,12 @@ namespace librealsense
     class ros_writer: public writer
     {
     public:
-        explicit ros_writer(const std::string& file, bool compress_while_record);
+        /**
+        * \param[in] max_segment_size      Size in bytes after which the recording continues to a new file, 0 for no limit
+        * \param[in] max_segment_duration  Recorded duration after which the recording continues to a new file, 0 for no limit
+        */
+        explicit ros_writer(const std::string& file, bool compress_while_record, uint64_t max_segment_size = 0, nanoseconds max_segment_duration = nanoseconds::zero());
+        ~ros_writer();
         void write_device_description(const librealsense::device_snapshot& device_description) override;
         void write_frame(const stream_identifier& stream_id, const nanoseconds& timestamp, frame_holder&& frame) override;
         void write_snapshot(uint32_t device_index, const nanoseconds& timestamp, rs2_extension type, const std::shared_ptr<extension_snapshot>& snapshot) override;
@@ -20,6 +26,12 @@ namespace librealsense
         const std::string& get_file_name() const override;
 
     private:
+        void open_segment(const std::string& file);
+        bool is_segment_full(const nanoseconds& timestamp) const;
+        void start_next_segment();
+        nanoseconds to_segment_time(const nanoseconds& timestamp) const;
+        void write_device_state();
+        void update_device_description(uint32_t sensor_index, rs2_extension type, const std::shared_ptr<extension_snapshot>& snapshot, bool is_device);
         void write_file_version();
         void write_frame_metadata(const stream_identifier& stream_id, const nanoseconds& timestamp, frame_interface* frame);
         void write_extrinsics(const stream_identifier& stream_id, frame_interface* frame);
@@ -63,7 +75,7 @@ namespace librealsense
         {
             try
             {
-                m_bag.write(topic, to_rostime(time), msg);
+                m_bag->write(topic, to_rostime(time), msg);
                 LOG_DEBUG("Recorded: \"" << topic << "\" . TS: " << time.count());
             }
             catch (rosbag::BagIOException& e)
@@ -75,7 +87,18 @@ namespace librealsense
         static uint8_t is_big_endian();
         std::map<stream_identifier, geometry_msgs::Transform> m_extrinsics_msgs;
         std::string m_file_path;
-        rosbag::Bag m_bag;
+        std::shared_ptr<rosbag::Bag> m_bag;
         std::map<uint32_t, std::set<rs2_option>> m_written_options_descriptions;
+
+        bool m_compress_while_record;
+        uint64_t m_max_segment_size;
+        nanoseconds m_max_segment_duration;
+        uint32_t m_segment_index;
+        nanoseconds m_segment_start;
+        nanoseconds m_last_frame_time;
+        bool m_segment_has_frames;
+        device_snapshot m_device_description;
+        std::map<stream_identifier, std::pair<rs2_extension, std::shared_ptr<extension_snapshot>>> m_stream_profiles;
+        std::thread m_closing_thread;
     };
 }
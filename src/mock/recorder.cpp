@@ -7,6 +7,7 @@
 #include <algorithm>
 #include "types.h"
 #include <iostream>
+#include "../../third-party/realsense-file/lz4/lz4.h"
 
 using namespace std;
 using namespace sql;
@@ -42,6 +43,15 @@ const char* PROFILES_CREATE = "CREATE TABLE rs_profile(section NUMBER, width NUM
 const char* PROFILES_INSERT = "INSERT INTO rs_profile(section, width, height, fps, fourcc) VALUES(?, ? ,? ,? ,?)";
 const char* PROFILES_SELECT_ALL = "SELECT * FROM rs_profile WHERE section = ?";
 
+// Binary recording: the file magic is followed by the sections, each is its blobs, its index and a trailer pointing
+// at the index. The index starts with the section name and the offset of the previous index, so the sections are
+// found walking back from the end of the file. Values are stored in the byte order of the machine.
+const char* BINARY_EXTENSION = ".rsmock";
+const char BINARY_MAGIC[8] = { 'R', 'S', 'M', 'O', 'C', 'K', '0', '1' };
+const uint32_t BINARY_INDEX_MAGIC = 0x58444e49; // "INDX"
+const uint32_t BINARY_TRAILER_MAGIC = 0x4c494154; // "TAIL"
+const size_t BINARY_TRAILER_SIZE = sizeof(uint64_t) + sizeof(uint32_t);
+
 namespace librealsense
 {
     namespace platform
@@ -93,19 +103,18 @@ namespace librealsense
 
         vector<uint8_t> compression_algorithm::decode(const vector<uint8_t>& input) const
         {
-            vector<uint8_t> results;
-            for (size_t i = 0; i < input.size() - 5; i += 5)
-            {
-                union {
-                    uint32_t block;
-                    uint8_t bytes[4];
-                } curr_block;
+            size_t decoded_size = 0;
+            for (size_t i = 0; i + 5 < input.size(); i += 5)
+                decoded_size += input[i + 4] * 4;
 
-                curr_block.block = *reinterpret_cast<const uint32_t*>(input.data() + i);
+            vector<uint8_t> results(decoded_size);
+            auto out = results.data();
+            for (size_t i = 0; i + 5 < input.size(); i += 5)
+            {
                 auto len = input[i + 4];
-                for (auto j = 0; j < len * 4; j++)
+                for (auto j = 0; j < len; j++, out += 4)
                 {
-                    results.push_back(curr_block.bytes[j % 4]);
+                    librealsense::copy(out, input.data() + i, 4);
                 }
             }
             return results;
@@ -114,6 +123,7 @@ namespace librealsense
         vector<uint8_t> compression_algorithm::encode(uint8_t* data, size_t size) const
         {
             vector<uint8_t> results;
+            results.reserve(size / 4 * 5 / 2);
             union {
                 uint32_t block;
                 uint8_t bytes[4];
@@ -146,10 +156,321 @@ namespace librealsense
         }
 
         recording::recording(std::shared_ptr<time_service> ts, std::shared_ptr<playback_device_watcher> watcher)
-            :_ts(ts), _watcher(watcher)
+            :_ts(ts), _watcher(watcher), _api_version(RS2_API_VERSION_STR)
         {
         }
 
+        static bool is_binary_recording(const std::string& filename)
+        {
+            std::string extension(BINARY_EXTENSION);
+            return filename.size() >= extension.size() &&
+                filename.compare(filename.size() - extension.size(), extension.size(), extension) == 0;
+        }
+
+        class binary_writer
+        {
+        public:
+            template<class T>
+            void write(const T& value)
+            {
+                auto bytes = reinterpret_cast<const uint8_t*>(&value);
+                _buffer.insert(_buffer.end(), bytes, bytes + sizeof(T));
+            }
+
+            void write(const std::string& str)
+            {
+                write(static_cast<uint32_t>(str.size()));
+                _buffer.insert(_buffer.end(), str.begin(), str.end());
+            }
+
+            void write(const uint8_t* data, size_t size)
+            {
+                _buffer.insert(_buffer.end(), data, data + size);
+            }
+
+            const std::vector<uint8_t>& data() const { return _buffer; }
+            void clear() { _buffer.clear(); }
+
+        private:
+            std::vector<uint8_t> _buffer;
+        };
+
+        class binary_reader
+        {
+        public:
+            explicit binary_reader(std::istream& stream) : _stream(stream), _size(0)
+            {
+                auto position = _stream.tellg();
+                _stream.seekg(0, std::ios::end);
+                _size = static_cast<uint64_t>(_stream.tellg());
+                _stream.seekg(position);
+            }
+
+            uint64_t size() const { return _size; }
+
+            uint64_t remaining() const
+            {
+                auto position = _stream.tellg();
+                if (position < 0 || static_cast<uint64_t>(position) > _size)
+                    return 0;
+                return _size - static_cast<uint64_t>(position);
+            }
+
+            // The records counted are at least record_size bytes each, all of them must fit in the rest of the file
+            uint32_t read_count(size_t record_size)
+            {
+                auto count = read<uint32_t>();
+                if (static_cast<uint64_t>(count) * record_size > remaining())
+                    throw runtime_error("Invalid recording, record count exceeds the file size!");
+                return count;
+            }
+
+            template<class T>
+            T read()
+            {
+                T value;
+                read(reinterpret_cast<uint8_t*>(&value), sizeof(T));
+                return value;
+            }
+
+            std::string read_string()
+            {
+                std::string str(read_count(1), '\0');
+                if (!str.empty())
+                    read(reinterpret_cast<uint8_t*>(&str[0]), str.size());
+                return str;
+            }
+
+            void read(uint8_t* data, size_t size)
+            {
+                if (!_stream.read(reinterpret_cast<char*>(data), size))
+                    throw runtime_error("Invalid recording, unexpected end of file!");
+            }
+
+        private:
+            std::istream& _stream;
+            uint64_t _size;
+        };
+
+        // Returns the offset of the index of the last section, zero if the file has no sections
+        static uint64_t read_binary_trailer(std::istream& file, const char* filename)
+        {
+            char magic[sizeof(BINARY_MAGIC)];
+            if (!file.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), BINARY_MAGIC))
+                throw runtime_error(to_string() << "File " << filename << " is not a binary recording!");
+
+            file.seekg(0, std::ios::end);
+            if (static_cast<size_t>(file.tellg()) < sizeof(BINARY_MAGIC) + BINARY_TRAILER_SIZE)
+                return 0;
+
+            file.seekg(-static_cast<std::streamoff>(BINARY_TRAILER_SIZE), std::ios::end);
+            binary_reader reader(file);
+            auto index_offset = reader.read<uint64_t>();
+            if (reader.read<uint32_t>() != BINARY_TRAILER_MAGIC)
+                throw runtime_error(to_string() << "Invalid recording, file " << filename << " was not closed properly!");
+            if (index_offset < sizeof(BINARY_MAGIC) || index_offset >= reader.size() - BINARY_TRAILER_SIZE)
+                throw runtime_error(to_string() << "Invalid recording, file " << filename << " has a corrupted trailer!");
+            return index_offset;
+        }
+
+        // Positions the file right after the name of the section and returns the offset of its index, zero if not found
+        static uint64_t find_binary_section(std::istream& file, uint64_t index_offset, const char* section)
+        {
+            binary_reader reader(file);
+            while (index_offset)
+            {
+                file.seekg(index_offset);
+                if (reader.read<uint32_t>() != BINARY_INDEX_MAGIC)
+                    throw runtime_error("Invalid recording, corrupted section index!");
+                auto previous = reader.read<uint64_t>();
+                if (reader.read_string() == section)
+                    return index_offset;
+                // every section indexes the one written before it, a chain that does not go back is corrupted
+                if (previous >= index_offset || (previous && previous < sizeof(BINARY_MAGIC)))
+                    throw runtime_error("Invalid recording, corrupted section index!");
+                index_offset = previous;
+            }
+            return 0;
+        }
+
+        void recording::save_binary(const char* filename, const char* section, bool append) const
+        {
+            if (append)
+                throw runtime_error(to_string() << "Append record - binary recordings can't append to section " << section << "!");
+
+            uint64_t offset = 0;
+            uint64_t previous_index = 0;
+            if (file_exists(filename))
+            {
+                std::ifstream existing(filename, std::ios::binary);
+                previous_index = read_binary_trailer(existing, filename);
+                if (find_binary_section(existing, previous_index, section))
+                    throw runtime_error(to_string() << "Append record - can't save over existing section in file " << filename << "!");
+                existing.seekg(0, std::ios::end);
+                offset = existing.tellg();
+            }
+
+            std::ofstream file(filename, std::ios::binary | std::ios::app);
+            if (!file)
+                throw runtime_error(to_string() << "Could not open " << filename << " for writing!");
+            LOG_WARNING("Saving recording to file, don't close the application");
+
+            binary_writer writer;
+            if (!offset)
+            {
+                writer.write(reinterpret_cast<const uint8_t*>(BINARY_MAGIC), sizeof(BINARY_MAGIC));
+            }
+
+            // the blobs are written one by one, the index keeps their offsets
+            std::vector<uint64_t> blob_offsets;
+            std::vector<uint8_t> compressed;
+            for (size_t i = 0; i < blobs_count(); i++)
+            {
+                auto blob = load_blob(static_cast<int>(i));
+                auto raw_size = static_cast<int>(blob.size());
+                compressed.resize(LZ4_compressBound(raw_size));
+                auto compressed_size = LZ4_compress_default(reinterpret_cast<const char*>(blob.data()),
+                    reinterpret_cast<char*>(compressed.data()), raw_size, static_cast<int>(compressed.size()));
+                // a blob that does not get smaller is stored as-is
+                bool store_raw = compressed_size <= 0 || compressed_size >= raw_size;
+
+                blob_offsets.push_back(offset + writer.data().size());
+                writer.write(static_cast<uint32_t>(raw_size));
+                writer.write(static_cast<uint32_t>(store_raw ? raw_size : compressed_size));
+                writer.write(store_raw ? blob.data() : compressed.data(), store_raw ? raw_size : compressed_size);
+
+                file.write(reinterpret_cast<const char*>(writer.data().data()), writer.data().size());
+                offset += writer.data().size();
+                writer.clear();
+            }
+
+            auto index_offset = offset + writer.data().size();
+            writer.write(BINARY_INDEX_MAGIC);
+            writer.write(previous_index);
+            writer.write(std::string(section));
+            writer.write(_api_version);
+            writer.write(datetime_string());
+
+            writer.write(static_cast<uint32_t>(calls.size()));
+            for (auto&& cl : calls)
+            {
+                writer.write(static_cast<int32_t>(cl.type));
+                writer.write(cl.timestamp);
+                writer.write(static_cast<int32_t>(cl.entity_id));
+                writer.write(cl.inline_string);
+                writer.write(static_cast<uint8_t>(cl.had_error ? 1 : 0));
+                for (auto param : { cl.param1, cl.param2, cl.param3, cl.param4, cl.param5, cl.param6,
+                                    cl.param7, cl.param8, cl.param9, cl.param10, cl.param11, cl.param12 })
+                    writer.write(static_cast<int32_t>(param));
+            }
+
+            writer.write(static_cast<uint32_t>(uvc_device_infos.size()));
+            for (auto&& info : uvc_device_infos)
+            {
+                writer.write(info.unique_id);
+                writer.write(info.pid);
+                writer.write(info.vid);
+                writer.write(info.mi);
+            }
+
+            writer.write(static_cast<uint32_t>(usb_device_infos.size()));
+            for (auto&& info : usb_device_infos)
+            {
+                writer.write(info.id);
+                writer.write(info.unique_id);
+                writer.write(info.pid);
+                writer.write(info.vid);
+                writer.write(info.mi);
+            }
+
+            writer.write(static_cast<uint32_t>(hid_device_infos.size()));
+            for (auto&& info : hid_device_infos)
+            {
+                writer.write(info.id);
+                writer.write(info.unique_id);
+                writer.write(info.pid);
+                writer.write(info.vid);
+                writer.write(info.device_path);
+            }
+
+            writer.write(static_cast<uint32_t>(hid_sensors.size()));
+            for (auto&& info : hid_sensors)
+            {
+                writer.write(info.name);
+            }
+
+            writer.write(static_cast<uint32_t>(hid_sensor_inputs.size()));
+            for (auto&& info : hid_sensor_inputs)
+            {
+                writer.write(info.name);
+                writer.write(info.index);
+            }
+
+            writer.write(static_cast<uint32_t>(stream_profiles.size()));
+            for (auto&& profile : stream_profiles)
+            {
+                writer.write(profile.width);
+                writer.write(profile.height);
+                writer.write(profile.fps);
+                writer.write(profile.format);
+            }
+
+            writer.write(static_cast<uint32_t>(blob_offsets.size()));
+            for (auto blob_offset : blob_offsets)
+                writer.write(blob_offset);
+
+            writer.write(index_offset);
+            writer.write(BINARY_TRAILER_MAGIC);
+
+            file.write(reinterpret_cast<const char*>(writer.data().data()), writer.data().size());
+            if (!file.flush())
+                throw runtime_error(to_string() << "Failed to write recording to " << filename << "!");
+        }
+
+        std::vector<uint8_t> recording::load_blob(int id) const
+        {
+            if (!_blob_file)
+                return blobs[id];
+
+            if (id < 0 || static_cast<size_t>(id) >= _blob_offsets.size())
+                throw runtime_error(to_string() << "Invalid recording, blob " << id << " does not exist!");
+
+            std::lock_guard<std::mutex> lock(_blob_file_mutex);
+            _blob_file->clear();
+            _blob_file->seekg(_blob_offsets[id]);
+            binary_reader reader(*_blob_file);
+            auto raw_size = reader.read<uint32_t>();
+            auto stored_size = reader.read<uint32_t>();
+            // LZ4 does not compress better than 255:1, a larger raw size is corrupted and is never allocated
+            if (stored_size > raw_size || stored_size > reader.remaining() ||
+                raw_size > static_cast<uint64_t>(stored_size) * 255 + 16)
+                throw runtime_error("Invalid recording, corrupted blob!");
+
+            std::vector<uint8_t> blob(raw_size);
+            if (stored_size == raw_size)
+            {
+                if (raw_size)
+                    reader.read(blob.data(), raw_size);
+                return blob;
+            }
+
+            std::vector<uint8_t> compressed(stored_size);
+            reader.read(compressed.data(), stored_size);
+            auto decompressed = LZ4_decompress_safe(reinterpret_cast<const char*>(compressed.data()),
+                reinterpret_cast<char*>(blob.data()), static_cast<int>(stored_size), static_cast<int>(raw_size));
+            if (decompressed != static_cast<int>(raw_size))
+                throw runtime_error("Invalid recording, corrupted blob!");
+            return blob;
+        }
+
+        void recording::convert(const char* source, const char* target, const char* section)
+        {
+            auto rec = load(source, section, nullptr, "0.0.0");
+            // loading puts an empty call in front of the recorded ones, it is not saved again
+            rec->calls.erase(rec->calls.begin());
+            rec->save(target, section, false);
+        }
+
         void recording::invoke_device_changed_event()
         {
             call* next;
@@ -170,6 +491,12 @@ namespace librealsense
 
         void recording::save(const char* filename, const char* section, bool append) const
         {
+            if (is_binary_recording(filename))
+            {
+                save_binary(filename, section, append);
+                return;
+            }
+
             connection c(filename);
             LOG_WARNING("Saving recording to file, don't close the application");
 
@@ -235,7 +562,7 @@ namespace librealsense
                     statement insert(c, CONFIG_INSERT);
                     insert.bind(1, section_id);
                     insert.bind(2, API_VERSION_KEY);
-                    insert.bind(3, RS2_API_VERSION_STR);
+                    insert.bind(3, _api_version.c_str());
                     insert();
                 }
 
@@ -354,8 +681,10 @@ namespace librealsense
                     insert();
                 }
 
-                for (auto&& blob : blobs)
+                for (size_t i = 0; i < blobs_count(); i++)
                 {
+                    // sqlite does not copy the blob, it has to outlive the insert
+                    auto blob = load_blob(static_cast<int>(i));
                     statement insert(c, BLOBS_INSERT);
                     insert.bind(1, section_id);
                     insert.bind(2, blob);
@@ -389,6 +718,11 @@ namespace librealsense
                 throw runtime_error("Recording file not found!");
             }
 
+            if (is_binary_recording(filename))
+            {
+                return load_binary(filename, section, watcher, min_api_version);
+            }
+
             auto result = make_shared<recording>(nullptr, watcher);
 
             connection c(filename);
@@ -425,6 +759,7 @@ namespace librealsense
                     throw runtime_error(to_string() << "File version is lower than the minimum required version that was defind by the test, file version: " <<
                         api_version << " min version: " << min_api_version);
                 LOG_WARNING("Loaded recording from API version " << api_version);
+                result->_api_version = api_version;
             }
 
             statement select_calls(c, CALLS_SELECT_ALL);
@@ -532,6 +867,125 @@ namespace librealsense
             return result;
         }
 
+        shared_ptr<recording> recording::load_binary(const char* filename, const char* section, std::shared_ptr<playback_device_watcher> watcher, std::string min_api_version)
+        {
+            auto result = make_shared<recording>(nullptr, watcher);
+
+            auto file = make_shared<std::ifstream>(filename, std::ios::binary);
+            auto index_offset = find_binary_section(*file, read_binary_trailer(*file, filename), section);
+            if (!index_offset)
+            {
+                throw runtime_error(to_string() << "Could not find section " << section << "!");
+            }
+
+            binary_reader reader(*file);
+            auto api_version = reader.read_string();
+            if (is_heighr_or_equel_to_min_version(api_version, min_api_version) == false)
+                throw runtime_error(to_string() << "File version is lower than the minimum required version that was defind by the test, file version: " <<
+                    api_version << " min version: " << min_api_version);
+            LOG_WARNING("Loaded recording from API version " << api_version);
+            result->_api_version = api_version;
+            reader.read_string(); // created at
+
+            // the smallest record of each list, with its strings empty
+            const size_t call_size = 2 * sizeof(int32_t) + sizeof(double) + sizeof(uint32_t) + sizeof(uint8_t) + 12 * sizeof(int32_t);
+            auto count = reader.read_count(call_size);
+            result->calls.reserve(count + 1);
+            result->calls.push_back(call());
+            for (uint32_t i = 0; i < count; i++)
+            {
+                call cl;
+                cl.type = static_cast<call_type>(reader.read<int32_t>());
+                cl.timestamp = reader.read<double>();
+                cl.entity_id = reader.read<int32_t>();
+                cl.inline_string = reader.read_string();
+                cl.had_error = reader.read<uint8_t>() > 0;
+                for (auto param : { &cl.param1, &cl.param2, &cl.param3, &cl.param4, &cl.param5, &cl.param6,
+                                    &cl.param7, &cl.param8, &cl.param9, &cl.param10, &cl.param11, &cl.param12 })
+                    *param = reader.read<int32_t>();
+
+                result->calls.push_back(cl);
+                result->_curr_time = cl.timestamp;
+            }
+
+            count = reader.read_count(sizeof(uint32_t) + 3 * sizeof(uint16_t));
+            for (uint32_t i = 0; i < count; i++)
+            {
+                uvc_device_info info;
+                info.unique_id = reader.read_string();
+                info.pid = reader.read<uint16_t>();
+                info.vid = reader.read<uint16_t>();
+                info.mi = reader.read<uint16_t>();
+                result->uvc_device_infos.push_back(info);
+            }
+
+            count = reader.read_count(2 * sizeof(uint32_t) + 3 * sizeof(uint16_t));
+            for (uint32_t i = 0; i < count; i++)
+            {
+                usb_device_info info;
+                info.id = reader.read_string();
+                info.unique_id = reader.read_string();
+                info.pid = reader.read<uint16_t>();
+                info.vid = reader.read<uint16_t>();
+                info.mi = reader.read<uint16_t>();
+                result->usb_device_infos.push_back(info);
+            }
+
+            count = reader.read_count(5 * sizeof(uint32_t));
+            for (uint32_t i = 0; i < count; i++)
+            {
+                hid_device_info info;
+                info.id = reader.read_string();
+                info.unique_id = reader.read_string();
+                info.pid = reader.read_string();
+                info.vid = reader.read_string();
+                info.device_path = reader.read_string();
+                result->hid_device_infos.push_back(info);
+            }
+
+            count = reader.read_count(sizeof(uint32_t));
+            for (uint32_t i = 0; i < count; i++)
+            {
+                hid_sensor info;
+                info.name = reader.read_string();
+                result->hid_sensors.push_back(info);
+            }
+
+            count = reader.read_count(2 * sizeof(uint32_t));
+            for (uint32_t i = 0; i < count; i++)
+            {
+                hid_sensor_input info;
+                info.name = reader.read_string();
+                info.index = reader.read<uint32_t>();
+                result->hid_sensor_inputs.push_back(info);
+            }
+
+            count = reader.read_count(4 * sizeof(uint32_t));
+            for (uint32_t i = 0; i < count; i++)
+            {
+                stream_profile p;
+                p.width = reader.read<uint32_t>();
+                p.height = reader.read<uint32_t>();
+                p.fps = reader.read<uint32_t>();
+                p.format = reader.read<uint32_t>();
+                result->stream_profiles.push_back(p);
+            }
+
+            count = reader.read_count(sizeof(uint64_t));
+            result->_blob_offsets.resize(count);
+            for (uint32_t i = 0; i < count; i++)
+            {
+                // the blobs of a section are written before its index
+                auto offset = reader.read<uint64_t>();
+                if (offset < sizeof(BINARY_MAGIC) || offset + 2 * sizeof(uint32_t) > index_offset)
+                    throw runtime_error("Invalid recording, corrupted blob offset!");
+                result->_blob_offsets[i] = offset;
+            }
+            result->_blob_file = file;
+
+            return result;
+        }
+
         int recording::save_blob(const void* ptr, size_t size)
         {
             lock_guard<recursive_mutex> lock(_mutex);
@@ -548,38 +1002,62 @@ namespace librealsense
             return _ts->get_time();
         }
 
+        size_t call_positions::next_after(size_t position)
+        {
+            auto is_next = [&](size_t i)
+            {
+                return i < positions.size() && positions[i] > position && (i == 0 || positions[i - 1] <= position);
+            };
+            if (is_next(hint)) return hint;
+            if (is_next(hint + 1)) return ++hint;
+
+            hint = std::upper_bound(positions.begin(), positions.end(), position) - positions.begin();
+            return hint;
+        }
+
+        void recording::index_calls()
+        {
+            for (; _indexed_calls < calls.size(); _indexed_calls++)
+            {
+                auto&& c = calls[_indexed_calls];
+                _calls_index[{ c.type, c.entity_id }].positions.push_back(_indexed_calls);
+                _entity_calls_index[c.entity_id].positions.push_back(_indexed_calls);
+            }
+        }
+
         call& recording::find_call(call_type t, int entity_id, std::function<bool(const call& c)> history_match_validation)
         {
             lock_guard<recursive_mutex> lock(_mutex);
+            index_calls();
+
+            auto it = _calls_index.find({ t, entity_id });
+            if (it == _calls_index.end())
+                throw runtime_error("The recording is missing the part you are trying to playback!");
 
+            // the lookup continues from the cursor of the entity and wraps around to the start of the recording
+            auto&& index = it->second;
+            auto next = index.next_after(_cursors[entity_id]);
+            const auto idx = next < index.positions.size() ? index.positions[next] : index.positions.front();
 
-            for (size_t i = 1; i <= calls.size(); i++)
+            if (calls[idx].had_error)
             {
-                const auto idx = (_cursors[entity_id] + i) % static_cast<int>(calls.size());
-                if (calls[idx].type == t && calls[idx].entity_id == entity_id)
-                {
-                    if (calls[idx].had_error)
-                    {
-                        throw runtime_error(calls[idx].inline_string);
-                    }
-                    _curr_time = calls[idx].timestamp;
+                throw runtime_error(calls[idx].inline_string);
+            }
+            _curr_time = calls[idx].timestamp;
 
-                    if (!history_match_validation(calls[idx]))
-                    {
-                        throw playback_backend_exception("Recording history mismatch!", t, entity_id);
-                    }
+            if (!history_match_validation(calls[idx]))
+            {
+                throw playback_backend_exception("Recording history mismatch!", t, entity_id);
+            }
 
-                    _cursors[entity_id] = _cycles[entity_id] = idx;
+            _cursors[entity_id] = _cycles[entity_id] = idx;
 
-                    auto next = pick_next_call();
-                    if (next && t != call_type::device_watcher_event && next->type == call_type::device_watcher_event)
-                    {
-                        invoke_device_changed_event();
-                    }
-                    return calls[idx];
-                }
+            auto next_call = pick_next_call();
+            if (next_call && t != call_type::device_watcher_event && next_call->type == call_type::device_watcher_event)
+            {
+                invoke_device_changed_event();
             }
-            throw runtime_error("The recording is missing the part you are trying to playback!");
+            return calls[idx];
         }
 
         call* recording::pick_next_call(int id)
@@ -589,6 +1067,16 @@ namespace librealsense
             return &calls[idx];
         }
 
+        call* recording::pick_next_entity_call(int id)
+        {
+            lock_guard<recursive_mutex> lock(_mutex);
+            index_calls();
+
+            auto&& index = _entity_calls_index[id];
+            auto next = index.next_after(_cycles[id]);
+            return next < index.positions.size() ? &calls[index.positions[next]] : nullptr;
+        }
+
         call* recording::cycle_calls(call_type t, int id)
         {
 
@@ -598,29 +1086,61 @@ namespace librealsense
             {
                 invoke_device_changed_event();
             }
+            index_calls();
 
-            for (size_t i = 1; i <= calls.size(); i++)
+            // only the next call of the entity matters, a call of another type ends the cycle
+            auto&& index = _entity_calls_index[id];
+            auto next_position = index.next_after(_cycles[id]);
+            if (next_position >= index.positions.size())
             {
-                const auto idx = (_cycles[id] + i);
-                 if (idx >= calls.size())
-                 {
-                     _cycles[id] = _cursors[id];
-                     return nullptr;
-                 }
+                _cycles[id] = _cursors[id];
+                return nullptr;
+            }
 
-                if (calls[idx].type == t && calls[idx].entity_id == id)
-                {
-                    _cycles[id] = idx;
-                    _curr_time = calls[idx].timestamp;
-                    return &calls[idx];
-                }
-                if (calls[idx].type != t && calls[idx].entity_id == id)
+            const auto idx = index.positions[next_position];
+            if (calls[idx].type != t)
+            {
+                _cycles[id] = _cursors[id];
+                return nullptr;
+            }
+
+            _cycles[id] = idx;
+            _curr_time = calls[idx].timestamp;
+            return &calls[idx];
+        }
+
+        void recording::wait_virtual_clock(int entity_id, double timestamp, const std::atomic<bool>& alive)
+        {
+            std::unique_lock<std::mutex> lock(_virtual_clock_mutex);
+            _virtual_clock_pending[entity_id] = timestamp;
+            _virtual_clock_cv.notify_all();
+
+            // the ties are broken by the entity id, so the order does not depend on the threads scheduling
+            auto is_earliest = [&]()
+            {
+                for (auto&& pending : _virtual_clock_pending)
                 {
-                    _cycles[id] = _cursors[id];
-                    return nullptr;
+                    if (pending.first != entity_id &&
+                        (pending.second < timestamp || (pending.second == timestamp && pending.first < entity_id)))
+                        return false;
                 }
-            }
-            return nullptr;
+                return true;
+            };
+            // there is no timeout, the replay stays deterministic however slow the other entities are
+            _virtual_clock_cv.wait(lock, [&]() { return !alive || is_earliest(); });
+        }
+
+        void recording::leave_virtual_clock(int entity_id)
+        {
+            std::lock_guard<std::mutex> lock(_virtual_clock_mutex);
+            if (_virtual_clock_pending.erase(entity_id))
+                _virtual_clock_cv.notify_all();
+        }
+
+        void recording::wake_virtual_clock()
+        {
+            std::lock_guard<std::mutex> lock(_virtual_clock_mutex);
+            _virtual_clock_cv.notify_all();
         }
 
         void record_device_watcher::start(device_changed_callback callback)
@@ -652,7 +1172,7 @@ namespace librealsense
 
         void record_uvc_device::probe_and_commit(stream_profile profile, frame_callback callback, int buffers)
         {
-            _owner->try_record([this, callback, profile](recording* rec, lookup_key k)
+            _owner->try_record([this, callback, profile, buffers](recording* rec, lookup_key k)
             {
                 _source->probe_and_commit(profile, [this, callback](stream_profile p, frame_object f, std::function<void()> continuation)
                 {
@@ -685,7 +1205,7 @@ namespace librealsense
                         c.param6 = static_cast<int>(f.metadata_size);
                         callback(p, f, continuation);
                     }, _entity_id, call_type::uvc_frame);
-                });
+                }, buffers);
 
                 vector<stream_profile> ps{ profile };
                 rec->save_stream_profiles(ps, k);
@@ -999,6 +1519,17 @@ namespace librealsense
             }, _entity_id, call_type::uvc_get_usb_specification);
         }
 
+        // the frames delivery settings are not part of the recording, the playback does not drop frames
+        void record_uvc_device::set_newest_frame_only(bool newest_only)
+        {
+            _source->set_newest_frame_only(newest_only);
+        }
+
+        uint64_t record_uvc_device::get_dropped_frames_count() const
+        {
+            return _source->get_dropped_frames_count();
+        }
+
         vector<uint8_t> record_usb_device::send_receive(const vector<uint8_t>& data, int timeout_ms, bool require_response)
         {
             return _owner->try_record([&](recording* rec, lookup_key k)
@@ -1168,17 +1699,23 @@ namespace librealsense
             return _device_watcher;
         }
 
-        playback_backend::playback_backend(const char* filename, const char* section, std::string min_api_version)
+        playback_backend::playback_backend(const char* filename, const char* section, std::string min_api_version, bool virtual_clock)
             : _device_watcher(new playback_device_watcher(0)),
             _rec(platform::recording::load(filename, section, _device_watcher, min_api_version))
         {
             LOG_DEBUG("Starting section " << section);
+            if (virtual_clock)
+            {
+                LOG_INFO("Playing section " << section << " on a virtual clock");
+                _rec->enable_virtual_clock();
+            }
         }
 
         playback_uvc_device::~playback_uvc_device()
         {
             assert(_alive);
             _alive = false;
+            _rec->wake_virtual_clock();
             _callback_thread.join();
         }
 
@@ -1424,6 +1961,7 @@ namespace librealsense
             if (_alive)
             {
                 _alive = false;
+                _rec->wake_virtual_clock();
                 _callback_thread.join();
             }
         }
@@ -1434,6 +1972,7 @@ namespace librealsense
 
             lock_guard<mutex> lock(_callback_mutex);
             _alive = false;
+            _rec->wake_virtual_clock();
             _callback_thread.join();
         }
 
@@ -1470,6 +2009,15 @@ namespace librealsense
         {
             while (_alive)
             {
+                if (_rec->is_virtual_clock())
+                {
+                    auto next = _rec->pick_next_entity_call(_entity_id);
+                    if (next && next->type == call_type::hid_frame)
+                        _rec->wait_virtual_clock(_entity_id, next->timestamp, _alive);
+                    else
+                        _rec->leave_virtual_clock(_entity_id);
+                }
+
                 auto c_ptr = _rec->cycle_calls(call_type::hid_frame, _entity_id);
                 if (c_ptr)
                 {
@@ -1487,9 +2035,12 @@ namespace librealsense
                     sd.sensor.name = sensor_name;
 
                     _callback(sd);
+                    if (_rec->is_virtual_clock())
+                        continue;
                 }
                 this_thread::sleep_for(chrono::milliseconds(1));
             }
+            _rec->leave_virtual_clock(_entity_id);
         }
 
         playback_hid_device::~playback_hid_device()
@@ -1534,74 +2085,98 @@ namespace librealsense
 
             while (_alive)
             {
-                auto c_ptr = _rec->pick_next_call(_entity_id);
+                auto virtual_clock = _rec->is_virtual_clock();
+                auto c_ptr = virtual_clock ? _rec->pick_next_entity_call(_entity_id) : _rec->pick_next_call(_entity_id);
 
                 if (c_ptr && c_ptr->type == call_type::uvc_frame)
                 {
-                    lock_guard<mutex> lock(_callback_mutex);
-                    for (auto&& pair : _callbacks)
+                    auto profile = get_profile(c_ptr);
+                    bool streaming = false;
                     {
-                        if(get_profile(c_ptr) == pair.first)
-                        {
-                            auto c_ptr = _rec->cycle_calls(call_type::uvc_frame, _entity_id);
+                        lock_guard<mutex> lock(_callback_mutex);
+                        for (auto&& pair : _callbacks)
+                            streaming |= (profile == pair.first);
+                    }
+                    // the wait is outside of the callbacks lock, so closing the stream does not wait for the clock.
+                    // the callbacks are looked up again after the wait, the stream may have been closed meanwhile
+                    if (virtual_clock)
+                    {
+                        if (streaming)
+                            _rec->wait_virtual_clock(_entity_id, c_ptr->timestamp, _alive);
+                        else
+                            _rec->leave_virtual_clock(_entity_id);
+                    }
 
-                            if (c_ptr)
+                    if (streaming)
+                    {
+                        lock_guard<mutex> lock(_callback_mutex);
+                        for (auto&& pair : _callbacks)
+                        {
+                            if(profile == pair.first)
                             {
-                                auto p = get_profile(c_ptr);
-                                if(p == pair.first)
-                                {
-                                    vector<uint8_t> frame_blob;
-                                    vector<uint8_t> metadata_blob;
+                                auto c_ptr = _rec->cycle_calls(call_type::uvc_frame, _entity_id);
 
-                                    if (prev_frame_ts > 0 &&
-                                        c_ptr->timestamp > prev_frame_ts &&
-                                        c_ptr->timestamp - prev_frame_ts <= 300)
-                                    {
-                                        prev_frame_ts = c_ptr->timestamp - prev_frame_ts;
-                                    }
-
-                                    prev_frame_ts = c_ptr->timestamp;
-
-                                    if (c_ptr->param3 == 0) // frame was not saved
-                                    {
-                                        frame_blob = vector<uint8_t>(c_ptr->param4, 0);
-                                    }
-                                    else if (c_ptr->param3 == 1)// frame was saved
-                                    {
-                                        frame_blob = _rec->load_blob(c_ptr->param2);
-                                    }
-                                    else
+                                if (c_ptr)
+                                {
+                                    auto p = get_profile(c_ptr);
+                                    if(p == pair.first)
                                     {
-                                        frame_blob = _compression.decode(_rec->load_blob(c_ptr->param2));
+                                        vector<uint8_t> frame_blob;
+                                        vector<uint8_t> metadata_blob;
+
+                                        if (prev_frame_ts > 0 &&
+                                            c_ptr->timestamp > prev_frame_ts &&
+                                            c_ptr->timestamp - prev_frame_ts <= 300)
+                                        {
+                                            prev_frame_ts = c_ptr->timestamp - prev_frame_ts;
+                                        }
+
+                                        prev_frame_ts = c_ptr->timestamp;
+
+                                        if (c_ptr->param3 == 0) // frame was not saved
+                                        {
+                                            frame_blob = vector<uint8_t>(c_ptr->param4, 0);
+                                        }
+                                        else if (c_ptr->param3 == 1)// frame was saved
+                                        {
+                                            frame_blob = _rec->load_blob(c_ptr->param2);
+                                        }
+                                        else
+                                        {
+                                            frame_blob = _compression.decode(_rec->load_blob(c_ptr->param2));
+                                        }
+
+                                        metadata_blob = _rec->load_blob(c_ptr->param5);
+                                        frame_object fo{ frame_blob.size(),
+                                                    static_cast<uint8_t>(metadata_blob.size()), // Metadata is limited to 0xff bytes by design
+                                                    frame_blob.data(),metadata_blob.data() };
+
+
+                                        pair.second(p, fo, []() {});
+
+                                        break;
                                     }
-
-                                    metadata_blob = _rec->load_blob(c_ptr->param5);
-                                    frame_object fo{ frame_blob.size(),
-                                                static_cast<uint8_t>(metadata_blob.size()), // Metadata is limited to 0xff bytes by design
-                                                frame_blob.data(),metadata_blob.data() };
-
-
-                                    pair.second(p, fo, []() {});
-
-                                    break;
                                 }
-                            }
-                            else
-                            {
-                                LOG_WARNING("Could not Cycle frames!");
+                                else
+                                {
+                                    LOG_WARNING("Could not Cycle frames!");
+                                }
+
                             }
 
                         }
-
                     }
                 }
                 else
                 {
+                    if (virtual_clock)
+                        _rec->leave_virtual_clock(_entity_id);
                     _rec->cycle_calls(call_type::uvc_frame, _entity_id);
                 }
                 // work around - Let the other threads of playback uvc devices pull their frames
                 this_thread::sleep_for(std::chrono::milliseconds(next_timeout_ms));
             }
+            _rec->leave_virtual_clock(_entity_id);
         }
 
     }
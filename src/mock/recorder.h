@@ -12,6 +12,8 @@
 #include <chrono>
 #include <atomic>
 #include <map>
+#include <fstream>
+#include <condition_variable>
 
 namespace librealsense
 {
@@ -104,6 +106,17 @@ namespace librealsense
             int entity_id;
             call_type type;
         };
+
+        // Positions of the calls of one kind in the recording, in order. The hint remembers the last lookup, so
+        // replaying the calls in order finds each next call in constant time.
+        struct call_positions
+        {
+            std::vector<size_t> positions;
+            size_t hint = 0;
+
+            // index in positions of the first call after the given position, positions.size() if there is none
+            size_t next_after(size_t position);
+        };
         class playback_device_watcher;
 
         class recording
@@ -112,8 +125,10 @@ namespace librealsense
             recording(std::shared_ptr<time_service> ts = nullptr, std::shared_ptr<playback_device_watcher> watcher = nullptr);
 
             double get_time();
+            // The format of the file is picked by its name, files ending with ".rsmock" use the binary log, others sqlite
             void save(const char* filename, const char* section, bool append = false) const;
             static std::shared_ptr<recording> load(const char* filename, const char* section, std::shared_ptr<playback_device_watcher> watcher = nullptr, std::string min_api_version = "");
+            static void convert(const char* source, const char* target, const char* section);
 
             int save_blob(const void* ptr, size_t size);
 
@@ -288,16 +303,27 @@ namespace librealsense
                 return load_list(hid_sensors, c);
             }
 
-            std::vector<uint8_t> load_blob(int id) const
-            {
-                return blobs[id];
-            }
+            std::vector<uint8_t> load_blob(int id) const;
+            size_t blobs_count() const { return _blob_file ? _blob_offsets.size() : blobs.size(); }
 
             call& find_call(call_type t, int entity_id, std::function<bool(const call& c)> history_match_validation = [](const call& c) {return true; });
             call* cycle_calls(call_type call_type, int id);
             call* pick_next_call(int id = 0);
+            call* pick_next_entity_call(int id);
             size_t size() const { return calls.size(); }
 
+            // With the virtual clock the playback devices deliver their frames one at a time, in the order of their
+            // recorded timestamps and without waiting between them
+            void enable_virtual_clock() { _virtual_clock = true; }
+            bool is_virtual_clock() const { return _virtual_clock; }
+            // blocks until the next frame of the entity is the earliest frame pending among the streaming entities,
+            // or until the entity is no longer alive
+            void wait_virtual_clock(int entity_id, double timestamp, const std::atomic<bool>& alive);
+            // the entity has no frame pending, the other entities don't wait for it
+            void leave_virtual_clock(int entity_id);
+            // the waiting entities check again whether they are alive
+            void wake_virtual_clock();
+
         private:
             std::vector<call> calls;
             std::vector<std::vector<uint8_t>> blobs;
@@ -311,15 +337,36 @@ namespace librealsense
 
             std::recursive_mutex _mutex;
             std::shared_ptr<time_service> _ts;
+            std::string _api_version;
+
+            // the blobs of a binary recording stay in the file and are read on demand
+            std::shared_ptr<std::ifstream> _blob_file;
+            std::vector<uint64_t> _blob_offsets;
+            mutable std::mutex _blob_file_mutex;
+
+            void save_binary(const char* filename, const char* section, bool append) const;
+            static std::shared_ptr<recording> load_binary(const char* filename, const char* section, std::shared_ptr<playback_device_watcher> watcher, std::string min_api_version);
 
             std::map<size_t, size_t> _cursors;
             std::map<size_t, size_t> _cycles;
 
+            // the calls by type and entity and by entity alone, built as the calls are looked up
+            std::map<std::pair<call_type, int>, call_positions> _calls_index;
+            std::map<int, call_positions> _entity_calls_index;
+            size_t _indexed_calls = 0;
+
+            void index_calls();
+
             double get_current_time();
 
             void invoke_device_changed_event();
 
             double _curr_time = 0;
+
+            std::atomic<bool> _virtual_clock{ false };
+            std::map<int, double> _virtual_clock_pending;
+            std::mutex _virtual_clock_mutex;
+            std::condition_variable _virtual_clock_cv;
         };
 
         class record_backend;
@@ -346,6 +393,8 @@ namespace librealsense
             void unlock() const override;
             std::string get_device_location() const override;
             usb_spec get_usb_specification() const override;
+            void set_newest_frame_only(bool newest_only) override;
+            uint64_t get_dropped_frames_count() const override;
 
             explicit record_uvc_device(
                 std::shared_ptr<uvc_device> source,
@@ -598,7 +647,7 @@ namespace librealsense
             std::shared_ptr<time_service> create_time_service() const override;
             std::shared_ptr<device_watcher> create_device_watcher() const override;
 
-            explicit playback_backend(const char* filename, const char* section, std::string min_api_version);
+            explicit playback_backend(const char* filename, const char* section, std::string min_api_version, bool virtual_clock = false);
         private:
 
             std::shared_ptr<playback_device_watcher> _device_watcher;
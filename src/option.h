@@ -12,6 +12,7 @@
 
 #include <chrono>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <cmath>
 #include <type_traits>
@@ -204,6 +205,30 @@ namespace librealsense
         std::function<void(float)> _on_set;
     };
 
+    // ptr_option whose value is written and read under a mutex of its owner, the owner reads the value under it too
+    template<class T>
+    class locked_ptr_option : public ptr_option<T>
+    {
+    public:
+        locked_ptr_option(std::mutex& mutex, T min, T max, T step, T def, T* value, const std::string& desc)
+            : ptr_option<T>(min, max, step, def, value, desc), _mutex(mutex) {}
+
+        void set(float value) override
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            ptr_option<T>::set(value);
+        }
+
+        float query() const override
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return ptr_option<T>::query();
+        }
+
+    private:
+        std::mutex& _mutex;
+    };
+
     class LRS_EXTENSION_API float_option : public option_base
     {
     public:
@@ -256,6 +281,21 @@ namespace librealsense
         using ptr = std::shared_ptr< bool_option >;
     };
 
+    class uvc_dropped_frames_option : public readonly_option
+    {
+    public:
+        explicit uvc_dropped_frames_option(std::shared_ptr<platform::uvc_device> device)
+            : _device(device) {}
+
+        float query() const override { return static_cast<float>(_device->get_dropped_frames_count()); }
+        option_range get_range() const override { return { 0, std::numeric_limits<float>::max(), 1, 0 }; }
+        bool is_enabled() const override { return true; }
+        const char* get_description() const override { return "Frames dropped at the driver boundary since the sensor was started"; }
+
+    private:
+        std::shared_ptr<platform::uvc_device> _device;
+    };
+
     class uvc_pu_option : public option
     {
     public:
@@ -5,6 +5,7 @@
 #include "ds5/ds5-motion.h"
 #include "synthetic-stream.h"
 #include "motion-transform.h"
+#include "context.h"
 
 namespace librealsense
 {
@@ -68,16 +69,49 @@ namespace librealsense
 
     rs2::frame motion_transform::process_frame(const rs2::frame_source& source, const rs2::frame& f)
     {
-        auto&& ret = functional_processing_block::process_frame(source, f);
-        correct_motion(&ret);
+        auto&& ret = prepare_frame(source, f);
+        auto stream = f.get_profile().stream_type();
+
+        // A batch of raw samples is converted into packed samples, the timestamps that follow them are kept at the end
+        auto samples = f.as<rs2::motion_frame>().get_samples_count();
+        auto timestamps_size = samples > 1 ? samples * sizeof(rs2_time_t) : 0;
+        if (samples < 1 || f.get_data_size() <= timestamps_size)
+            throw invalid_value_exception(to_string() << "Motion frame of " << f.get_data_size() << " bytes cannot hold " << samples << " samples");
+        auto source_stride = (f.get_data_size() - timestamps_size) / samples;
+        auto source_data = static_cast<const byte*>(f.get_data());
+        auto xyz = (float3*)(ret.get_data());
+
+        for (int i = 0; i < samples; i++)
+        {
+            byte* planes[1];
+            planes[0] = (byte*)(xyz + i);
+            process_function(planes, source_data + source_stride * i, 0, 0, 0, 0);
+            correct_motion(xyz + i, stream);
+        }
+
+        if (timestamps_size)
+            librealsense::copy((byte*)ret.get_data() + ret.get_data_size() - timestamps_size,
+                source_data + f.get_data_size() - timestamps_size, timestamps_size);
 
         return ret;
     }
 
-    void motion_transform::correct_motion(rs2::frame* f)
+    rs2::frame motion_transform::prepare_frame(const rs2::frame_source& source, const rs2::frame& f)
     {
-        auto xyz = (float3*)(f->get_data());
+        auto samples = f.as<rs2::motion_frame>().get_samples_count();
+        if (samples <= 1)
+            return functional_processing_block::prepare_frame(source, f);
+
+        // The packed samples and their timestamps are larger than the raw batch, so the frame is sized for them
+        init_profiles_info(&f);
+        auto profile = std::dynamic_pointer_cast<stream_profile_interface>(_target_stream_profile.get()->profile->shared_from_this());
+        auto res = source._source->source->allocate_motion_frame(profile, (frame_interface*)f.get(), _extension_type,
+            samples * (sizeof(float3) + sizeof(rs2_time_t)));
+        return rs2::frame((rs2_frame*)res);
+    }
 
+    void motion_transform::correct_motion(float3* xyz, rs2_stream s)
+    {
         // The IMU sensor orientation shall be aligned with depth sensor's coordinate system
         *xyz = _imu2depth_cs_alignment_matrix * (*xyz);
 
@@ -87,7 +121,6 @@ namespace librealsense
         {
             if ((_mm_correct_opt->query() > 0.f)) // TBD resolve duality of is_enabled/is_active
             {
-                auto&& s = f->get_profile().stream_type();
                 if (s == RS2_STREAM_ACCEL)
                     *xyz = (_accel_sensitivity * (*xyz)) - _accel_bias;
 
@@ -21,9 +21,10 @@ namespace librealsense
             std::shared_ptr<mm_calib_handler> mm_calib,
             std::shared_ptr<enable_motion_correction> mm_correct_opt);
         rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
+        rs2::frame prepare_frame(const rs2::frame_source& source, const rs2::frame& f) override;
 
     private:
-        void correct_motion(rs2::frame* f);
+        void correct_motion(float3* xyz, rs2_stream s);
 
         std::shared_ptr<enable_motion_correction> _mm_correct_opt = nullptr;
         float3x3            _accel_sensitivity;
@@ -29,7 +29,8 @@ namespace librealsense
 
         frame_interface* allocate_motion_frame(std::shared_ptr<stream_profile_interface> stream,
             frame_interface* original,
-            rs2_extension frame_type = RS2_EXTENSION_MOTION_FRAME) override;
+            rs2_extension frame_type = RS2_EXTENSION_MOTION_FRAME,
+            size_t new_size = 0) override;
 
         frame_interface* allocate_composite_frame(std::vector<frame_holder> frames) override;
 
@@ -839,6 +839,35 @@ rs2_metadata_type rs2_get_frame_metadata(const rs2_frame* frame, rs2_frame_metad
 }
 HANDLE_EXCEPTIONS_AND_RETURN(0, frame, frame_metadata)
 
+void rs2_get_frame_metadata_all(const rs2_frame* frame, rs2_metadata_type* values, int* supported, int count, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(frame);
+    VALIDATE_NOT_NULL(values);
+    VALIDATE_NOT_NULL(supported);
+    VALIDATE_RANGE(count, 0, rs2_frame_metadata_value::RS2_FRAME_METADATA_COUNT);
+
+    auto f = (frame_interface*)frame;
+    for (int i = 0; i < count; i++)
+    {
+        auto frame_metadata = static_cast<rs2_frame_metadata_value>(i);
+        values[i] = 0;
+        supported[i] = f->supports_frame_metadata(frame_metadata) ? 1 : 0;
+        if (supported[i])
+        {
+            // an attribute that fails to parse is reported as not supported instead of failing the others
+            try
+            {
+                values[i] = f->get_frame_metadata(frame_metadata);
+            }
+            catch (const std::exception&)
+            {
+                supported[i] = 0;
+            }
+        }
+    }
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, frame, values, supported, count)
+
 const char* rs2_get_notification_description(rs2_notification* notification, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(notification);
@@ -1199,6 +1228,17 @@ rs2_context* rs2_create_mock_context_versioned(int api_version, const char* file
 }
 HANDLE_EXCEPTIONS_AND_RETURN(nullptr, api_version, filename, section)
 
+rs2_context* rs2_create_mock_context_virtual_clock(int api_version, const char* filename, const char* section, const char* min_api_version, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(filename);
+    VALIDATE_NOT_NULL(section);
+    VALIDATE_NOT_NULL(min_api_version);
+    verify_version_compatibility(api_version);
+
+    return new rs2_context{ std::make_shared<librealsense::context>(librealsense::backend_type::playback, filename, section, RS2_RECORDING_MODE_COUNT, std::string(min_api_version), true) };
+}
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, api_version, filename, section)
+
 rs2_context* rs2_create_mock_context(int api_version, const char* filename, const char* section, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(filename);
@@ -1209,6 +1249,16 @@ rs2_context* rs2_create_mock_context(int api_version, const char* filename, cons
 }
 HANDLE_EXCEPTIONS_AND_RETURN(nullptr, api_version, filename, section)
 
+void rs2_convert_recording(const char* source, const char* target, const char* section, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(source);
+    VALIDATE_NOT_NULL(target);
+    VALIDATE_NOT_NULL(section);
+
+    librealsense::platform::recording::convert(source, target, section);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, source, target, section)
+
 void rs2_set_region_of_interest(const rs2_sensor* sensor, int min_x, int min_y, int max_x, int max_y, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(sensor);
@@ -1498,6 +1548,23 @@ rs2_device* rs2_context_add_device(rs2_context* ctx, const char* file, rs2_error
 }
 HANDLE_EXCEPTIONS_AND_RETURN(nullptr, ctx, file)
 
+rs2_device* rs2_context_add_device_from_files(rs2_context* ctx, const char** files, int files_count, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(ctx);
+    VALIDATE_NOT_NULL(files);
+    VALIDATE_RANGE(files_count, 1, std::numeric_limits<int>::max());
+
+    std::vector<std::string> file_names;
+    for (int i = 0; i < files_count; ++i)
+    {
+        VALIDATE_NOT_NULL(files[i]);
+        file_names.push_back(files[i]);
+    }
+    auto dev_info = ctx->ctx->add_device(file_names);
+    return new rs2_device{ ctx->ctx, dev_info, dev_info->create_device(false) };
+}
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, ctx, files, files_count)
+
 void rs2_context_add_software_device(rs2_context* ctx, rs2_device* dev, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(ctx);
@@ -1648,6 +1715,20 @@ rs2_device* rs2_create_record_device_ex(const rs2_device* device, const char* fi
 }
 HANDLE_EXCEPTIONS_AND_RETURN(nullptr, device, file)
 
+rs2_device* rs2_create_split_record_device(const rs2_device* device, const char* file, int compression_enabled, unsigned long long max_file_size, unsigned long long max_file_duration_ms, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_NOT_NULL(file);
+
+    auto writer = std::make_shared<ros_writer>(file, compression_enabled != 0, max_file_size, std::chrono::milliseconds(max_file_duration_ms));
+    return new rs2_device({
+        device->ctx,
+        device->info,
+        std::make_shared<record_device>(device->device, writer)
+        });
+}
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, device, file, max_file_size, max_file_duration_ms)
+
 void rs2_record_device_pause(const rs2_device* device, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(device);
@@ -2156,6 +2237,22 @@ int rs2_get_frame_points_count(const rs2_frame* frame, rs2_error** error) BEGIN_
 }
 HANDLE_EXCEPTIONS_AND_RETURN(0, frame)
 
+int rs2_get_motion_frame_samples_count(const rs2_frame* frame, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(frame);
+    auto mf = VALIDATE_INTERFACE((frame_interface*)frame, librealsense::motion_frame);
+    return mf->get_samples_count();
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, frame)
+
+const rs2_time_t* rs2_get_motion_frame_timestamps(const rs2_frame* frame, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(frame);
+    auto mf = VALIDATE_INTERFACE((frame_interface*)frame, librealsense::motion_frame);
+    return mf->get_samples_timestamps();
+}
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, frame)
+
 rs2_processing_block* rs2_create_pointcloud(rs2_error** error) BEGIN_API_CALL
 {
     return new rs2_processing_block { pointcloud::create() };
@@ -2405,6 +2502,26 @@ void rs2_software_sensor_on_video_frame(rs2_sensor* sensor, rs2_software_video_f
 }
 HANDLE_EXCEPTIONS_AND_RETURN(, sensor, frame.pixels)
 
+void rs2_software_sensor_on_video_frame_with_metadata(rs2_sensor* sensor, rs2_software_video_frame frame, const rs2_software_metadata* metadata, int metadata_count, rs2_error** error) BEGIN_API_CALL
+{
+    // the sensor releases the pixels once it gets the frame, a call rejected before that releases them here
+    librealsense::software_sensor* bs = nullptr;
+    try
+    {
+        VALIDATE_NOT_NULL(sensor);
+        VALIDATE_RANGE(metadata_count, 0, librealsense::software_sensor::max_metadata_count);
+        if (metadata_count > 0) VALIDATE_NOT_NULL(metadata);
+        bs = VALIDATE_INTERFACE(sensor->sensor, librealsense::software_sensor);
+    }
+    catch (...)
+    {
+        if (frame.deleter) frame.deleter(frame.pixels);
+        throw;
+    }
+    return bs->on_video_frame(frame, metadata, metadata_count);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, sensor, frame.pixels, metadata, metadata_count)
+
 void rs2_software_sensor_on_motion_frame(rs2_sensor* sensor, rs2_software_motion_frame frame, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(sensor);
@@ -16,6 +16,7 @@
 #include "proc/decimation-filter.h"
 #include "proc/depth-decompress.h"
 #include "global_timestamp_reader.h"
+#include "option.h"
 
 namespace librealsense
 {
@@ -306,6 +307,12 @@ namespace librealsense
 
         _source.init(_metadata_parsers);
         _source.set_sensor(_source_owner->shared_from_this());
+        int kernel_buffers;
+        {
+            std::lock_guard<std::mutex> streaming_lock(_streaming_options_lock);
+            kernel_buffers = _kernel_buffers;
+            _device->set_newest_frame_only(_newest_frame_only);
+        }
 
         std::vector<platform::stream_profile> commited;
 
@@ -378,7 +385,7 @@ namespace librealsense
                     {
                         _source.invoke_callback(std::move(fh));
                     }
-                });
+                }, kernel_buffers);
             }
             catch (...)
             {
@@ -647,10 +654,17 @@ namespace librealsense
         _hid_device(hid_device),
         _is_configured_stream(RS2_STREAM_COUNT),
         _hid_iio_timestamp_reader(move(hid_iio_timestamp_reader)),
-        _custom_hid_timestamp_reader(move(custom_hid_timestamp_reader))
+        _custom_hid_timestamp_reader(move(custom_hid_timestamp_reader)),
+        _motion_batch_size(1)
     {
         register_metadata(RS2_FRAME_METADATA_BACKEND_TIMESTAMP, make_additional_data_parser(&frame_additional_data::backend_timestamp));
 
+        // the option changes the batch size under _streaming_options_lock, start() reads it under it
+        auto batch_opt = std::make_shared<locked_ptr_option<int>>(_streaming_options_lock, 1, 128, 1, 1, &_motion_batch_size,
+            "Number of consecutive IMU samples delivered in a single motion frame, applied when the sensor is started");
+        _streaming_options = { { RS2_OPTION_MOTION_BATCH_SIZE, batch_opt } };
+        register_option(RS2_OPTION_MOTION_BATCH_SIZE, batch_opt);
+
         std::map<std::string, uint32_t> frequency_per_sensor;
         for (auto&& elem : sensor_name_and_hid_profiles)
             frequency_per_sensor.insert(make_pair(elem.first, elem.second.fps));
@@ -773,9 +787,16 @@ namespace librealsense
 
         unsigned long long last_frame_number = 0;
         rs2_time_t last_timestamp = 0;
+        int batch_size;
+        {
+            std::lock_guard<std::mutex> streaming_lock(_streaming_options_lock);
+            batch_size = _motion_batch_size;
+        }
+        // each stream is captured by a single backend thread, which is the only one touching its batch
+        auto batches = std::make_shared<std::vector<motion_batch>>(RS2_STREAM_COUNT);
         raise_on_before_streaming_changes(true); //Required to be just before actual start allow recording to work
 
-        _hid_device->start_capture([this, last_frame_number, last_timestamp](const platform::sensor_data& sensor_data) mutable
+        _hid_device->start_capture([this, last_frame_number, last_timestamp, batch_size, batches](const platform::sensor_data& sensor_data) mutable
         {
             const auto&& system_time = environment::get_instance().get_time_service()->get_time();
             auto timestamp_reader = _hid_iio_timestamp_reader.get();
@@ -827,12 +848,45 @@ namespace librealsense
 
             last_frame_number = frame_counter;
             last_timestamp = timestamp;
-            frame_holder frame = _source.alloc_frame(RS2_EXTENSION_MOTION_FRAME, data_size, fr->additional_data, true);
-            memcpy((void*)frame->get_frame_data(), fr->data.data(), sizeof(byte)*fr->data.size());
-            if (!frame)
+
+            frame_holder frame;
+            if (batch_size > 1 && !is_custom_sensor)
             {
-                LOG_INFO("Dropped frame. alloc_frame(...) returned nullptr");
-                return;
+                // The samples are stored 8-bytes aligned one after the other, followed by their timestamps.
+                // The batch is allocated with its first sample and carries the attributes of its last one
+                auto&& batch = (*batches)[request->get_stream_type()];
+                auto sample_stride = (data_size + 7) & ~size_t(7);
+                if (!batch.frame)
+                {
+                    batch.frame = _source.alloc_frame(RS2_EXTENSION_MOTION_FRAME, (sample_stride + sizeof(rs2_time_t)) * batch_size, fr->additional_data, true);
+                    if (!batch.frame)
+                    {
+                        LOG_INFO("Dropped frame. alloc_frame(...) returned nullptr");
+                        return;
+                    }
+                    batch.samples = 0;
+                }
+
+                auto batch_data = const_cast<byte*>(batch.frame->get_frame_data());
+                memcpy(batch_data + sample_stride * batch.samples, fr->data.data(), sizeof(byte)*fr->data.size());
+                reinterpret_cast<rs2_time_t*>(batch_data + sample_stride * batch_size)[batch.samples] = timestamp;
+                if (++batch.samples < batch_size)
+                    return;
+
+                auto&& batch_frame = static_cast<librealsense::frame*>(batch.frame.frame);
+                batch_frame->additional_data = fr->additional_data;
+                batch_frame->additional_data.motion_samples = batch_size;
+                frame = std::move(batch.frame);
+            }
+            else
+            {
+                frame = _source.alloc_frame(RS2_EXTENSION_MOTION_FRAME, data_size, fr->additional_data, true);
+                if (!frame)
+                {
+                    LOG_INFO("Dropped frame. alloc_frame(...) returned nullptr");
+                    return;
+                }
+                memcpy((void*)frame->get_frame_data(), fr->data.data(), sizeof(byte)*fr->data.size());
             }
             frame->set_stream(request);
             frame->set_timestamp_domain(timestamp_domain);
@@ -920,10 +974,64 @@ namespace librealsense
         : sensor_base(name, dev, (recommended_proccesing_blocks_interface*)this),
         _device(move(uvc_device)),
         _user_count(0),
-        _timestamp_reader(std::move(timestamp_reader))
+        _timestamp_reader(std::move(timestamp_reader)),
+        _kernel_buffers(DEFAULT_V4L2_FRAME_BUFFERS),
+        _newest_frame_only(false),
+        _streaming_profile(0)
     {
         register_metadata(RS2_FRAME_METADATA_BACKEND_TIMESTAMP, make_additional_data_parser(&frame_additional_data::backend_timestamp));
         register_metadata(RS2_FRAME_METADATA_RAW_FRAME_SIZE, make_additional_data_parser(&frame_additional_data::raw_size));
+        register_streaming_options();
+    }
+
+    void uvc_sensor::register_streaming_options()
+    {
+        // the options and their callbacks change the fields under _streaming_options_lock, open() reads them under it
+        auto buffers_opt = std::make_shared<locked_ptr_option<int>>(_streaming_options_lock, 2, 32, 1, DEFAULT_V4L2_FRAME_BUFFERS, &_kernel_buffers,
+            "Number of frame buffers queued to the driver, applied when the sensor is opened");
+        buffers_opt->on_set([this](float val)
+        {
+            _streaming_profile = 0;
+        });
+
+        auto newest_opt = std::make_shared<locked_ptr_option<bool>>(_streaming_options_lock, false, true, true, false, &_newest_frame_only,
+            "Deliver only the newest frame the driver has ready, releasing the stale ones unread");
+        newest_opt->on_set([this](float val)
+        {
+            _streaming_profile = 0;
+            _device->set_newest_frame_only(_newest_frame_only);
+        });
+
+        auto profile_opt = std::make_shared<locked_ptr_option<int>>(_streaming_options_lock, 0, 2, 1, 0, &_streaming_profile,
+            "Preset of the frame buffers and delivery");
+        profile_opt->set_description(0.f, "Custom");
+        profile_opt->set_description(1.f, "Low Latency");
+        profile_opt->set_description(2.f, "High Throughput");
+        profile_opt->on_set([this](float val)
+        {
+            if (fabs(val - 1.f) < 1e-6)
+            {
+                // Low Latency - the oldest frame delivered is at most one frame behind the sensor
+                _kernel_buffers = 2;
+                _newest_frame_only = true;
+            }
+            if (fabs(val - 2.f) < 1e-6)
+            {
+                // High Throughput - the driver can hold a burst while the callbacks are slow
+                _kernel_buffers = 16;
+                _newest_frame_only = false;
+            }
+            _device->set_newest_frame_only(_newest_frame_only);
+        });
+
+        auto dropped_opt = std::make_shared<uvc_dropped_frames_option>(_device);
+
+        _streaming_options = { { RS2_OPTION_KERNEL_FRAME_BUFFERS, buffers_opt },
+                               { RS2_OPTION_NEWEST_FRAME_ONLY, newest_opt },
+                               { RS2_OPTION_STREAMING_PROFILE, profile_opt },
+                               { RS2_OPTION_KERNEL_DROPPED_FRAMES, dropped_opt } };
+        for (auto&& opt : _streaming_options)
+            register_option(opt.first, opt.second);
     }
 
     iio_hid_timestamp_reader::iio_hid_timestamp_reader()
@@ -1016,6 +1124,18 @@ namespace librealsense
         const std::map<uint32_t, rs2_stream>& fourcc_to_rs2_stream_map)
         : sensor_base(name, device, (recommended_proccesing_blocks_interface*)this), _raw_sensor(std::move(sensor))
     {
+        // the streaming controls of the raw sensor are exposed on the sensor the user streams from
+        if (auto raw_uvc_sensor = As<uvc_sensor, sensor_base>(_raw_sensor))
+        {
+            for (auto&& opt : raw_uvc_sensor->get_streaming_options())
+                sensor_base::register_option(opt.first, opt.second);
+        }
+        if (auto raw_hid_sensor = As<hid_sensor, sensor_base>(_raw_sensor))
+        {
+            for (auto&& opt : raw_hid_sensor->get_streaming_options())
+                sensor_base::register_option(opt.first, opt.second);
+        }
+
         // synthetic sensor and its raw sensor will share the formats and streams mapping
         auto& raw_fourcc_to_rs2_format_map = _raw_sensor->get_fourcc_to_rs2_format_map();
         _fourcc_to_rs2_format = std::make_shared<std::map<uint32_t, rs2_format>>(fourcc_to_rs2_format_map);
@@ -291,10 +291,19 @@ namespace librealsense
                                                     const std::string& report_name,
                                                     platform::custom_sensor_report_field report_field) const;
 
+        const std::map<rs2_option, std::shared_ptr<option>>& get_streaming_options() const { return _streaming_options; }
+
     protected:
         stream_profiles init_stream_profiles() override;
 
     private:
+        // the samples of a stream collected into a single motion frame
+        struct motion_batch
+        {
+            frame_holder frame;
+            int samples = 0;
+        };
+
         const std::map<rs2_stream, uint32_t> stream_and_fourcc = {{RS2_STREAM_GYRO,  rs_fourcc('G','Y','R','O')},
                                                                   {RS2_STREAM_ACCEL, rs_fourcc('A','C','C','L')},
                                                                   {RS2_STREAM_GPIO,  rs_fourcc('G','P','I','O')}};
@@ -308,6 +317,9 @@ namespace librealsense
         std::vector<platform::hid_sensor> _hid_sensors;
         std::unique_ptr<frame_timestamp_reader> _hid_iio_timestamp_reader;
         std::unique_ptr<frame_timestamp_reader> _custom_hid_timestamp_reader;
+        int _motion_batch_size;
+        std::mutex _streaming_options_lock; // guards the batch size, set by the user while the sensor starts
+        std::map<rs2_option, std::shared_ptr<option>> _streaming_options;
 
         stream_profiles get_sensor_profiles(std::string sensor_name) const;
 
@@ -337,6 +349,7 @@ namespace librealsense
         std::shared_ptr<platform::uvc_device> get_uvc_device() { return _device; }
         platform::usb_spec get_usb_specification() const { return _device->get_usb_specification(); }
         std::string get_device_path() const { return _device->get_device_location(); }
+        const std::map<rs2_option, std::shared_ptr<option>>& get_streaming_options() const { return _streaming_options; }
 
         template<class T>
         auto invoke_powered(T action)
@@ -354,6 +367,7 @@ namespace librealsense
         void acquire_power();
         void release_power();
         void reset_streaming();
+        void register_streaming_options();
 
         struct power
         {
@@ -389,6 +403,11 @@ namespace librealsense
         std::vector<platform::extension_unit> _xus;
         std::unique_ptr<power> _power;
         std::unique_ptr<frame_timestamp_reader> _timestamp_reader;
+        std::mutex _streaming_options_lock; // guards the streaming options, set by the user while the sensor opens
+        int _kernel_buffers;
+        bool _newest_frame_only;
+        int _streaming_profile;
+        std::map<rs2_option, std::shared_ptr<option>> _streaming_options;
     };
 
     processing_blocks get_color_recommended_proccesing_blocks();
@@ -209,6 +209,10 @@ namespace librealsense
         else if (_is_opened)
             throw wrong_api_call_sequence_exception("open(...) failed. Software device is already opened!");
         _is_opened = true;
+        {
+            std::lock_guard<std::mutex> lock(_extrinsics_mutex);
+            _registered_streams.clear();
+        }
         set_active_streams(requests);
     }
 
@@ -248,38 +252,78 @@ namespace librealsense
     }
 
 
+    static void add_metadata(frame_additional_data& data, rs2_frame_metadata_value key, rs2_metadata_type value)
+    {
+        auto size_of_enum = sizeof(rs2_frame_metadata_value);
+        auto size_of_data = sizeof(rs2_metadata_type);
+        if (data.metadata_size + size_of_enum + size_of_data > 255)
+        {
+            return; //stop adding metadata to frame
+        }
+        memcpy(data.metadata_blob.data() + data.metadata_size, &key, size_of_enum);
+        data.metadata_size += static_cast<uint32_t>(size_of_enum);
+        memcpy(data.metadata_blob.data() + data.metadata_size, &value, size_of_data);
+        data.metadata_size += static_cast<uint32_t>(size_of_data);
+    }
+
     void software_sensor::set_metadata(rs2_frame_metadata_value key, rs2_metadata_type value)
     {
+        std::lock_guard<std::mutex> lock(_metadata_mutex);
+        if (_metadata_map.find(key) == _metadata_map.end() && _metadata_map.size() >= static_cast<size_t>(max_metadata_count))
+            throw invalid_value_exception(to_string() << "set_metadata(...) failed. A frame holds up to " << max_metadata_count << " metadata values");
         _metadata_map[key] = value;
     }
 
+    frame_additional_data software_sensor::create_frame_data(rs2_time_t timestamp, rs2_timestamp_domain domain, int frame_number)
+    {
+        frame_additional_data data;
+        data.timestamp = timestamp;
+        data.timestamp_domain = domain;
+        data.frame_number = frame_number;
+
+        data.metadata_size = 0;
+        std::lock_guard<std::mutex> lock(_metadata_mutex);
+        for (auto i : _metadata_map)
+        {
+            add_metadata(data, i.first, i.second);
+        }
+        return data;
+    }
+
     void software_sensor::on_video_frame(rs2_software_video_frame software_frame)
     {
         if (!_is_streaming) {
             software_frame.deleter(software_frame.pixels);
             return;
         }
-        
+
+        invoke_video_frame(software_frame, create_frame_data(software_frame.timestamp, software_frame.domain, software_frame.frame_number));
+    }
+
+    void software_sensor::on_video_frame(rs2_software_video_frame software_frame, const rs2_software_metadata* metadata, int metadata_count)
+    {
+        if (!_is_streaming) {
+            software_frame.deleter(software_frame.pixels);
+            return;
+        }
+
+        // the metadata come with the frame, so the sensor state is not touched and the frames of several
+        // streams can be injected concurrently
         frame_additional_data data;
         data.timestamp = software_frame.timestamp;
         data.timestamp_domain = software_frame.domain;
         data.frame_number = software_frame.frame_number;
-
         data.metadata_size = 0;
-        for (auto i : _metadata_map)
+        for (int i = 0; i < metadata_count; i++)
         {
-            auto size_of_enum = sizeof(rs2_frame_metadata_value);
-            auto size_of_data = sizeof(rs2_metadata_type);
-            if (data.metadata_size + size_of_enum + size_of_data > 255)
-            {
-                continue; //stop adding metadata to frame
-            }
-            memcpy(data.metadata_blob.data() + data.metadata_size, &i.first, size_of_enum);
-            data.metadata_size += static_cast<uint32_t>(size_of_enum);
-            memcpy(data.metadata_blob.data() + data.metadata_size, &i.second, size_of_data);
-            data.metadata_size += static_cast<uint32_t>(size_of_data);
+            add_metadata(data, metadata[i].key, metadata[i].value);
         }
 
+        invoke_video_frame(software_frame, data);
+    }
+
+    void software_sensor::invoke_video_frame(rs2_software_video_frame software_frame, const frame_additional_data& data)
+    {
         rs2_extension extension = software_frame.profile->profile->get_stream_type() == RS2_STREAM_DEPTH ?
             RS2_EXTENSION_DEPTH_FRAME : RS2_EXTENSION_VIDEO_FRAME;
 
@@ -287,6 +331,7 @@ namespace librealsense
         if (!frame)
         {
             LOG_WARNING("Dropped video frame. alloc_frame(...) returned nullptr");
+            software_frame.deleter(software_frame.pixels);
             return;
         }
         auto vid_profile = dynamic_cast<video_stream_profile_interface*>(software_frame.profile->profile);
@@ -296,10 +341,17 @@ namespace librealsense
         frame->set_stream(std::dynamic_pointer_cast<stream_profile_interface>(software_frame.profile->profile->shared_from_this()));
         frame->attach_continuation(frame_continuation{ [=]() {
             software_frame.deleter(software_frame.pixels);
-        }, software_frame.pixels });
+        }, software_frame.pixels, size_t(software_frame.stride) * vid_profile->get_height() });
 
-        auto sd = dynamic_cast<software_device*>(_owner);
-        sd->register_extrinsic(*vid_profile);
+        // the extrinsics group of a stream is resolved with its first frame, not with every frame
+        {
+            std::lock_guard<std::mutex> lock(_extrinsics_mutex);
+            if (_registered_streams.insert(vid_profile->get_unique_id()).second)
+            {
+                auto sd = dynamic_cast<software_device*>(_owner);
+                sd->register_extrinsic(*vid_profile);
+            }
+        }
         _source.invoke_callback(frame);
     }
 
@@ -307,21 +359,7 @@ namespace librealsense
     {
         if (!_is_streaming) return;
 
-        frame_additional_data data;
-        data.timestamp = software_frame.timestamp;
-        data.timestamp_domain = software_frame.domain;
-        data.frame_number = software_frame.frame_number;
-
-        data.metadata_size = 0;
-        for (auto i : _metadata_map)
-        {
-            auto size_of_enum = sizeof(rs2_frame_metadata_value);
-            auto size_of_data = sizeof(rs2_metadata_type);
-            memcpy(data.metadata_blob.data() + data.metadata_size, &i.first, size_of_enum);
-            data.metadata_size += static_cast<uint32_t>(size_of_enum);
-            memcpy(data.metadata_blob.data() + data.metadata_size, &i.second, size_of_data);
-            data.metadata_size += static_cast<uint32_t>(size_of_data);
-        }
+        auto data = create_frame_data(software_frame.timestamp, software_frame.domain, software_frame.frame_number);
 
         auto frame = _source.alloc_frame(RS2_EXTENSION_MOTION_FRAME, 0, data, false);
         if (!frame)
@@ -340,21 +378,7 @@ namespace librealsense
     {
         if (!_is_streaming) return;
 
-        frame_additional_data data;
-        data.timestamp = software_frame.timestamp;
-        data.timestamp_domain = software_frame.domain;
-        data.frame_number = software_frame.frame_number;
-
-        data.metadata_size = 0;
-        for (auto i : _metadata_map)
-        {
-            auto size_of_enum = sizeof(rs2_frame_metadata_value);
-            auto size_of_data = sizeof(rs2_metadata_type);
-            memcpy(data.metadata_blob.data() + data.metadata_size, &i.first, size_of_enum);
-            data.metadata_size += static_cast<uint32_t>(size_of_enum);
-            memcpy(data.metadata_blob.data() + data.metadata_size, &i.second, size_of_data);
-            data.metadata_size += static_cast<uint32_t>(size_of_data);
-        }
+        auto data = create_frame_data(software_frame.timestamp, software_frame.domain, software_frame.frame_number);
 
         auto frame = _source.alloc_frame(RS2_EXTENSION_POSE_FRAME, 0, data, false);
         if (!frame)
@@ -106,6 +106,7 @@ namespace librealsense
         void stop() override;
 
         void on_video_frame(rs2_software_video_frame frame);
+        void on_video_frame(rs2_software_video_frame frame, const rs2_software_metadata* metadata, int metadata_count);
         void on_motion_frame(rs2_software_motion_frame frame);
         void on_pose_frame(rs2_software_pose_frame frame);
         void on_notification(rs2_software_notification notif);
@@ -113,10 +114,19 @@ namespace librealsense
         void update_read_only_option(rs2_option option, float val);
         void add_option(rs2_option option, option_range range, bool is_writable);
         void set_metadata(rs2_frame_metadata_value key, rs2_metadata_type value);
+
+        // metadata values that fit in the metadata blob of a frame, each takes its key and its value
+        static const int max_metadata_count = MAX_META_DATA_SIZE / (sizeof(rs2_frame_metadata_value) + sizeof(rs2_metadata_type));
     private:
         friend class software_device;
+        frame_additional_data create_frame_data(rs2_time_t timestamp, rs2_timestamp_domain domain, int frame_number);
+        void invoke_video_frame(rs2_software_video_frame software_frame, const frame_additional_data& data);
+
         stream_profiles _profiles;
+        std::mutex _metadata_mutex;
         std::map<rs2_frame_metadata_value, rs2_metadata_type> _metadata_map;
+        std::mutex _extrinsics_mutex;
+        std::set<int> _registered_streams; // streams whose extrinsics group was resolved since the sensor was opened
         int _unique_id;
 
         class stereo_extension : public depth_stereo_sensor
@@ -411,6 +411,11 @@ namespace librealsense
             CASE(THERMAL_COMPENSATION)
             CASE(TRIGGER_CAMERA_ACCURACY_HEALTH)
             CASE(RESET_CAMERA_ACCURACY_HEALTH)
+            CASE(KERNEL_FRAME_BUFFERS)
+            CASE(NEWEST_FRAME_ONLY)
+            CASE(STREAMING_PROFILE)
+            CASE(KERNEL_DROPPED_FRAMES)
+            CASE(MOTION_BATCH_SIZE)
         default: assert(!is_valid(value)); return UNKNOWN_VALUE;
         }
 #undef CASE
@@ -42,6 +42,8 @@
 #include <utility>                          // For std::forward
 #include <limits>
 #include <iomanip>
+#include <array>
+#include <bitset>
 #include "backend.h"
 #include "concurrency.h"
 
@@ -1154,6 +1156,140 @@ namespace librealsense
         return (c0 << 24) | (c1 << 16) | (c2 << 8) | c3;
     }
 
+    // Map over the values of an enum. The keys below N are stored in an array indexed by the key, so looking one up is
+    // a bounds check and a load. The keys past N, e.g. the private options of the gl renderer, go to an ordered map.
+    // Iterates in the order of the keys, like std::map.
+    template<class Key, class T, int N>
+    class enum_map
+    {
+    public:
+        typedef std::pair<Key, T> value_type;
+
+    private:
+        typedef std::map<Key, value_type> sparse_map;
+
+        template<class Value, class SparseIt>
+        class basic_iterator
+        {
+        public:
+            basic_iterator(Value* dense, const std::bitset<N>* present, int index, SparseIt sparse)
+                : _dense(dense), _present(present), _index(index), _sparse(sparse)
+            {
+                skip_missing();
+            }
+
+            Value& operator*() const { return _index < N ? _dense[_index] : _sparse->second; }
+            Value* operator->() const { return &**this; }
+
+            basic_iterator& operator++()
+            {
+                if (_index < N)
+                {
+                    _index++;
+                    skip_missing();
+                }
+                else
+                {
+                    ++_sparse;
+                }
+                return *this;
+            }
+
+            bool operator==(const basic_iterator& other) const
+            {
+                return _index == other._index && (_index < N || _sparse == other._sparse);
+            }
+            bool operator!=(const basic_iterator& other) const { return !(*this == other); }
+
+        private:
+            void skip_missing()
+            {
+                while (_index < N && !(*_present)[_index])
+                    _index++;
+            }
+
+            Value* _dense;
+            const std::bitset<N>* _present;
+            int _index;
+            SparseIt _sparse;
+        };
+
+    public:
+        typedef basic_iterator<value_type, typename sparse_map::iterator> iterator;
+        typedef basic_iterator<const value_type, typename sparse_map::const_iterator> const_iterator;
+
+        iterator begin() { return iterator(_dense.data(), &_present, 0, _sparse.begin()); }
+        iterator end() { return iterator(_dense.data(), &_present, N, _sparse.end()); }
+        const_iterator begin() const { return const_iterator(_dense.data(), &_present, 0, _sparse.begin()); }
+        const_iterator end() const { return const_iterator(_dense.data(), &_present, N, _sparse.end()); }
+
+        iterator find(Key key)
+        {
+            auto index = static_cast<int>(key);
+            if (index >= 0 && index < N)
+                return _present[index] ? iterator(_dense.data(), &_present, index, _sparse.begin()) : end();
+            return iterator(_dense.data(), &_present, N, _sparse.find(key));
+        }
+
+        const_iterator find(Key key) const
+        {
+            auto index = static_cast<int>(key);
+            if (index >= 0 && index < N)
+                return _present[index] ? const_iterator(_dense.data(), &_present, index, _sparse.begin()) : end();
+            return const_iterator(_dense.data(), &_present, N, _sparse.find(key));
+        }
+
+        T& operator[](Key key)
+        {
+            auto index = static_cast<int>(key);
+            if (index >= 0 && index < N)
+            {
+                if (!_present[index])
+                {
+                    _present[index] = true;
+                    _dense[index] = value_type(key, T());
+                }
+                return _dense[index].second;
+            }
+
+            auto&& value = _sparse[key];
+            value.first = key;
+            return value.second;
+        }
+
+        std::pair<iterator, bool> insert(const value_type& value)
+        {
+            auto it = find(value.first);
+            if (it != end())
+                return std::make_pair(it, false);
+
+            (*this)[value.first] = value.second;
+            return std::make_pair(find(value.first), true);
+        }
+
+        size_t erase(Key key)
+        {
+            auto index = static_cast<int>(key);
+            if (index >= 0 && index < N)
+            {
+                if (!_present[index])
+                    return 0;
+                _present[index] = false;
+                _dense[index].second = T();
+                return 1;
+            }
+            return _sparse.erase(key);
+        }
+
+        size_t size() const { return _present.count() + _sparse.size(); }
+        bool empty() const { return size() == 0; }
+
+    private:
+        std::array<value_type, N> _dense;
+        std::bitset<N> _present;
+        sparse_map _sparse;
+    };
+
     template<class T, int C>
     class small_heap
     {
@@ -1223,6 +1359,12 @@ namespace librealsense
             keep_allocating = false;
         }
 
+        void start_allocation()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            keep_allocating = true;
+        }
+
         void wait_until_empty()
         {
             std::unique_lock<std::mutex> lock(mutex);
@@ -1440,6 +1582,7 @@ namespace librealsense
     {
         std::function<void()> continuation;
         const void* protected_data = nullptr;
+        size_t protected_size = 0;
 
         frame_continuation(const frame_continuation &) = delete;
         frame_continuation & operator=(const frame_continuation &) = delete;
@@ -1448,11 +1591,16 @@ namespace librealsense
 
         explicit frame_continuation(std::function<void()> continuation, const void* protected_data) : continuation(continuation), protected_data(protected_data) {}
 
+        // protected_size is the number of bytes the frame exposes from protected_data
+        explicit frame_continuation(std::function<void()> continuation, const void* protected_data, size_t protected_size)
+            : continuation(continuation), protected_data(protected_data), protected_size(protected_size) {}
+
 
-        frame_continuation(frame_continuation && other) : continuation(std::move(other.continuation)), protected_data(other.protected_data)
+        frame_continuation(frame_continuation && other) : continuation(std::move(other.continuation)), protected_data(other.protected_data), protected_size(other.protected_size)
         {
             other.continuation = []() {};
             other.protected_data = nullptr;
+            other.protected_size = 0;
         }
 
         void operator()()
@@ -1460,23 +1608,28 @@ namespace librealsense
             continuation();
             continuation = []() {};
             protected_data = nullptr;
+            protected_size = 0;
         }
 
         void reset()
         {
             protected_data = nullptr;
+            protected_size = 0;
             continuation = [](){};
         }
 
         const void* get_data() const { return protected_data; }
+        size_t get_size() const { return protected_size; }
 
         frame_continuation & operator=(frame_continuation && other)
         {
             continuation();
             protected_data = other.protected_data;
+            protected_size = other.protected_size;
             continuation = other.continuation;
             other.continuation = []() {};
             other.protected_data = nullptr;
+            other.protected_size = 0;
             return *this;
         }
 
@@ -161,7 +161,7 @@ namespace librealsense
             stop_stream_cleanup(profile, elem);
 
             if (!_profiles.empty())
-                _streamers.clear();
+                clear_streamers();
         }
 
         void rs_uvc_device::set_power_state(power_state state)
@@ -347,6 +347,15 @@ namespace librealsense
             return _usb_device->get_info().conn_spec; 
         }
 
+        uint64_t rs_uvc_device::get_dropped_frames_count() const
+        {
+            uint64_t dropped = 0;
+            std::lock_guard<std::mutex> lock(_streamers_mutex);
+            for(auto&& s : _streamers)
+                dropped += s->get_stats().dropped;
+            return dropped;
+        }
+
         // Translate between UVC 1.5 Spec and RS
         int32_t rs_uvc_device::rs2_value_translate(uvc_req_code action, rs2_option option,
                                                         int32_t value) const {
@@ -451,10 +460,17 @@ namespace librealsense
             if(sts != RS2_USB_STATUS_SUCCESS)
                 throw std::runtime_error("Failed to start streaming!");
 
-            uvc_streamer_context usc = { profile, callback, ctrl, _usb_device, _messenger, _usb_request_count };
+            auto&& pool = _streamer_pools[ctrl->bInterfaceNumber];
+            if (!pool)
+                pool = std::make_shared<uvc_streamer_pool>();
+
+            uvc_streamer_context usc = { profile, callback, ctrl, _usb_device, _messenger, _usb_request_count, pool };
 
             auto streamer = std::make_shared<uvc_streamer>(usc);
-            _streamers.push_back(streamer);
+            {
+                std::lock_guard<std::mutex> lock(_streamers_mutex);
+                _streamers.push_back(streamer);
+            }
 
            if(_streamers.size() == _profiles.size())
            {
@@ -685,9 +701,21 @@ namespace librealsense
                 throw std::runtime_error("failed to submit interrupt request, error: " + usb_status_to_string.at(sts));
         }
 
+        void rs_uvc_device::clear_streamers()
+        {
+            std::vector<std::shared_ptr<uvc_streamer>> streamers;
+            {
+                std::lock_guard<std::mutex> lock(_streamers_mutex);
+                streamers.swap(_streamers);
+            }
+            // the streamers are flushed when destroyed, outside of the lock
+        }
+
         void rs_uvc_device::close_uvc_device()
         {
-            _streamers.clear();
+            clear_streamers();
+            // the requests belong to the messenger of this power cycle
+            _streamer_pools.clear();
 
             if(_interrupt_request)
             {
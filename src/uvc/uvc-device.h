@@ -15,6 +15,7 @@
 #include "stdlib.h"
 #include <cstring>
 #include <string>
+#include <map>
 #include <chrono>
 #include <thread>
 
@@ -64,11 +65,13 @@ namespace librealsense
 
             virtual std::string get_device_location() const override;
             virtual usb_spec  get_usb_specification() const override;
+            virtual uint64_t get_dropped_frames_count() const override;
 
         private:
             friend class source_reader_callback;
 
             void close_uvc_device();
+            void clear_streamers();
 
             usb_status probe_stream_ctrl(const std::shared_ptr<uvc_stream_ctrl_t>& control);
             usb_status get_stream_ctrl_format_size(uvc_format_t format, const std::shared_ptr<uvc_stream_ctrl_t>& control);
@@ -108,6 +111,9 @@ namespace librealsense
             // uvc internal
             std::shared_ptr<uvc_parser>             _parser;
             std::vector<std::shared_ptr<uvc_streamer>> _streamers;
+            mutable std::mutex                      _streamers_mutex; // the dropped frames are counted from any thread
+            // the requests and the frames of each streaming interface outlive its streamers
+            std::map<int, std::shared_ptr<uvc_streamer_pool>> _streamer_pools;
         };
     }
 }
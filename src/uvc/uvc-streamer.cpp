@@ -7,6 +7,7 @@
 const int UVC_PAYLOAD_MAX_HEADER_LENGTH         = 1024;
 const int DEQUEUE_MILLISECONDS_TIMEOUT          = 50;
 const int ENDPOINT_RESET_MILLISECONDS_TIMEOUT   = 100;
+const int MAX_REQUESTS_DEPTH                    = 8;
 
 void cleanup_frame(backend_frame *ptr) {
     if (ptr) ptr->owner->deallocate(ptr);
@@ -29,7 +30,8 @@ namespace librealsense
 
             _action_dispatcher.start();
 
-            _watchdog_timeout = (1000.0 / _context.profile.fps) * 10;
+            _frame_period_ms = 1000.0 / _context.profile.fps;
+            _watchdog_timeout = _frame_period_ms * 10;
 
             init();
         }
@@ -70,22 +72,48 @@ namespace librealsense
             queue.enqueue(std::move(fp));
         }
 
-        void uvc_streamer::init()
+        void uvc_streamer::init_pool()
         {
-            _frames_archive = std::make_shared<backend_frames_archive>();
-            // Get all pointers from archive and initialize their content
-            std::vector<backend_frame *> frames;
-            for (auto i = 0; i < _frames_archive->CAPACITY; i++) {
-                auto ptr = _frames_archive->allocate();
-                ptr->pixels.resize(_read_buff_length, 0);
-                ptr->owner = _frames_archive.get();
-                frames.push_back(ptr);
+            _pool = _context.pool ? _context.pool : std::make_shared<uvc_streamer_pool>();
+            if (!_pool->frames_archive)
+                _pool->frames_archive = std::make_shared<backend_frames_archive>();
+            _frames_archive = _pool->frames_archive;
+            _frames_archive->start_allocation();
+
+            // The buffers of the frames and of the requests are exchanged on completion, so they all keep the read length
+            if (_pool->buffer_length != _read_buff_length)
+            {
+                std::vector<backend_frame *> frames;
+                for (auto i = 0; i < _frames_archive->CAPACITY; i++) {
+                    auto ptr = _frames_archive->allocate();
+                    ptr->pixels.resize(_read_buff_length, 0);
+                    ptr->owner = _frames_archive.get();
+                    frames.push_back(ptr);
+                }
+
+                for (auto ptr : frames) {
+                    _frames_archive->deallocate(ptr);
+                }
+
+                for (auto&& r : _pool->requests)
+                    r->set_buffer(std::vector<uint8_t>(_read_buff_length));
+                _pool->buffer_length = _read_buff_length;
             }
 
-            for (auto ptr : frames) {
-                _frames_archive->deallocate(ptr);
+            while (_pool->requests.size() < _context.request_count)
+            {
+                auto r = _context.messenger->create_request(_read_endpoint);
+                r->set_buffer(std::vector<uint8_t>(_read_buff_length));
+                _pool->requests.push_back(r);
             }
 
+            for (auto&& r : _pool->requests)
+                r->set_callback(_request_callback);
+            _idle_requests = _pool->requests;
+        }
+
+        void uvc_streamer::init()
+        {
             _publish_frame_thread = std::make_shared<active_object<>>([this](dispatcher::cancellable_timer cancellable_timer)
             {
                 backend_frame_ptr fp(nullptr, [](backend_frame *) {});
@@ -113,39 +141,122 @@ namespace librealsense
 
             _request_callback = std::make_shared<usb_request_callback>([this](platform::rs_usb_request r)
             {
-                _action_dispatcher.invoke([this, r](dispatcher::cancellable_timer)
+                auto completed = std::chrono::steady_clock::now();
+                on_request_done(r);
+                _action_dispatcher.invoke([this, r, completed](dispatcher::cancellable_timer)
                 {
-                    if(!_running)
-                      return;
-
-                    auto al = r->get_actual_length();
-                    // Relax the frame size constrain for compressed streams
-                    bool is_compressed = val_in_range(_context.profile.format, { 0x4d4a5047U , 0x5a313648U}); // MJPEG, Z16H
-                    if(al > 0L && ((al == r->get_buffer().data()[0] + _context.control->dwMaxVideoFrameSize) || is_compressed ))
-                    {
-                        auto f = backend_frame_ptr(_frames_archive->allocate(), &cleanup_frame);
-                        if(f)
-                        {
-                            _frame_arrived = true;
-                            _watchdog->kick();
-                            memcpy(f->pixels.data(), r->get_buffer().data(), r->get_buffer().size());
-                            uvc_process_bulk_payload(std::move(f), r->get_actual_length(), _queue);
-                        }
-                    }
-
-                    auto sts = _context.messenger->submit_request(r);
-                    if(sts != platform::RS2_USB_STATUS_SUCCESS)
-                        LOG_ERROR("failed to submit UVC request, error: " << sts);
+                    handle_request(r, completed);
                 });
             });
 
-            _requests = std::vector<rs_usb_request>(_context.request_count);
-            for(auto&& r : _requests)
+            init_pool();
+        }
+
+        bool uvc_streamer::submit(const rs_usb_request& r)
+        {
             {
-                r = _context.messenger->create_request(_read_endpoint);
-                r->set_buffer(std::vector<uint8_t>(_read_buff_length));
-                r->set_callback(_request_callback);
+                std::lock_guard<std::mutex> lock(_in_flight_mutex);
+                _in_flight.insert(r);
+            }
+            auto sts = _context.messenger->submit_request(r);
+            if(sts != platform::RS2_USB_STATUS_SUCCESS)
+            {
+                LOG_ERROR("failed to submit UVC request, error: " << sts);
+                on_request_done(r);
+                return false;
             }
+            return true;
+        }
+
+        void uvc_streamer::on_request_done(const rs_usb_request& r)
+        {
+            std::lock_guard<std::mutex> lock(_in_flight_mutex);
+            _in_flight.erase(r);
+            _in_flight_cv.notify_all();
+        }
+
+        void uvc_streamer::handle_request(const rs_usb_request& r, std::chrono::steady_clock::time_point completed)
+        {
+            if(!_running)
+                return;
+
+            auto al = r->get_actual_length();
+            bool delivered = false;
+            // Relax the frame size constrain for compressed streams
+            bool is_compressed = val_in_range(_context.profile.format, { 0x4d4a5047U , 0x5a313648U}); // MJPEG, Z16H
+            if(al > 0L && ((al == r->get_buffer().data()[0] + _context.control->dwMaxVideoFrameSize) || is_compressed ))
+            {
+                auto f = backend_frame_ptr(_frames_archive->allocate(), &cleanup_frame);
+                if(f)
+                {
+                    _frame_arrived = true;
+                    _watchdog->kick();
+                    // the frame takes the payload and the request is resubmitted with the frame's previous buffer
+                    r->swap_buffer(f->pixels);
+                    uvc_process_bulk_payload(std::move(f), al, _queue);
+                    delivered = true;
+                }
+            }
+
+            auto turnaround = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - completed).count();
+            {
+                std::lock_guard<std::mutex> lock(_stats_mutex);
+                _stats.completions++;
+                if (al > 0L && !delivered)
+                    _stats.dropped++;
+                _stats.turnaround_total_ms += turnaround;
+                _stats.turnaround_max_ms = std::max(_stats.turnaround_max_ms, turnaround);
+            }
+
+            auto depth_change = adapt_depth(turnaround);
+            if (depth_change < 0)
+            {
+                _idle_requests.push_back(r);
+                return;
+            }
+
+            submit(r);
+            for (; depth_change > 0; depth_change--)
+            {
+                if (_idle_requests.empty())
+                {
+                    auto extra = _context.messenger->create_request(_read_endpoint);
+                    extra->set_buffer(std::vector<uint8_t>(_read_buff_length));
+                    extra->set_callback(_request_callback);
+                    _pool->requests.push_back(extra);
+                    _idle_requests.push_back(extra);
+                }
+                auto extra = _idle_requests.back();
+                _idle_requests.pop_back();
+                submit(extra);
+            }
+        }
+
+        // The device drops a frame when no request is queued for it, which happens once the requests wait for their
+        // resubmission longer than the frames the other requests in flight cover. The depth follows the slowest
+        // turnaround: it grows as soon as it is needed and shrinks by one request a second while it is not.
+        int uvc_streamer::adapt_depth(double turnaround_ms)
+        {
+            _window_turnaround_ms = std::max(_window_turnaround_ms, turnaround_ms);
+            int required = static_cast<int>(std::ceil(_window_turnaround_ms / _frame_period_ms)) + 1;
+            required = std::min(std::max(required, static_cast<int>(_context.request_count)), MAX_REQUESTS_DEPTH);
+
+            std::lock_guard<std::mutex> lock(_stats_mutex);
+            int change = 0;
+            if (required > _stats.requests_depth)
+            {
+                change = required - _stats.requests_depth;
+            }
+            else if (++_window_frames >= _context.profile.fps)
+            {
+                if (required < _stats.requests_depth)
+                    change = -1;
+                _window_frames = 0;
+                _window_turnaround_ms = 0;
+            }
+            _stats.requests_depth += change;
+            _stats.max_requests_depth = std::max(_stats.max_requests_depth, _stats.requests_depth);
+            return change;
         }
 
         void uvc_streamer::start()
@@ -162,10 +273,16 @@ namespace librealsense
                     _running = true;
                 }
 
-                for(auto&& r : _requests)
                 {
-                    auto sts = _context.messenger->submit_request(r);
-                    if(sts != platform::RS2_USB_STATUS_SUCCESS)
+                    std::lock_guard<std::mutex> lock(_stats_mutex);
+                    _stats = uvc_streamer_stats();
+                    _stats.requests_depth = _stats.max_requests_depth = _context.request_count;
+                }
+                for(auto i = 0; i < _context.request_count; i++)
+                {
+                    auto r = _idle_requests.back();
+                    _idle_requests.pop_back();
+                    if(!submit(r))
                         throw std::runtime_error("failed to submit UVC request while start streaming");
                 }
 
@@ -181,18 +298,39 @@ namespace librealsense
                 if(!_running)
                     return;
 
-                _request_callback->cancel();
-
                 _watchdog->stop();
 
                 _frames_archive->stop_allocation();
 
                 _queue.clear();
 
-                for(auto&& r : _requests)
-                  _context.messenger->cancel_request(r);
+                std::set<rs_usb_request> in_flight;
+                {
+                    std::lock_guard<std::mutex> lock(_in_flight_mutex);
+                    in_flight = _in_flight;
+                }
+                for(auto&& r : in_flight)
+                    _context.messenger->cancel_request(r);
 
-                _requests.clear();
+                // the requests go back to the pool once the cancelled ones have completed
+                {
+                    std::unique_lock<std::mutex> lock(_in_flight_mutex);
+                    if (!_in_flight_cv.wait_for(lock, std::chrono::milliseconds(ENDPOINT_RESET_MILLISECONDS_TIMEOUT * 10), [this]() { return _in_flight.empty(); }))
+                    {
+                        LOG_WARNING(_in_flight.size() << " UVC requests were not cancelled in time, endpoint: " << (int)_read_endpoint->get_address());
+                        in_flight = _in_flight;
+                    }
+                    else
+                        in_flight.clear();
+                }
+                _request_callback->cancel();
+                // the next streamer allocates new requests in place of the ones that did not complete
+                for(auto&& r : in_flight)
+                {
+                    _pool->requests.erase(std::remove(_pool->requests.begin(), _pool->requests.end(), r), _pool->requests.end());
+                    _pool->abandoned_requests.push_back(r);
+                }
+                _idle_requests = _pool->requests;
 
                 _frames_archive->wait_until_empty();
 
@@ -200,6 +338,13 @@ namespace librealsense
 
                 _publish_frame_thread->stop();
 
+                auto stats = get_stats();
+                if (stats.completions)
+                    LOG_INFO("endpoint " << (int)_read_endpoint->get_address() << " requests turnaround avg "
+                        << stats.turnaround_total_ms / stats.completions << " ms, max " << stats.turnaround_max_ms
+                        << " ms, max depth " << stats.max_requests_depth << ", dropped " << stats.dropped
+                        << " of " << stats.completions << " payloads");
+
                 {
                     std::lock_guard<std::mutex> lock(_running_mutex);
                     _running = false;
@@ -243,5 +388,11 @@ namespace librealsense
             }
             return _frame_arrived;
         }
+
+        uvc_streamer_stats uvc_streamer::get_stats() const
+        {
+            std::lock_guard<std::mutex> lock(_stats_mutex);
+            return _stats;
+        }
     }
 }
@@ -10,6 +10,7 @@
 #include <cstring>
 #include <string>
 #include <chrono>
+#include <set>
 #include <thread>
 
 typedef void(uvc_frame_callback_t)(struct librealsense::platform::frame_object *frame, void *user_ptr);
@@ -18,6 +19,17 @@ namespace librealsense
 {
     namespace platform
     {
+        // The requests and the frame buffers of a streaming interface, kept by the device across its streamers
+        struct uvc_streamer_pool
+        {
+            std::vector<rs_usb_request> requests;
+            // requests that did not complete when their streamer stopped, the driver may still own them so they are
+            // never submitted again, they are released with the pool
+            std::vector<rs_usb_request> abandoned_requests;
+            std::shared_ptr<backend_frames_archive> frames_archive;
+            uint32_t buffer_length = 0;
+        };
+
         struct uvc_streamer_context
         {
             stream_profile profile;
@@ -25,7 +37,18 @@ namespace librealsense
             std::shared_ptr<uvc_stream_ctrl_t> control;
             rs_usb_device usb_device;
             rs_usb_messenger messenger;
-            uint8_t request_count;
+            uint8_t request_count;                  // the least number of requests in flight
+            std::shared_ptr<uvc_streamer_pool> pool;
+        };
+
+        struct uvc_streamer_stats
+        {
+            uint64_t completions = 0;
+            uint64_t dropped = 0;                   // payloads that were not delivered, corrupted or with no free frame
+            int requests_depth = 0;                 // requests in flight
+            int max_requests_depth = 0;
+            double turnaround_total_ms = 0;         // from the completion of a request to its resubmission
+            double turnaround_max_ms = 0;
         };
 
         class uvc_streamer
@@ -42,6 +65,7 @@ namespace librealsense
             void enable_user_callbacks() { _publish_frames = true; }
             void disable_user_callbacks() { _publish_frames = false; }
             bool wait_for_first_frame(uint32_t timeout_ms);
+            uvc_streamer_stats get_stats() const;
 
         private:
             std::mutex _running_mutex;
@@ -59,13 +83,30 @@ namespace librealsense
             uint32_t _read_buff_length;
             backend_frames_queue _queue;
             rs_usb_endpoint _read_endpoint;
-            std::vector<rs_usb_request> _requests;
+            std::shared_ptr<uvc_streamer_pool> _pool;
+            std::vector<rs_usb_request> _idle_requests;
             std::shared_ptr<backend_frames_archive> _frames_archive;
             std::shared_ptr<active_object<>> _publish_frame_thread;
             std::shared_ptr<platform::usb_request_callback> _request_callback;
 
+            // requests submitted and not completed yet
+            std::set<rs_usb_request> _in_flight;
+            std::mutex _in_flight_mutex;
+            std::condition_variable _in_flight_cv;
+
+            double _frame_period_ms;
+            double _window_turnaround_ms = 0;
+            int _window_frames = 0;
+            mutable std::mutex _stats_mutex;
+            uvc_streamer_stats _stats;
+
             void init();
             void flush();
+            void init_pool();
+            bool submit(const rs_usb_request& r);
+            void on_request_done(const rs_usb_request& r);
+            void handle_request(const rs_usb_request& r, std::chrono::steady_clock::time_point completed);
+            int adapt_depth(double turnaround_ms);
         };
     }
 }
@@ -5,7 +5,7 @@
 #ifndef STD_MSGS_MESSAGE_UINT64_H
 #define STD_MSGS_MESSAGE_UINT64_H
 
-
+#include <memory>
 #include <string>
 #include <vector>
 #include <map>
@@ -39,15 +39,15 @@ struct UInt64_
 
 
 
-  typedef boost::shared_ptr< ::std_msgs::UInt64_<ContainerAllocator> > Ptr;
-  typedef boost::shared_ptr< ::std_msgs::UInt64_<ContainerAllocator> const> ConstPtr;
+  typedef std::shared_ptr< ::std_msgs::UInt64_<ContainerAllocator> > Ptr;
+  typedef std::shared_ptr< ::std_msgs::UInt64_<ContainerAllocator> const> ConstPtr;
 
 }; // struct UInt64_
 
 typedef ::std_msgs::UInt64_<std::allocator<void> > UInt64;
 
-typedef boost::shared_ptr< ::std_msgs::UInt64 > UInt64Ptr;
-typedef boost::shared_ptr< ::std_msgs::UInt64 const> UInt64ConstPtr;
+typedef std::shared_ptr< ::std_msgs::UInt64 > UInt64Ptr;
+typedef std::shared_ptr< ::std_msgs::UInt64 const> UInt64ConstPtr;
 
 // constants requiring out of line definition
 
@@ -223,6 +223,7 @@ private:
 
     rs2rosinternal::Header readMessageDataHeader(IndexEntry const& index_entry);
     uint32_t    readMessageDataSize(IndexEntry const& index_entry) const;
+    bool        readUncompressedMessageRecordPosition(IndexEntry const& index_entry, uint64_t& record_pos) const;
 
     template<typename Stream>
     void readMessageDataIntoStream(IndexEntry const& index_entry, Stream& stream) const;
@@ -310,6 +311,8 @@ private:
     mutable Buffer*  current_buffer_;
 
     mutable uint64_t decompressed_chunk_;      //!< position of decompressed chunk
+    mutable uint64_t located_chunk_;           //!< position of the chunk last located by readUncompressedMessageRecordPosition
+    mutable uint64_t located_chunk_data_pos_;  //!< position of the data of that chunk, 0 if it is compressed
 };
 
 } // namespace rosbag
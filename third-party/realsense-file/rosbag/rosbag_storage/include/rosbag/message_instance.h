@@ -93,6 +93,13 @@ public:
     //! Size of serialized message
     uint32_t size() const;
 
+    //! Locate the message data record in the bag file
+    /*!
+     * returns false if the message is not stored in an uncompressed chunk of the file,
+     * otherwise record_pos is the absolute file offset of the message data record, i.e. of its header length
+     */
+    bool getUncompressedRecordPosition(uint64_t& record_pos) const;
+
 private:
     MessageInstance(ConnectionInfo const* connection_info, IndexEntry const& index, Bag const& bag);
 
@@ -73,7 +73,9 @@ Bag::Bag() :
     chunk_open_(false),
     curr_chunk_data_pos_(0),
     current_buffer_(0),
-    decompressed_chunk_(0)
+    decompressed_chunk_(0),
+    located_chunk_(0),
+    located_chunk_data_pos_(0)
 {
 }
 
@@ -89,7 +91,9 @@ Bag::Bag(string const& filename, uint32_t mode) :
     chunk_open_(false),
     curr_chunk_data_pos_(0),
     current_buffer_(0),
-    decompressed_chunk_(0)
+    decompressed_chunk_(0),
+    located_chunk_(0),
+    located_chunk_data_pos_(0)
 {
     open(filename, mode);
 }
@@ -119,6 +123,7 @@ void Bag::open(string const& filename, uint32_t mode) {
 
 void Bag::openRead(string const& filename) {
     file_.openRead(filename);
+    located_chunk_ = 0;
 
     readVersion();
 
@@ -921,6 +926,28 @@ uint32_t Bag::readMessageDataSize(IndexEntry const& index_entry) const {
     }
 }
 
+bool Bag::readUncompressedMessageRecordPosition(IndexEntry const& index_entry, uint64_t& record_pos) const {
+    // Only version 2.0 bags store messages in chunks, and the chunk being written is not on disk yet
+    if (version_ != 200 || curr_chunk_info_.pos == index_entry.chunk_pos)
+        return false;
+
+    // The messages of a chunk are read one after the other, so its header is read once for all of them
+    if (located_chunk_ != index_entry.chunk_pos) {
+        seek(index_entry.chunk_pos);
+
+        ChunkHeader chunk_header;
+        readChunkHeader(chunk_header);
+        located_chunk_ = index_entry.chunk_pos;
+        located_chunk_data_pos_ = chunk_header.compression == COMPRESSION_NONE ? file_.getOffset() : 0;
+    }
+    if (located_chunk_data_pos_ == 0)
+        return false;
+
+    // The chunk data follows its header
+    record_pos = located_chunk_data_pos_ + index_entry.offset;
+    return true;
+}
+
 void Bag::writeChunkInfoRecords() {
     foreach(ChunkInfo const& chunk_info, chunks_) {
         // Write the chunk info header
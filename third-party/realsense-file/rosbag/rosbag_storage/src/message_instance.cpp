@@ -62,4 +62,8 @@ uint32_t MessageInstance::size() const {
     return bag_->readMessageDataSize(index_entry_);
 }
 
+bool MessageInstance::getUncompressedRecordPosition(uint64_t& record_pos) const {
+    return bag_->readUncompressedMessageRecordPosition(index_entry_, record_pos);
+}
+
 } // namespace rosbag
@@ -0,0 +1,500 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include <librealsense2/rs.hpp>
+#include <librealsense2-net/rs_net.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <limits.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "tclap/CmdLine.h"
+
+using namespace TCLAP;
+
+// A streaming mode of the server and the rs-server flags that select it
+struct mode
+{
+    std::string name;
+    std::vector<std::string> flags;
+};
+
+static const std::vector<mode> all_modes = {
+    { "raw", {} },
+    { "compressed", { "-c" } },
+    { "adaptive", { "-c", "-a" } },
+    { "shm", { "-s" } },
+};
+
+struct stream_result
+{
+    std::string name;
+    double fps = 0;
+    double latency_p50_ms = 0;
+    double latency_p99_ms = 0;
+};
+
+struct mode_result
+{
+    std::string name;
+    std::vector<stream_result> streams;
+    double wire_mbps = 0;
+    double server_cpu = 0;
+    double client_cpu = 0;
+};
+
+struct stream_stats
+{
+    unsigned long long frames = 0;
+    std::vector<double> latencies_ms;
+};
+
+static double system_time_ms()
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// Bytes received by the loopback interface, every byte sent between the server and the client on this host
+static unsigned long long loopback_bytes()
+{
+    std::ifstream net_dev("/proc/net/dev");
+    std::string line;
+    while (std::getline(net_dev, line))
+    {
+        auto colon = line.find(':');
+        if (colon == std::string::npos) continue;
+        std::string name = line.substr(0, colon);
+        name.erase(0, name.find_first_not_of(' '));
+        if (name != "lo") continue;
+
+        std::istringstream fields(line.substr(colon + 1));
+        unsigned long long rx_bytes = 0;
+        fields >> rx_bytes;
+        return rx_bytes;
+    }
+    return 0;
+}
+
+// CPU time of a process in seconds, all its threads included
+static double process_cpu_seconds(pid_t pid)
+{
+    std::ifstream stat("/proc/" + std::to_string(pid) + "/stat");
+    std::string content((std::istreambuf_iterator<char>(stat)), std::istreambuf_iterator<char>());
+    // the process name may contain spaces, the fields are counted from its closing parenthesis
+    auto name_end = content.rfind(')');
+    if (name_end == std::string::npos) return 0;
+
+    std::istringstream fields(content.substr(name_end + 2));
+    std::string field;
+    unsigned long long utime = 0, stime = 0;
+    // utime and stime are the fields 14 and 15 of the stat file, the state (field 3) is the first after the name
+    for (int i = 3; i <= 15 && fields >> field; i++)
+    {
+        if (i == 14) utime = std::stoull(field);
+        if (i == 15) stime = std::stoull(field);
+    }
+    return double(utime + stime) / sysconf(_SC_CLK_TCK);
+}
+
+static double self_cpu_seconds()
+{
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+static double percentile(std::vector<double> values, double p)
+{
+    if (values.empty()) return 0;
+    std::sort(values.begin(), values.end());
+    return values[size_t(p * (values.size() - 1))];
+}
+
+static std::string default_server_path()
+{
+    char path[PATH_MAX] = {};
+    if (readlink("/proc/self/exe", path, sizeof(path) - 1) > 0)
+    {
+        std::string dir(path);
+        dir = dir.substr(0, dir.rfind('/'));
+        std::string server = dir + "/rs-server";
+        if (access(server.c_str(), X_OK) == 0) return server;
+    }
+    return "rs-server";
+}
+
+static pid_t start_server(const std::string& server_path, unsigned int port, const mode& m)
+{
+    std::vector<std::string> args = { server_path, "--synthetic", "-p", std::to_string(port) };
+    args.insert(args.end(), m.flags.begin(), m.flags.end());
+
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        std::vector<char*> argv;
+        for (auto& arg : args) argv.push_back(&arg[0]);
+        argv.push_back(nullptr);
+        // the server output would be mixed with the report
+        freopen("/dev/null", "w", stdout);
+        execvp(argv[0], argv.data());
+        std::cerr << "Failed to run " << server_path << std::endl;
+        _exit(EXIT_FAILURE);
+    }
+    if (pid < 0) throw std::runtime_error("Failed to start the server");
+    return pid;
+}
+
+static void stop_server(pid_t pid)
+{
+    kill(pid, SIGINT);
+    for (int i = 0; i < 50; i++)
+    {
+        if (waitpid(pid, nullptr, WNOHANG) == pid) return;
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    kill(pid, SIGKILL);
+    waitpid(pid, nullptr, 0);
+}
+
+static rs2::device connect(const std::string& address, pid_t server, std::chrono::seconds timeout)
+{
+    auto start = std::chrono::steady_clock::now();
+    while (true)
+    {
+        try
+        {
+            return rs2::net_device(address);
+        }
+        catch (const rs2::error&)
+        {
+            if (waitpid(server, nullptr, WNOHANG) == server)
+                throw std::runtime_error("The server exited before accepting connections");
+            if (std::chrono::steady_clock::now() - start > timeout)
+                throw std::runtime_error("Failed to connect to the server at " + address);
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        }
+    }
+}
+
+static mode_result run_mode(const mode& m, const std::string& server_path, unsigned int port,
+    int width, int height, int fps, int warmup, int duration)
+{
+    mode_result result;
+    result.name = m.name;
+
+    pid_t server = start_server(server_path, port, m);
+    try
+    {
+        rs2::device dev = connect("127.0.0.1:" + std::to_string(port), server, std::chrono::seconds(20));
+
+        std::mutex stats_mutex;
+        std::map<std::string, stream_stats> stats;
+        std::atomic<bool> measuring(false);
+
+        // the depth and the color streams of the requested resolution and rate
+        std::vector<rs2::sensor> sensors;
+        for (auto&& sensor : dev.query_sensors())
+        {
+            for (auto&& profile : sensor.get_stream_profiles())
+            {
+                auto video = profile.as<rs2::video_stream_profile>();
+                if (!video || video.width() != width || video.height() != height || video.fps() != fps) continue;
+                if ((video.stream_type() == RS2_STREAM_DEPTH && video.format() == RS2_FORMAT_Z16) ||
+                    (video.stream_type() == RS2_STREAM_COLOR && video.format() == RS2_FORMAT_RGB8))
+                {
+                    stats[video.stream_name()];
+                    sensor.open(video);
+                    sensors.push_back(sensor);
+                    break;
+                }
+            }
+        }
+        if (sensors.empty())
+            throw std::runtime_error("The server has no " + std::to_string(width) + "x" + std::to_string(height) + "@" + std::to_string(fps) + " depth or color stream");
+
+        for (auto&& sensor : sensors)
+        {
+            sensor.start([&](rs2::frame f)
+            {
+                double now = system_time_ms();
+                if (!measuring) return;
+                std::lock_guard<std::mutex> lock(stats_mutex);
+                auto& stream = stats[f.get_profile().stream_name()];
+                stream.frames++;
+                // the server stamps the frames with its system time when they are generated
+                if (f.get_frame_timestamp_domain() == RS2_TIMESTAMP_DOMAIN_SYSTEM_TIME)
+                    stream.latencies_ms.push_back(now - f.get_timestamp());
+            });
+        }
+
+        std::this_thread::sleep_for(std::chrono::seconds(warmup));
+
+        auto wire_start = loopback_bytes();
+        auto server_cpu_start = process_cpu_seconds(server);
+        auto client_cpu_start = self_cpu_seconds();
+        auto start = std::chrono::steady_clock::now();
+        measuring = true;
+
+        std::this_thread::sleep_for(std::chrono::seconds(duration));
+
+        measuring = false;
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        result.wire_mbps = (loopback_bytes() - wire_start) * 8 / elapsed / 1e6;
+        result.server_cpu = (process_cpu_seconds(server) - server_cpu_start) / elapsed * 100;
+        result.client_cpu = (self_cpu_seconds() - client_cpu_start) / elapsed * 100;
+
+        for (auto&& sensor : sensors)
+        {
+            sensor.stop();
+            sensor.close();
+        }
+
+        std::lock_guard<std::mutex> lock(stats_mutex);
+        for (auto&& stream : stats)
+        {
+            stream_result s;
+            s.name = stream.first;
+            s.fps = stream.second.frames / elapsed;
+            s.latency_p50_ms = percentile(stream.second.latencies_ms, 0.5);
+            s.latency_p99_ms = percentile(stream.second.latencies_ms, 0.99);
+            result.streams.push_back(s);
+        }
+    }
+    catch (...)
+    {
+        stop_server(server);
+        throw;
+    }
+    stop_server(server);
+    return result;
+}
+
+// Records the arrival time of every frame a client receives
+class arrivals
+{
+public:
+    void add()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _times.push_back(std::chrono::steady_clock::now());
+    }
+
+    size_t count_since(std::chrono::steady_clock::time_point start)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return std::count_if(_times.begin(), _times.end(), [&](std::chrono::steady_clock::time_point t) { return t >= start; });
+    }
+
+    // the longest time without a frame between start and now
+    double max_gap_ms(std::chrono::steady_clock::time_point start)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto previous = start;
+        double gap = 0;
+        for (auto t : _times)
+        {
+            if (t < start) continue;
+            gap = std::max(gap, std::chrono::duration<double, std::milli>(t - previous).count());
+            previous = t;
+        }
+        return std::max(gap, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - previous).count());
+    }
+
+private:
+    std::mutex _mutex;
+    std::vector<std::chrono::steady_clock::time_point> _times;
+};
+
+static rs2::video_stream_profile find_profile(rs2::sensor sensor, rs2_stream stream, rs2_format format, int width, int height, int fps)
+{
+    for (auto&& profile : sensor.get_stream_profiles())
+    {
+        auto video = profile.as<rs2::video_stream_profile>();
+        if (video && video.stream_type() == stream && video.format() == format && video.width() == width && video.height() == height && video.fps() == fps)
+            return video;
+    }
+    throw std::runtime_error("The server has no " + std::to_string(width) + "x" + std::to_string(height) + "@" + std::to_string(fps) + " " + rs2_stream_to_string(stream) + " stream");
+}
+
+static rs2::sensor find_sensor(rs2::device dev, rs2_stream stream)
+{
+    for (auto&& sensor : dev.query_sensors())
+    {
+        for (auto&& profile : sensor.get_stream_profiles())
+            if (profile.stream_type() == stream) return sensor;
+    }
+    throw std::runtime_error(std::string("The server has no ") + rs2_stream_to_string(stream) + " sensor");
+}
+
+// Two clients share the depth sensor of the server. The second client first joins the depth stream the first one plays,
+// which must not interrupt it, then adds the infrared stream, which reopens the sensor with both streams.
+// Returns false when a client stops receiving frames or the join interrupts the first client
+static bool run_sessions(const std::string& server_path, unsigned int port, int width, int height, int fps, int warmup)
+{
+    const double join_max_gap_ms = 10 * 1000.0 / fps;
+    const auto phase = std::chrono::seconds(2);
+    bool passed = true;
+
+    pid_t server = start_server(server_path, port, all_modes.front());
+    try
+    {
+        auto address = "127.0.0.1:" + std::to_string(port);
+        rs2::device first = connect(address, server, std::chrono::seconds(20));
+        rs2::device second = connect(address, server, std::chrono::seconds(20));
+        auto first_sensor = find_sensor(first, RS2_STREAM_DEPTH);
+        auto second_sensor = find_sensor(second, RS2_STREAM_DEPTH);
+
+        arrivals first_frames, second_frames;
+        first_sensor.open(find_profile(first_sensor, RS2_STREAM_DEPTH, RS2_FORMAT_Z16, width, height, fps));
+        first_sensor.start([&](rs2::frame) { first_frames.add(); });
+        std::this_thread::sleep_for(std::chrono::seconds(warmup));
+
+        auto join = std::chrono::steady_clock::now();
+        second_sensor.open(find_profile(second_sensor, RS2_STREAM_DEPTH, RS2_FORMAT_Z16, width, height, fps));
+        second_sensor.start([&](rs2::frame) { second_frames.add(); });
+        std::this_thread::sleep_for(phase);
+        double join_gap_ms = first_frames.max_gap_ms(join);
+        bool joined = first_frames.count_since(join) > 0 && second_frames.count_since(join) > 0;
+        second_sensor.stop();
+        second_sensor.close();
+
+        auto add = std::chrono::steady_clock::now();
+        second_sensor.open(find_profile(second_sensor, RS2_STREAM_INFRARED, RS2_FORMAT_Y8, width, height, fps));
+        second_sensor.start([&](rs2::frame) { second_frames.add(); });
+        std::this_thread::sleep_for(phase);
+        double add_gap_ms = first_frames.max_gap_ms(add);
+        bool added = first_frames.count_since(add) > 0 && second_frames.count_since(add) > 0;
+        second_sensor.stop();
+        second_sensor.close();
+        first_sensor.stop();
+        first_sensor.close();
+
+        std::cout << std::fixed << std::setprecision(1) << "sessions: first client gap " << join_gap_ms << " ms when the second joins its stream, "
+            << add_gap_ms << " ms when the second adds a stream" << std::endl;
+        if (!joined || !added)
+        {
+            std::cerr << "A client stopped receiving frames while the streams were shared" << std::endl;
+            passed = false;
+        }
+        if (join_gap_ms > join_max_gap_ms)
+        {
+            std::cerr << "The first client was interrupted when the second joined a running stream" << std::endl;
+            passed = false;
+        }
+    }
+    catch (...)
+    {
+        stop_server(server);
+        throw;
+    }
+    stop_server(server);
+    return passed;
+}
+
+int main(int argc, char * argv[]) try
+{
+    CmdLine cmd("librealsense rs-net-benchmark tool", ' ', RS2_API_VERSION_STR);
+
+    ValueArg<std::string> server_arg("s", "server", "Path of the rs-server executable", false, default_server_path(), "path");
+    ValueArg<std::string> modes_arg("m", "modes", "Comma separated modes to measure: raw, compressed, adaptive, shm", false, "raw,compressed,adaptive,shm", "list");
+    ValueArg<unsigned int> port_arg("p", "port", "RTSP port of the server", false, 18554, "integer");
+    ValueArg<int> time_arg("t", "time", "Seconds to measure each mode", false, 10, "integer");
+    ValueArg<int> warmup_arg("w", "warmup", "Seconds to stream before measuring", false, 2, "integer");
+    ValueArg<int> width_arg("W", "width", "Width of the streams", false, 640, "integer");
+    ValueArg<int> height_arg("H", "height", "Height of the streams", false, 480, "integer");
+    ValueArg<int> fps_arg("r", "fps", "Frame rate of the streams", false, 30, "integer");
+    ValueArg<std::string> csv_arg("o", "csv", "Write the results to a CSV file", false, "", "path");
+    SwitchArg sessions_arg("S", "sessions", "Also check that two clients share the depth sensor of the server");
+
+    cmd.add(server_arg);
+    cmd.add(modes_arg);
+    cmd.add(port_arg);
+    cmd.add(time_arg);
+    cmd.add(warmup_arg);
+    cmd.add(width_arg);
+    cmd.add(height_arg);
+    cmd.add(fps_arg);
+    cmd.add(csv_arg);
+    cmd.add(sessions_arg);
+    cmd.parse(argc, argv);
+
+    std::vector<mode> modes;
+    std::istringstream modes_list(modes_arg.getValue());
+    std::string name;
+    while (std::getline(modes_list, name, ','))
+    {
+        auto m = std::find_if(all_modes.begin(), all_modes.end(), [&](const mode& t) { return t.name == name; });
+        if (m == all_modes.end()) throw std::runtime_error("Unknown mode " + name);
+        modes.push_back(*m);
+    }
+
+    std::vector<mode_result> results;
+    for (auto&& m : modes)
+    {
+        std::cout << "Measuring " << m.name << "..." << std::endl;
+        results.push_back(run_mode(m, server_arg.getValue(), port_arg.getValue(), width_arg.getValue(), height_arg.getValue(),
+            fps_arg.getValue(), warmup_arg.getValue(), time_arg.getValue()));
+    }
+
+    bool all_streamed = true;
+    std::cout << std::endl << std::fixed << std::setprecision(1)
+        << std::left << std::setw(12) << "mode" << std::setw(10) << "stream"
+        << std::right << std::setw(8) << "fps" << std::setw(10) << "p50 ms" << std::setw(10) << "p99 ms"
+        << std::setw(12) << "wire Mbps" << std::setw(12) << "server CPU" << std::setw(12) << "client CPU" << std::endl;
+    for (auto&& r : results)
+    {
+        for (auto&& s : r.streams)
+        {
+            all_streamed = all_streamed && s.fps > 0;
+            std::cout << std::left << std::setw(12) << r.name << std::setw(10) << s.name
+                << std::right << std::setw(8) << s.fps << std::setw(10) << s.latency_p50_ms << std::setw(10) << s.latency_p99_ms
+                << std::setw(12) << r.wire_mbps << std::setw(11) << r.server_cpu << "%" << std::setw(11) << r.client_cpu << "%" << std::endl;
+        }
+    }
+
+    if (csv_arg.isSet())
+    {
+        std::ofstream csv(csv_arg.getValue());
+        csv << "mode,stream,fps,latency_p50_ms,latency_p99_ms,wire_mbps,server_cpu_percent,client_cpu_percent\n";
+        for (auto&& r : results)
+            for (auto&& s : r.streams)
+                csv << r.name << "," << s.name << "," << s.fps << "," << s.latency_p50_ms << "," << s.latency_p99_ms << ","
+                    << r.wire_mbps << "," << r.server_cpu << "," << r.client_cpu << "\n";
+    }
+
+    bool sessions_passed = true;
+    if (sessions_arg.isSet())
+    {
+        std::cout << std::endl << "Checking two sessions..." << std::endl;
+        sessions_passed = run_sessions(server_arg.getValue(), port_arg.getValue(), width_arg.getValue(), height_arg.getValue(),
+            fps_arg.getValue(), warmup_arg.getValue());
+    }
+
+    // a stream that did not deliver frames fails the run, so the tool can gate CI
+    return all_streamed && sessions_passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+catch (const rs2::error & e)
+{
+    std::cerr << "RealSense error calling " << e.get_failed_function() << "(" << e.get_failed_args() << "):\n    " << e.what() << std::endl;
+    return EXIT_FAILURE;
+}
+catch (const std::exception& e)
+{
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,127 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "RsCompressionWorkers.hh"
+#include "compression/AdaptiveCompression.h"
+
+#define COMPRESSION_QUEUE_CAPACITY 2
+#define COMPRESSION_WAIT_TIMEOUT_MS 100
+
+RsCompressionWorkers::RsCompressionWorkers() {}
+
+RsCompressionWorkers::~RsCompressionWorkers()
+{
+    stop();
+}
+
+void RsCompressionWorkers::start(const std::unordered_map<long long int, std::shared_ptr<ICompression>>& t_compressors, const std::unordered_map<long long int, std::shared_ptr<RsFrameBroadcast>>& t_broadcasts)
+{
+    for(auto worker = m_workers.begin(); worker != m_workers.end();)
+    {
+        if(t_broadcasts.find(worker->first) == t_broadcasts.end())
+        {
+            stopWorker(worker->second);
+            worker = m_workers.erase(worker);
+        }
+        else
+        {
+            ++worker;
+        }
+    }
+    for(auto& broadcast : t_broadcasts)
+    {
+        auto compressor = t_compressors.find(broadcast.first);
+        if(compressor != t_compressors.end() && m_workers.find(broadcast.first) == m_workers.end())
+        {
+            rs2::frame_queue queue(COMPRESSION_QUEUE_CAPACITY, true);
+            std::shared_ptr<std::atomic<bool>> isCompressing = std::make_shared<std::atomic<bool>>(true);
+            std::thread thread(&RsCompressionWorkers::compressFrames, this, broadcast.first, queue, compressor->second, broadcast.second, isCompressing);
+            m_workers.emplace(broadcast.first, Worker{queue, isCompressing, std::move(thread)});
+        }
+    }
+}
+
+void RsCompressionWorkers::stop()
+{
+    for(auto& worker : m_workers)
+    {
+        stopWorker(worker.second);
+    }
+    m_workers.clear();
+}
+
+void RsCompressionWorkers::stopWorker(Worker& t_worker)
+{
+    *t_worker.isCompressing = false;
+    if(t_worker.thread.joinable())
+    {
+        t_worker.thread.join();
+    }
+}
+
+bool RsCompressionWorkers::enqueue(long long int t_profileKey, const rs2::frame& t_frame)
+{
+    auto worker = m_workers.find(t_profileKey);
+    if(worker == m_workers.end())
+    {
+        return false;
+    }
+    worker->second.queue.enqueue(t_frame);
+    return true;
+}
+
+void RsCompressionWorkers::compressFrames(long long int t_profileKey, rs2::frame_queue t_queue, std::shared_ptr<ICompression> t_compressor, std::shared_ptr<RsFrameBroadcast> t_frameBroadcast, std::shared_ptr<std::atomic<bool>> t_isCompressing)
+{
+    // each frame is compressed once for all the sessions. the backlog is the one of the session that is most ahead,
+    // so a single slow client skips frames rather than lowering the quality of the stream for everyone
+    std::shared_ptr<AdaptiveCompression> adaptiveCompressor = std::dynamic_pointer_cast<AdaptiveCompression>(t_compressor);
+
+    // the encoder writes straight into a frame taken from the librealsense frames pool, which the RTP sources send as is
+    long long int failedFrames = 0;
+    rs2::processing_block encoder([t_compressor, t_profileKey, &failedFrames](rs2::frame t_frame, rs2::frame_source& t_source) {
+        rs2::video_frame videoFrame = t_frame.as<rs2::video_frame>();
+        // the frame has room for the largest output of the codec, some codecs write it before checking its size
+        int maxSize = t_compressor->getMaxCompressedSize(t_frame.get_data_size());
+        int height = videoFrame.get_height();
+        rs2::frame compressedFrame = t_source.allocate_video_frame(t_frame.get_profile(), t_frame, 0, videoFrame.get_width(), 0, (maxSize + height - 1) / height);
+        int frameSize = t_compressor->compressBuffer((unsigned char*)t_frame.get_data(), t_frame.get_data_size(), (unsigned char*)compressedFrame.get_data());
+        if(frameSize == -1)
+        {
+            if(!failedFrames++)
+            {
+                ERR << "stream " << t_profileKey << " failed to compress frame " << t_frame.get_frame_number() << ", the frames that fail are dropped";
+            }
+            return;
+        }
+        t_source.frame_ready(compressedFrame);
+    });
+    encoder.start([t_frameBroadcast](rs2::frame t_frame) { t_frameBroadcast->publish(t_frame); });
+
+    while(*t_isCompressing)
+    {
+        rs2::frame frame;
+        if(t_queue.try_wait_for_frame(&frame, COMPRESSION_WAIT_TIMEOUT_MS))
+        {
+            if(adaptiveCompressor != nullptr)
+            {
+                adaptiveCompressor->setSendBacklog(int(t_frameBroadcast->getBacklog()));
+            }
+            try
+            {
+                encoder.invoke(frame);
+            }
+            catch(const std::exception& e)
+            {
+                failedFrames++;
+                ERR << "compression failed: " << e.what();
+            }
+        }
+    }
+    INF << "stream " << t_profileKey << " dropped " << failedFrames << " frames that failed to compress";
+    if(adaptiveCompressor != nullptr)
+    {
+        AdaptiveCompressionStatistic statistic = adaptiveCompressor->getStatistic();
+        INF << "stream " << t_profileKey << " adaptive compression: method " << statistic.zipMethod << " quality " << statistic.quality << ", " << statistic.switchCount << " switches in "
+            << statistic.frameCount << " frames, encode time " << statistic.avgEncodeTimeMs << " ms, ratio " << statistic.avgCompressionRatio;
+    }
+}
@@ -0,0 +1,46 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "RsFrameBroadcast.hh"
+#include "compression/ICompression.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Compresses the frames of the streams of a sensor, with a worker thread per stream, so the sensor callback never
+// waits for the encoder. Having a single worker per stream keeps the frames of each stream in order.
+// The queues and the threads live in this object, which the sensor and its callback share, so a worker never outlives
+// the queue it reads from.
+class RsCompressionWorkers
+{
+public:
+    RsCompressionWorkers();
+    ~RsCompressionWorkers();
+
+    // runs a worker for each stream that has a compressor, the workers publish the compressed frames to the broadcasts.
+    // the workers of the streams that were already running go on with their codec, the workers of the streams that are
+    // not in t_broadcasts are stopped. called while the sensor is stopped
+    void start(const std::unordered_map<long long int, std::shared_ptr<ICompression>>& t_compressors, const std::unordered_map<long long int, std::shared_ptr<RsFrameBroadcast>>& t_broadcasts);
+    // joins the workers, called after the sensor stopped
+    void stop();
+    // returns false when the stream is not compressed
+    bool enqueue(long long int t_profileKey, const rs2::frame& t_frame);
+
+private:
+    struct Worker
+    {
+        rs2::frame_queue queue;
+        std::shared_ptr<std::atomic<bool>> isCompressing;
+        std::thread thread;
+    };
+
+    void compressFrames(long long int t_profileKey, rs2::frame_queue t_queue, std::shared_ptr<ICompression> t_compressor, std::shared_ptr<RsFrameBroadcast> t_frameBroadcast, std::shared_ptr<std::atomic<bool>> t_isCompressing);
+    void stopWorker(Worker& t_worker);
+
+    std::unordered_map<long long int, Worker> m_workers;
+};
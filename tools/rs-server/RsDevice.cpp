@@ -49,6 +49,18 @@ RsDevice::RsDevice(UsageEnvironment* t_env)
         }
     } while(!found);
 
+    initSensors();
+}
+
+RsDevice::RsDevice(UsageEnvironment* t_env, rs2::device t_device)
+    : m_device(t_device)
+    , env(t_env)
+{
+    initSensors();
+}
+
+void RsDevice::initSensors()
+{
     //get RS sensors
     for(auto& sensor : m_device.query_sensors())
     {
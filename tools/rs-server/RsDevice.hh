@@ -12,6 +12,8 @@ class RsDevice
 {
 public:
     RsDevice(UsageEnvironment* t_env);
+    // serves the given device instead of waiting for a camera
+    RsDevice(UsageEnvironment* t_env, rs2::device t_device);
     ~RsDevice();
     std::vector<RsSensor>& getSensors()
     {
@@ -32,6 +34,8 @@ public:
     }
 
 private:
+    void initSensors();
+
     rs2::device m_device;
     std::vector<RsSensor> m_sensors;
 
@@ -0,0 +1,108 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "RsFrameBroadcast.hh"
+
+#include <algorithm>
+
+RsFrameBroadcast::RsFrameBroadcast(unsigned int t_capacity)
+    : m_capacity(t_capacity)
+    , m_firstSequence(0)
+{}
+
+void RsFrameBroadcast::publish(rs2::frame t_frame)
+{
+    // the frame stays here until all the readers are done with it, so it is taken out of the frames pool of its sensor
+    t_frame.keep();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if(m_readers.empty())
+    {
+        // nobody reads yet, new readers start from the next frame anyway
+        m_firstSequence += m_frames.size();
+        m_frames.clear();
+        return;
+    }
+    m_frames.push_back(t_frame);
+    if(m_frames.size() > m_capacity)
+    {
+        m_frames.pop_front();
+        m_firstSequence++;
+    }
+}
+
+long long RsFrameBroadcast::getBacklog()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    unsigned long long nextSequence = m_firstSequence + m_frames.size();
+    long long backlog = 0;
+    bool isFirst = true;
+    for(auto& reader : m_readers)
+    {
+        long long readerBacklog = (long long)(nextSequence - std::max(reader.second.cursor, m_firstSequence));
+        backlog = isFirst ? readerBacklog : std::min(backlog, readerBacklog);
+        isFirst = false;
+    }
+    return backlog;
+}
+
+bool RsFrameBroadcast::read(unsigned int t_readerId, rs2::frame& t_frame)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    unsigned long long nextSequence = m_firstSequence + m_frames.size();
+    auto reader = m_readers.find(t_readerId);
+    if(reader == m_readers.end())
+    {
+        m_readers[t_readerId] = {nextSequence, 0};
+        return false;
+    }
+    if(reader->second.cursor < m_firstSequence)
+    {
+        // the frames were released while this reader fell behind
+        reader->second.droppedFrames += m_firstSequence - reader->second.cursor;
+        reader->second.cursor = m_firstSequence;
+    }
+    if(reader->second.cursor >= nextSequence)
+    {
+        return false;
+    }
+    t_frame = m_frames[reader->second.cursor - m_firstSequence];
+    reader->second.cursor++;
+    releaseReadFrames();
+    return true;
+}
+
+void RsFrameBroadcast::detach(unsigned int t_readerId)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_readers.erase(t_readerId);
+    releaseReadFrames();
+}
+
+unsigned long long RsFrameBroadcast::getDroppedFrames(unsigned int t_readerId)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto reader = m_readers.find(t_readerId);
+    return reader == m_readers.end() ? 0 : reader->second.droppedFrames;
+}
+
+void RsFrameBroadcast::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_firstSequence += m_frames.size();
+    m_frames.clear();
+}
+
+void RsFrameBroadcast::releaseReadFrames()
+{
+    // the front frames that every reader already read are not needed anymore
+    unsigned long long minCursor = m_firstSequence + m_frames.size();
+    for(auto& reader : m_readers)
+    {
+        minCursor = std::min(minCursor, reader.second.cursor);
+    }
+    while(!m_frames.empty() && m_firstSequence < minCursor)
+    {
+        m_frames.pop_front();
+        m_firstSequence++;
+    }
+}
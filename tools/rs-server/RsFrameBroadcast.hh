@@ -0,0 +1,45 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <librealsense2/rs.hpp>
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+// Frames of one stream profile, ready to be sent, shared by all the client sessions that play the stream.
+// Each session reads the frames with its own cursor, so the frames are compressed once however many sessions play them,
+// and a session never takes a frame from another one. The frames are kept until the slowest session read them, but a
+// session that falls more than the capacity behind skips the frames it missed, without holding back the others.
+class RsFrameBroadcast
+{
+public:
+    RsFrameBroadcast(unsigned int t_capacity);
+
+    // called by the sensor and the compression threads
+    void publish(rs2::frame t_frame);
+    // frames the most advanced reader has not read yet, 0 when there are no readers
+    long long getBacklog();
+
+    // a reader that is not attached yet starts from the next published frame
+    bool read(unsigned int t_readerId, rs2::frame& t_frame);
+    void detach(unsigned int t_readerId);
+    unsigned long long getDroppedFrames(unsigned int t_readerId);
+    void clear();
+
+private:
+    struct Reader
+    {
+        unsigned long long cursor; // sequence of the next frame to read
+        unsigned long long droppedFrames;
+    };
+    void releaseReadFrames();
+
+    std::mutex m_mutex;
+    unsigned int m_capacity;
+    std::deque<rs2::frame> m_frames;
+    unsigned long long m_firstSequence; // sequence of m_frames.front()
+    std::unordered_map<unsigned int, Reader> m_readers;
+};
@@ -70,13 +70,6 @@ RsRTSPServer::RsRTSPClientConnection ::RsRTSPClientConnection(RsRTSPServer& t_ou
 
 RsRTSPServer::RsRTSPClientConnection::~RsRTSPClientConnection() {}
 
-void RsRTSPServer::RsRTSPClientConnection::handleCmd_DESCRIBE(char const* urlPreSuffix, char const* urlSuffix, char const* fullRequestStr) {
-    fOurRTSPServer.closeAllClientSessionsForServerMediaSession(STEREO_SENSOR_NAME.c_str());
-    fOurRTSPServer.closeAllClientSessionsForServerMediaSession(RGB_SENSOR_NAME.c_str());
-    
-    RTSPServer::RTSPClientConnection::handleCmd_DESCRIBE(urlPreSuffix, urlSuffix, fullRequestStr);
-}
-
 void RsRTSPServer::RsRTSPClientConnection::handleCmd_GET_PARAMETER(char const* t_fullRequestStr)
 {
     std::ostringstream oss;
@@ -262,6 +255,12 @@ void RsRTSPServer::RsRTSPClientSession::handleCmd_SET_PARAMETER(RTSPClientConnec
 
     try
     {
+        if(strcmp(sensorName, SHARED_MEMORY_PARAMETER) == 0)
+        {
+            setSharedMemory(stoll(std::string(option)), stoi(std::string(value)) != 0);
+            setRTSPResponse(t_ourClientConnection, "200 OK");
+            return;
+        }
         static_cast<RsServerMediaSession*>(fOurServerMediaSession)->getRsSensor().getRsSensor().set_option((rs2_option)stoi(std::string(option)), stof(std::string(value)));
         setRTSPResponse(t_ourClientConnection, "200 OK");
     }
@@ -286,38 +285,46 @@ void RsRTSPServer::RsRTSPClientSession::handleCmd_SETUP(RTSPServer::RTSPClientCo
             if(strcmp(subsession->trackId(), t_urlSuffix) == 0)
             {
                 long long int profileKey = static_cast<RsServerMediaSession*>(fOurServerMediaSession)->getRsSensor().getStreamProfileKey(((RsServerMediaSubsession*)(subsession))->getStreamProfile());
-                m_streamProfiles[profileKey] = ((RsServerMediaSubsession*)(subsession))->getFrameQueue();
+                m_streamProfiles[profileKey] = ((RsServerMediaSubsession*)(subsession))->getFrameBroadcast();
                 break; // success
             }
         }
     }
 }
 
-void RsRTSPServer::RsRTSPClientSession::openRsCamera()
+void RsRTSPServer::RsRTSPClientSession::setSharedMemory(long long int t_profileKey, bool t_isSharedMemory)
 {
-    static_cast<RsServerMediaSession*>(fOurServerMediaSession)->openRsCamera(m_streamProfiles);
-}
-
-void RsRTSPServer::RsRTSPClientSession::closeRsCamera()
-{
-    ((RsServerMediaSession*)fOurServerMediaSession)->closeRsCamera();
     for(int i = 0; i < fNumStreamStates; ++i)
     {
         if(fStreamStates[i].subsession != NULL)
         {
-            long long int profile_key = static_cast<RsServerMediaSession*>(fOurServerMediaSession)->getRsSensor().getStreamProfileKey(((RsServerMediaSubsession*)(fStreamStates[i].subsession))->getStreamProfile());
-            emptyStreamProfileQueue(profile_key);
+            RsServerMediaSubsession* subsession = (RsServerMediaSubsession*)(fStreamStates[i].subsession);
+            if(static_cast<RsServerMediaSession*>(fOurServerMediaSession)->getRsSensor().getStreamProfileKey(subsession->getStreamProfile()) == t_profileKey)
+            {
+                subsession->setSharedMemorySession(fOurSessionId, t_isSharedMemory);
+                return;
+            }
         }
     }
+    throw std::runtime_error("stream " + std::to_string(t_profileKey) + " is not set up in this session");
+}
+
+void RsRTSPServer::RsRTSPClientSession::openRsCamera()
+{
+    static_cast<RsServerMediaSession*>(fOurServerMediaSession)->openRsCamera(fOurSessionId, m_streamProfiles);
 }
 
-void RsRTSPServer::RsRTSPClientSession::emptyStreamProfileQueue(long long int profile_key)
+void RsRTSPServer::RsRTSPClientSession::closeRsCamera()
 {
-    rs2::frame f;
-    if(m_streamProfiles.find(profile_key) != m_streamProfiles.end())
+    ((RsServerMediaSession*)fOurServerMediaSession)->closeRsCamera(fOurSessionId);
+    for(int i = 0; i < fNumStreamStates; ++i)
     {
-        while(m_streamProfiles[profile_key].poll_for_frame(&f))
-            ;
+        if(fStreamStates[i].subsession != NULL)
+        {
+            // the frames this session did not read are released from the broadcast
+            ((RsServerMediaSubsession*)(fStreamStates[i].subsession))->getFrameBroadcast()->detach(fOurSessionId);
+            ((RsServerMediaSubsession*)(fStreamStates[i].subsession))->setSharedMemorySession(fOurSessionId, false);
+        }
     }
 }
 
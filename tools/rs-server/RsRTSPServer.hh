@@ -33,7 +33,6 @@ public:
         virtual ~RsRTSPClientConnection();
         virtual void handleCmd_GET_PARAMETER(char const* fullRequestStr);
         virtual void handleCmd_SET_PARAMETER(char const* fullRequestStr);
-        virtual void handleCmd_DESCRIBE(char const* urlPreSuffix, char const* urlSuffix, char const* fullRequestStr);
 
         RsRTSPServer& m_fOurRsRTSPServer;
 
@@ -60,10 +59,10 @@ public:
 
         void openRsCamera();
         void closeRsCamera();
-        void emptyStreamProfileQueue(long long int t_profile_key);
+        void setSharedMemory(long long int t_profileKey, bool t_isSharedMemory);
 
     private:
-        std::unordered_map<long long int, rs2::frame_queue> m_streamProfiles;
+        std::unordered_map<long long int, std::shared_ptr<RsFrameBroadcast>> m_streamProfiles;
     };
 
 protected:
@@ -73,7 +72,7 @@ protected:
     virtual ClientSession* createNewClientSession(u_int32_t t_sessionId);
 
 private:
-    int openRsCamera(RsSensor t_sensor, std::unordered_map<long long int, rs2::frame_queue>& t_streamProfiles);
+    int openRsCamera(RsSensor t_sensor, std::unordered_map<long long int, std::shared_ptr<RsFrameBroadcast>>& t_streamProfiles);
 
 private:
     friend class RsRTSPClientConnection;
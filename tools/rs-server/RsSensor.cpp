@@ -14,6 +14,8 @@ RsSensor::RsSensor(UsageEnvironment* t_env, rs2::sensor t_sensor, rs2::device t_
     : env(t_env)
     , m_sensor(t_sensor)
     , m_device(t_device)
+    , m_compressionWorkers(std::make_shared<RsCompressionWorkers>())
+    , m_sharedMemoryRings(std::make_shared<std::unordered_map<long long int, std::shared_ptr<RsSharedMemoryRing>>>())
 {
     for(rs2::stream_profile streamProfile : m_sensor.get_stream_profiles())
     {
@@ -24,13 +26,12 @@ RsSensor::RsSensor(UsageEnvironment* t_env, rs2::sensor t_sensor, rs2::device t_
             m_prevSample.emplace(getStreamProfileKey(streamProfile), std::chrono::high_resolution_clock::now());
         }
     }
-    m_memPool = new MemoryPool();
 }
 
-int RsSensor::open(std::unordered_map<long long int, rs2::frame_queue>& t_streamProfilesQueues)
+int RsSensor::open(std::unordered_map<long long int, std::shared_ptr<RsFrameBroadcast>>& t_streamProfilesBroadcasts)
 {
     std::vector<rs2::stream_profile> requestedStreamProfiles;
-    for(auto streamProfile : t_streamProfilesQueues)
+    for(auto streamProfile : t_streamProfilesBroadcasts)
     {
         //make a vector of all requested stream profiles
         long long int streamProfileKey = streamProfile.first;
@@ -62,32 +63,73 @@ int RsSensor::close()
 int RsSensor::stop()
 {
     m_sensor.stop();
+    m_compressionWorkers->stop();
     return EXIT_SUCCESS;
 }
 
-int RsSensor::start(std::unordered_map<long long int, rs2::frame_queue>& t_streamProfilesQueues)
+int RsSensor::pause()
 {
-    auto callback = [&](const rs2::frame& frame) {
+    m_sensor.stop();
+    m_sensor.close();
+    return EXIT_SUCCESS;
+}
+
+int RsSensor::start(std::unordered_map<long long int, std::shared_ptr<RsFrameBroadcast>>& t_streamProfilesBroadcasts)
+{
+    m_compressionWorkers->start(m_iCompress, t_streamProfilesBroadcasts);
+    // the rings outlive a restart of the sensor with more streams, so the local readers of the running streams go on
+    for(auto sharedMemoryRing = m_sharedMemoryRings->begin(); sharedMemoryRing != m_sharedMemoryRings->end();)
+    {
+        if(t_streamProfilesBroadcasts.find(sharedMemoryRing->first) == t_streamProfilesBroadcasts.end())
+        {
+            INF << "stream " << sharedMemoryRing->first << " dropped " << sharedMemoryRing->second->getDroppedFrames() << " frames of the shared memory";
+            sharedMemoryRing = m_sharedMemoryRings->erase(sharedMemoryRing);
+        }
+        else
+        {
+            ++sharedMemoryRing;
+        }
+    }
+    for(auto& streamProfile : t_streamProfilesBroadcasts)
+    {
+        if(!getIsSharedMemoryEnabled())
+        {
+            break;
+        }
+        if(m_sharedMemoryRings->find(streamProfile.first) != m_sharedMemoryRings->end())
+        {
+            continue;
+        }
+        rs2::video_stream_profile vsp = m_streamProfiles.at(streamProfile.first);
+        int bpp = (vsp.format() == RS2_FORMAT_RGBA8 || vsp.format() == RS2_FORMAT_BGRA8) ? 4 : getStreamProfileBpp(vsp.format());
+        std::shared_ptr<RsSharedMemoryRing> ring = RsSharedMemoryRing::create(RsSharedMemoryRing::getName(getServerPort(), streamProfile.first), SHARED_MEMORY_SLOTS, vsp.width() * vsp.height() * bpp);
+        if(ring != nullptr)
+        {
+            m_sharedMemoryRings->emplace(streamProfile.first, ring);
+        }
+    }
+
+    // the callback holds the workers, so their queues outlive it whichever copy of the sensor stops first
+    std::shared_ptr<RsCompressionWorkers> compressionWorkers = m_compressionWorkers;
+    auto callback = [&, compressionWorkers](const rs2::frame& frame) {
         long long int profileKey = getStreamProfileKey(frame.get_profile());
         //check if profile exists in map:
-        if(t_streamProfilesQueues.find(profileKey) != t_streamProfilesQueues.end())
+        if(t_streamProfilesBroadcasts.find(profileKey) != t_streamProfilesBroadcasts.end())
         {
             std::chrono::high_resolution_clock::time_point curSample = std::chrono::high_resolution_clock::now();
             std::chrono::duration<double> timeSpan = std::chrono::duration_cast<std::chrono::duration<double>>(curSample - m_prevSample[profileKey]);
-            if(CompressionFactory::isCompressionSupported(frame.get_profile().format(), frame.get_profile().stream_type()))
+            auto sharedMemoryRing = m_sharedMemoryRings->find(profileKey);
+            if(sharedMemoryRing != m_sharedMemoryRings->end())
+            {
+                // the local clients read the uncompressed frame
+                sharedMemoryRing->second->publish(getFrameMetadata(frame), frame.get_data(), frame.get_data_size());
+            }
+            //the worker publishes the compressed frame to the sessions of the stream
+            if(!compressionWorkers->enqueue(profileKey, frame))
             {
-                unsigned char* buff = m_memPool->getNextMem();
-                int frameSize = m_iCompress.at(profileKey)->compressBuffer((unsigned char*)frame.get_data(), frame.get_data_size(), buff);
-                if(frameSize == -1)
-                {
-                    m_memPool->returnMem(buff);
-                    return;
-                }
-                memcpy((unsigned char*)frame.get_data(), buff, frameSize);
-                m_memPool->returnMem(buff);
+                //publish the frame to the sessions of the stream
+                t_streamProfilesBroadcasts[profileKey]->publish(frame);
             }
-            //push frame to its queue
-            t_streamProfilesQueues[profileKey].enqueue(frame);
             m_prevSample[profileKey] = curSample;
         }
     };
@@ -107,6 +149,48 @@ long long int RsSensor::getStreamProfileKey(rs2::stream_profile t_profile)
     return key;
 }
 
+RsMetadataHeader RsSensor::getFrameMetadata(const rs2::frame& t_frame)
+{
+    RsMetadataHeader metadata = {};
+    if(t_frame.supports_frame_metadata(RS2_FRAME_METADATA_FRAME_TIMESTAMP))
+    {
+        metadata.data.timestamp = t_frame.get_frame_metadata(RS2_FRAME_METADATA_FRAME_TIMESTAMP) / 1000;
+    }
+    else
+    {
+        metadata.data.timestamp = t_frame.get_timestamp();
+    }
+
+    if(t_frame.supports_frame_metadata(RS2_FRAME_METADATA_FRAME_COUNTER))
+    {
+        metadata.data.frameCounter = t_frame.get_frame_metadata(RS2_FRAME_METADATA_FRAME_COUNTER);
+    }
+    else
+    {
+        metadata.data.frameCounter = t_frame.get_frame_number();
+    }
+
+    if(t_frame.supports_frame_metadata(RS2_FRAME_METADATA_ACTUAL_FPS))
+    {
+        metadata.data.actualFps = t_frame.get_frame_metadata(RS2_FRAME_METADATA_ACTUAL_FPS);
+    }
+
+    metadata.data.timestampDomain = t_frame.get_frame_timestamp_domain();
+    return metadata;
+}
+
+bool& RsSensor::getIsSharedMemoryEnabled()
+{
+    static bool isSharedMemoryEnabled = false;
+    return isSharedMemoryEnabled;
+}
+
+unsigned int& RsSensor::getServerPort()
+{
+    static unsigned int serverPort = 8554;
+    return serverPort;
+}
+
 std::string RsSensor::getSensorName()
 {
     if(m_sensor.supports(RS2_CAMERA_INFO_NAME))
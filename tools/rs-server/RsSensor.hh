@@ -3,11 +3,15 @@
 
 #pragma once
 
+#include "RsCompressionWorkers.hh"
+#include "RsFrameBroadcast.hh"
 #include "compression/ICompression.h"
+#include <atomic>
 #include <chrono>
-#include <ipDeviceCommon/MemoryPool.h>
+#include <ipDeviceCommon/RsSharedMemory.h>
 #include <librealsense2/hpp/rs_types.hpp>
 #include <librealsense2/rs.hpp>
+#include <thread>
 #include <unordered_map>
 
 typedef struct RsOption
@@ -20,10 +24,13 @@ class RsSensor
 {
 public:
     RsSensor(UsageEnvironment* t_env, rs2::sensor t_sensor, rs2::device t_device);
-    int open(std::unordered_map<long long int, rs2::frame_queue>& t_streamProfilesQueues);
-    int start(std::unordered_map<long long int, rs2::frame_queue>& t_streamProfilesQueues);
+    int open(std::unordered_map<long long int, std::shared_ptr<RsFrameBroadcast>>& t_streamProfilesBroadcasts);
+    int start(std::unordered_map<long long int, std::shared_ptr<RsFrameBroadcast>>& t_streamProfilesBroadcasts);
     int close();
     int stop();
+    // stops and closes the sensor but keeps the compression workers and the shared memory rings of its streams, so the
+    // sensor can be opened and started again with more streams without resetting the ones that were running
+    int pause();
     rs2::sensor& getRsSensor()
     {
         return m_sensor;
@@ -40,6 +47,10 @@ public:
         return m_device;
     }
     std::vector<RsOption> getSupportedOptions();
+    static RsMetadataHeader getFrameMetadata(const rs2::frame& t_frame);
+    // when enabled the frames of the started streams are also published to shared memory rings for the local clients
+    static bool& getIsSharedMemoryEnabled();
+    static unsigned int& getServerPort();
 
 private:
     UsageEnvironment* env;
@@ -47,6 +58,8 @@ private:
     std::unordered_map<long long int, rs2::video_stream_profile> m_streamProfiles;
     std::unordered_map<long long int, std::shared_ptr<ICompression>> m_iCompress;
     rs2::device m_device;
-    MemoryPool* m_memPool;
     std::unordered_map<long long int, std::chrono::high_resolution_clock::time_point> m_prevSample;
+    // shared, so that the copies of a sensor stop the workers started by any of them
+    std::shared_ptr<RsCompressionWorkers> m_compressionWorkers;
+    std::shared_ptr<std::unordered_map<long long int, std::shared_ptr<RsSharedMemoryRing>>> m_sharedMemoryRings;
 };
@@ -12,6 +12,7 @@
 #include "RsDevice.hh"
 #include "RsRTSPServer.hh"
 #include "RsServerMediaSession.h"
+#include "RsSyntheticDevice.hh"
 #include "RsCommon.h"
 #include <compression/CompressionFactory.h>
 
@@ -26,6 +27,7 @@ struct server
     RsRTSPServer* rtspServer;
     UsageEnvironment* env;
     std::shared_ptr<RsDevice> rsDevice;
+    std::shared_ptr<RsSyntheticDevice> syntheticDevice;
     std::vector<rs2::video_stream_profile> supported_stream_profiles; // streams for extrinsics map creation
     std::vector<RsSensor> sensors;
     TaskScheduler* scheduler;
@@ -40,10 +42,18 @@ struct server
         CmdLine cmd("LRS Network Extentions Server", ' ', RS2_API_VERSION_STR);
 
         SwitchArg arg_enable_compression("c", "enable-compression", "Enable video compression");
+        SwitchArg arg_adaptive_compression("a", "adaptive-compression", "Adapt the video compression of each stream to the link throughput");
+        SwitchArg arg_shared_memory("s", "shared-memory", "Serve the clients on this host through shared memory");
+        SwitchArg arg_synthetic("y", "synthetic", "Serve generated frames instead of a camera, e.g. to benchmark the network streaming");
+        ValueArg<std::string> arg_depth_compression("d", "depth-compression", "Compression method of the depth streams: lz4, rvl or rvl_bands", false, "lz4", "string");
         ValueArg<std::string> arg_address("i", "interface-address", "Address of the interface to bind on", false, "", "string");
         ValueArg<unsigned int> arg_port("p", "port", "RTSP port to listen on", false, 8554, "integer");
 
         cmd.add(arg_enable_compression);
+        cmd.add(arg_adaptive_compression);
+        cmd.add(arg_depth_compression);
+        cmd.add(arg_shared_memory);
+        cmd.add(arg_synthetic);
         cmd.add(arg_address);
         cmd.add(arg_port);
 
@@ -53,6 +63,12 @@ struct server
         if (arg_enable_compression.isSet())
         {
             CompressionFactory::getIsEnabled() = 1;
+            CompressionFactory::getIsAdaptive() = arg_adaptive_compression.isSet();
+            if (!CompressionFactory::getDepthZipMethod(arg_depth_compression.getValue(), CompressionFactory::getDepthZipMethod()))
+            {
+                std::cerr << "Unknown depth compression method: " << arg_depth_compression.getValue() << "\n";
+                exit(1);
+            }
         }
 
         if (arg_address.isSet()) 
@@ -64,6 +80,9 @@ struct server
         {
             port = arg_port.getValue();
         }
+
+        RsSensor::getIsSharedMemoryEnabled() = arg_shared_memory.isSet();
+        RsSensor::getServerPort() = port;
         
         OutPacketBuffer::increaseMaxSizeTo(MAX_MESSAGE_SIZE);
         
@@ -71,7 +90,15 @@ struct server
         scheduler = BasicTaskScheduler::createNew();
         env = RSUsageEnvironment::createNew(*scheduler);
 
-        rsDevice = std::make_shared<RsDevice>(env);
+        if(arg_synthetic.isSet())
+        {
+            syntheticDevice = std::make_shared<RsSyntheticDevice>();
+            rsDevice = std::make_shared<RsDevice>(env, syntheticDevice->getDevice());
+        }
+        else
+        {
+            rsDevice = std::make_shared<RsDevice>(env);
+        }
         rtspServer = RsRTSPServer::createNew(*env, rsDevice, port);
 
         if(rtspServer == NULL)
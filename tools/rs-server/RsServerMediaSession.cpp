@@ -18,26 +18,72 @@ RsServerMediaSession::RsServerMediaSession(UsageEnvironment& t_env, RsSensor& t_
 
 RsServerMediaSession::~RsServerMediaSession() {}
 
-void RsServerMediaSession::openRsCamera(std::unordered_map<long long int, rs2::frame_queue>& t_streamProfiles)
+void RsServerMediaSession::openRsCamera(unsigned t_sessionId, std::unordered_map<long long int, std::shared_ptr<RsFrameBroadcast>>& t_streamProfiles)
 {
-    if(m_isActive)
+    std::unordered_map<long long int, std::shared_ptr<RsFrameBroadcast>> streamProfiles = m_activeStreamProfiles;
+    bool isUnionChanged = !m_isActive;
+    for(auto& streamProfile : t_streamProfiles)
     {
-        envir() << "sensor is already open, closing sensor and than open again...\n";
-        closeRsCamera();
+        isUnionChanged = streamProfiles.insert(streamProfile).second || isUnionChanged;
     }
-    m_rsSensor.open(t_streamProfiles);
-    m_rsSensor.start(t_streamProfiles);
-    m_isActive = true;
+    if(isUnionChanged)
+    {
+        // the streams of the other sessions keep going, but the sensor is opened again with the new profiles added
+        std::unordered_map<long long int, std::shared_ptr<RsFrameBroadcast>> activeStreamProfiles = m_activeStreamProfiles;
+        if(m_isActive)
+        {
+            envir() << "sensor is already open, opening it again with the streams of all the sessions...\n";
+        }
+        try
+        {
+            restartRsCamera(streamProfiles);
+        }
+        catch(const std::exception&)
+        {
+            // the sensor cannot stream the new profiles along with the running ones, the running sessions keep theirs
+            if(!activeStreamProfiles.empty())
+            {
+                restartRsCamera(activeStreamProfiles);
+            }
+            throw;
+        }
+    }
+    m_activeSessions.insert(t_sessionId);
 }
 
-void RsServerMediaSession::closeRsCamera()
+void RsServerMediaSession::closeRsCamera(unsigned t_sessionId)
+{
+    m_activeSessions.erase(t_sessionId);
+    if(m_isActive && m_activeSessions.empty())
+    {
+        m_rsSensor.stop();
+        m_rsSensor.close();
+        m_isActive = false;
+        m_activeStreamProfiles.clear();
+    }
+}
+
+void RsServerMediaSession::restartRsCamera(std::unordered_map<long long int, std::shared_ptr<RsFrameBroadcast>>& t_streamProfiles)
 {
     if(m_isActive)
     {
-        m_rsSensor.getRsSensor().stop();
-        m_rsSensor.getRsSensor().close();
+        // start() goes on with the workers of the streams that keep running
+        m_rsSensor.pause();
         m_isActive = false;
     }
+    // the sensor callback refers to the map, so it is kept by the session for as long as the sensor streams
+    m_activeStreamProfiles = t_streamProfiles;
+    try
+    {
+        m_rsSensor.open(m_activeStreamProfiles);
+        m_rsSensor.start(m_activeStreamProfiles);
+    }
+    catch(...)
+    {
+        m_activeStreamProfiles.clear();
+        throw;
+    }
+    m_isActive = true;
 }
 
 RsSensor& RsServerMediaSession::getRsSensor()
@@ -6,19 +6,31 @@
 #include "RsDevice.hh"
 #include "ServerMediaSession.hh"
 
+#include <set>
+
 class RsServerMediaSession : public ServerMediaSession
 {
 public:
     static RsServerMediaSession* createNew(UsageEnvironment& t_env, RsSensor& t_sensor, char const* t_streamName = NULL, char const* t_info = NULL, char const* t_description = NULL, Boolean t_isSSM = False, char const* t_miscSDPLines = NULL);
     RsSensor& getRsSensor();
-    void openRsCamera(std::unordered_map<long long int, rs2::frame_queue>& t_streamProfiles);
-    void closeRsCamera();
+    // the sensor is shared by the sessions that play it, it streams the profiles requested by all of them.
+    // a session that asks only for profiles that are already streaming joins without touching the sensor. a session that
+    // adds profiles reopens the sensor with the union of the profiles, the running streams miss the frames of the time the
+    // sensor takes to stop and start again, but their compression workers and shared memory rings are kept
+    void openRsCamera(unsigned t_sessionId, std::unordered_map<long long int, std::shared_ptr<RsFrameBroadcast>>& t_streamProfiles);
+    // the profiles of a session that leaves keep streaming until the last session leaves, rather than interrupting the
+    // other sessions to drop them
+    void closeRsCamera(unsigned t_sessionId);
 
 protected:
     RsServerMediaSession(UsageEnvironment& t_env, RsSensor& t_sensor, char const* t_streamName, char const* t_info, char const* t_description, Boolean t_isSSM, char const* t_miscSDPLines);
     virtual ~RsServerMediaSession();
 
 private:
+    void restartRsCamera(std::unordered_map<long long int, std::shared_ptr<RsFrameBroadcast>>& t_streamProfiles);
+
     RsSensor m_rsSensor;
     bool m_isActive;
+    std::set<unsigned> m_activeSessions;
+    std::unordered_map<long long int, std::shared_ptr<RsFrameBroadcast>> m_activeStreamProfiles;
 };
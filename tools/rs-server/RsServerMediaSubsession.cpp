@@ -6,8 +6,6 @@
 #include "RsServerMediaSession.h"
 #include "RsSimpleRTPSink.h"
 
-#define CAPACITY 100
-
 RsServerMediaSubsession* RsServerMediaSubsession::createNew(UsageEnvironment& t_env, rs2::video_stream_profile& t_videoStreamProfile, std::shared_ptr<RsDevice> rsDevice)
 {
     return new RsServerMediaSubsession(t_env, t_videoStreamProfile, rsDevice);
@@ -17,15 +15,16 @@ RsServerMediaSubsession ::RsServerMediaSubsession(UsageEnvironment& env, rs2::vi
     : OnDemandServerMediaSubsession(env, false)
     , m_videoStreamProfile(t_videoStreamProfile)
 {
-    m_frameQueue = rs2::frame_queue(CAPACITY, true);
+    m_frameBroadcast = std::make_shared<RsFrameBroadcast>(STREAM_BROADCAST_CAPACITY);
+    m_sharedMemorySessions = std::make_shared<std::set<unsigned>>();
     m_rsDevice = device;
 }
 
 RsServerMediaSubsession::~RsServerMediaSubsession() {}
 
-rs2::frame_queue& RsServerMediaSubsession::getFrameQueue()
+std::shared_ptr<RsFrameBroadcast> RsServerMediaSubsession::getFrameBroadcast()
 {
-    return m_frameQueue;
+    return m_frameBroadcast;
 }
 
 rs2::video_stream_profile RsServerMediaSubsession::getStreamProfile()
@@ -33,10 +32,22 @@ rs2::video_stream_profile RsServerMediaSubsession::getStreamProfile()
     return m_videoStreamProfile;
 }
 
-FramedSource* RsServerMediaSubsession::createNewStreamSource(unsigned /*t_clientSessionId*/, unsigned& t_estBitrate)
+void RsServerMediaSubsession::setSharedMemorySession(unsigned t_sessionId, bool t_isSharedMemory)
+{
+    if(t_isSharedMemory)
+    {
+        m_sharedMemorySessions->insert(t_sessionId);
+    }
+    else
+    {
+        m_sharedMemorySessions->erase(t_sessionId);
+    }
+}
+
+FramedSource* RsServerMediaSubsession::createNewStreamSource(unsigned t_clientSessionId, unsigned& t_estBitrate)
 {
     t_estBitrate = 20000;
-    return RsDeviceSource::createNew(envir(), m_videoStreamProfile, m_frameQueue);
+    return RsDeviceSource::createNew(envir(), m_videoStreamProfile, m_frameBroadcast, t_clientSessionId, m_sharedMemorySessions);
 }
 
 RTPSink* RsServerMediaSubsession ::createNewRTPSink(Groupsock* t_rtpGroupsock, unsigned char t_rtpPayloadTypeIfDynamic, FramedSource* /*t_inputSource*/)
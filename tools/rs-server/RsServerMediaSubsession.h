@@ -10,14 +10,18 @@
 #include "OnDemandServerMediaSubsession.hh"
 #endif
 
+#include "RsFrameBroadcast.hh"
 #include "RsSource.hh"
 
+#define STREAM_BROADCAST_CAPACITY 100
+
 class RsServerMediaSubsession : public OnDemandServerMediaSubsession
 {
 public:
     static RsServerMediaSubsession* createNew(UsageEnvironment& t_env, rs2::video_stream_profile& t_videoStreamProfile, std::shared_ptr<RsDevice> rsDevice);
-    rs2::frame_queue& getFrameQueue();
+    std::shared_ptr<RsFrameBroadcast> getFrameBroadcast();
     rs2::video_stream_profile getStreamProfile();
+    void setSharedMemorySession(unsigned t_sessionId, bool t_isSharedMemory);
 
 protected:
     RsServerMediaSubsession(UsageEnvironment& t_env, rs2::video_stream_profile& t_video_stream_profile, std::shared_ptr<RsDevice> device);
@@ -27,6 +31,7 @@ protected:
 
 private:
     rs2::video_stream_profile m_videoStreamProfile;
-    rs2::frame_queue m_frameQueue;
+    std::shared_ptr<RsFrameBroadcast> m_frameBroadcast;
     std::shared_ptr<RsDevice> m_rsDevice;
+    std::shared_ptr<std::set<unsigned>> m_sharedMemorySessions; // shared with the sources, which may outlive the subsession
 };
@@ -3,7 +3,7 @@
 
 #include "RsSource.hh"
 #include "BasicUsageEnvironment.hh"
-#include "RsStatistics.h"
+#include "RsSensor.hh"
 #include <GroupsockHelper.hh>
 #include <cassert>
 #include <compression/CompressionFactory.h>
@@ -11,19 +11,31 @@
 #include <ipDeviceCommon/Statistic.h>
 #include <librealsense2/h/rs_sensor.h>
 
-RsDeviceSource* RsDeviceSource::createNew(UsageEnvironment& t_env, rs2::video_stream_profile& t_videoStreamProfile, rs2::frame_queue& t_queue)
+#define SHARED_MEMORY_SKIP_INTERVAL_US 10000
+
+RsDeviceSource* RsDeviceSource::createNew(UsageEnvironment& t_env, rs2::video_stream_profile& t_videoStreamProfile, std::shared_ptr<RsFrameBroadcast> t_frameBroadcast, unsigned t_sessionId, std::shared_ptr<const std::set<unsigned>> t_sharedMemorySessions)
 {
-    return new RsDeviceSource(t_env, t_videoStreamProfile, t_queue);
+    return new RsDeviceSource(t_env, t_videoStreamProfile, t_frameBroadcast, t_sessionId, t_sharedMemorySessions);
 }
 
-RsDeviceSource::RsDeviceSource(UsageEnvironment& t_env, rs2::video_stream_profile& t_videoStreamProfile, rs2::frame_queue& t_queue)
+RsDeviceSource::RsDeviceSource(UsageEnvironment& t_env, rs2::video_stream_profile& t_videoStreamProfile, std::shared_ptr<RsFrameBroadcast> t_frameBroadcast, unsigned t_sessionId, std::shared_ptr<const std::set<unsigned>> t_sharedMemorySessions)
     : FramedSource(t_env)
+    , m_frameBroadcast(t_frameBroadcast)
+    , m_sessionId(t_sessionId)
+    , m_sharedMemorySessions(t_sharedMemorySessions)
 {
-    m_framesQueue = &t_queue;
     m_streamProfile = &t_videoStreamProfile;
 }
 
-RsDeviceSource::~RsDeviceSource() {}
+RsDeviceSource::~RsDeviceSource()
+{
+    unsigned long long droppedFrames = m_frameBroadcast->getDroppedFrames(m_sessionId);
+    if(droppedFrames > 0)
+    {
+        INF << "session " << m_sessionId << " skipped " << droppedFrames << " frames of stream " << RsSensor::getStreamProfileKey(*m_streamProfile);
+    }
+    m_frameBroadcast->detach(m_sessionId);
+}
 
 void RsDeviceSource::doGetNextFrame()
 {
@@ -32,13 +44,16 @@ void RsDeviceSource::doGetNextFrame()
     rs2::frame frame;
     try
     {
-        if(!m_framesQueue->poll_for_frame(&frame))
+        if(skipSharedMemoryFrames())
+        {
+            return;
+        }
+        if(!m_frameBroadcast->read(m_sessionId, frame))
         {
             nextTask() = envir().taskScheduler().scheduleDelayedTask(0, (TaskFunc*)waitForFrame, this);
         }
         else
         {
-            frame.keep();
             deliverRSFrame(&frame);
         }
     }
@@ -54,13 +69,16 @@ void RsDeviceSource::handleWaitForFrame()
     rs2::frame frame;
     try
     {
-        if(!(getFramesQueue()->poll_for_frame(&frame)))
+        if(skipSharedMemoryFrames())
+        {
+            return;
+        }
+        if(!m_frameBroadcast->read(m_sessionId, frame))
         {
             nextTask() = envir().taskScheduler().scheduleDelayedTask(0, (TaskFunc*)RsDeviceSource::waitForFrame, this);
         }
         else
         {
-            frame.keep();
             deliverRSFrame(&frame);
         }
     }
@@ -70,6 +88,19 @@ void RsDeviceSource::handleWaitForFrame()
     }
 }
 
+bool RsDeviceSource::skipSharedMemoryFrames()
+{
+    // the client of this session reads the frames from shared memory, nothing is sent over RTP
+    if(m_sharedMemorySessions->find(m_sessionId) == m_sharedMemorySessions->end())
+    {
+        return false;
+    }
+    // a detached session does not hold frames in the broadcast nor count in its backlog
+    m_frameBroadcast->detach(m_sessionId);
+    nextTask() = envir().taskScheduler().scheduleDelayedTask(SHARED_MEMORY_SKIP_INTERVAL_US, (TaskFunc*)RsDeviceSource::waitForFrame, this);
+    return true;
+}
+
 // The following is called after each delay between packet sends:
 void RsDeviceSource::waitForFrame(RsDeviceSource* t_deviceSource)
 {
@@ -103,30 +134,7 @@ void RsDeviceSource::deliverRSFrame(rs2::frame* t_frame)
     fFrameSize += sizeof(RsMetadataHeader);
     header.networkHeader.data.frameSize = fFrameSize;
     fFrameSize += sizeof(RsNetworkHeader);
-    if(t_frame->supports_frame_metadata(RS2_FRAME_METADATA_FRAME_TIMESTAMP))
-    {
-        header.metadataHeader.data.timestamp = t_frame->get_frame_metadata(RS2_FRAME_METADATA_FRAME_TIMESTAMP) / 1000;
-    }
-    else
-    {
-        header.metadataHeader.data.timestamp = t_frame->get_timestamp();
-    }
-
-    if(t_frame->supports_frame_metadata(RS2_FRAME_METADATA_FRAME_COUNTER))
-    {
-        header.metadataHeader.data.frameCounter = t_frame->get_frame_metadata(RS2_FRAME_METADATA_FRAME_COUNTER);
-    }
-    else
-    {
-        header.metadataHeader.data.frameCounter = t_frame->get_frame_number();
-    }
-
-    if(t_frame->supports_frame_metadata(RS2_FRAME_METADATA_ACTUAL_FPS))
-    {
-        header.metadataHeader.data.actualFps = t_frame->get_frame_metadata(RS2_FRAME_METADATA_ACTUAL_FPS);
-    }
-
-    header.metadataHeader.data.timestampDomain = t_frame->get_frame_timestamp_domain();
+    header.metadataHeader = RsSensor::getFrameMetadata(*t_frame);
 
     memmove(fTo, &header, sizeof(header));
 
@@ -4,31 +4,33 @@
 #pragma once
 
 #include "DeviceSource.hh"
+#include "RsFrameBroadcast.hh"
 
+#include <atomic>
 #include <condition_variable>
 #include <mutex>
+#include <set>
 #include <rs.hpp> // Include RealSense Cross Platform API
 
 class RsDeviceSource : public FramedSource
 {
 public:
-    static RsDeviceSource* createNew(UsageEnvironment& t_env, rs2::video_stream_profile& t_videoStreamProfile, rs2::frame_queue& t_queue);
+    static RsDeviceSource* createNew(UsageEnvironment& t_env, rs2::video_stream_profile& t_videoStreamProfile, std::shared_ptr<RsFrameBroadcast> t_frameBroadcast, unsigned t_sessionId, std::shared_ptr<const std::set<unsigned>> t_sharedMemorySessions);
     void handleWaitForFrame();
     static void waitForFrame(RsDeviceSource* t_deviceSource);
 
 protected:
-    RsDeviceSource(UsageEnvironment& t_env, rs2::video_stream_profile& t_videoStreamProfile, rs2::frame_queue& t_queue);
+    RsDeviceSource(UsageEnvironment& t_env, rs2::video_stream_profile& t_videoStreamProfile, std::shared_ptr<RsFrameBroadcast> t_frameBroadcast, unsigned t_sessionId, std::shared_ptr<const std::set<unsigned>> t_sharedMemorySessions);
     virtual ~RsDeviceSource();
 
 private:
     virtual void doGetNextFrame();
-    rs2::frame_queue* getFramesQueue()
-    {
-        return m_framesQueue;
-    };
     void deliverRSFrame(rs2::frame* t_frame);
+    bool skipSharedMemoryFrames();
 
 private:
-    rs2::frame_queue* m_framesQueue;
+    std::shared_ptr<RsFrameBroadcast> m_frameBroadcast;
     rs2::video_stream_profile* m_streamProfile;
+    unsigned m_sessionId; // the cursor of this source in the broadcast
+    std::shared_ptr<const std::set<unsigned>> m_sharedMemorySessions; // sessions that read the stream from shared memory, kept by the subsession
 };
@@ -0,0 +1,155 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "RsSyntheticDevice.hh"
+#include "RsCommon.h"
+
+#include <algorithm>
+#include <cstring>
+
+#define SYNTHETIC_MAX_SLEEP_MS 5
+
+RsSyntheticDevice::RsSyntheticDevice()
+    : m_nextStreamUid(0)
+    , m_noise(1)
+    , m_isGenerating(true)
+{
+    m_device.register_info(RS2_CAMERA_INFO_NAME, "Synthetic Device");
+    m_device.register_info(RS2_CAMERA_INFO_SERIAL_NUMBER, "000000000000");
+    m_device.register_info(RS2_CAMERA_INFO_USB_TYPE_DESCRIPTOR, "3.2");
+
+    SyntheticSensor stereo = {m_device.add_sensor(STEREO_SENSOR_NAME), {}};
+    stereo.sensor.add_read_only_option(RS2_OPTION_DEPTH_UNITS, 0.001f);
+    addStream(stereo, RS2_STREAM_DEPTH, 0, RS2_FORMAT_Z16, 2, 640, 480, 30);
+    addStream(stereo, RS2_STREAM_DEPTH, 0, RS2_FORMAT_Z16, 2, 640, 480, 15);
+    addStream(stereo, RS2_STREAM_DEPTH, 0, RS2_FORMAT_Z16, 2, 424, 240, 30);
+    addStream(stereo, RS2_STREAM_DEPTH, 0, RS2_FORMAT_Z16, 2, 424, 240, 60);
+    addStream(stereo, RS2_STREAM_INFRARED, 1, RS2_FORMAT_Y8, 1, 640, 480, 30);
+    addStream(stereo, RS2_STREAM_INFRARED, 1, RS2_FORMAT_Y8, 1, 424, 240, 30);
+    m_sensors.push_back(stereo);
+
+    SyntheticSensor rgb = {m_device.add_sensor(RGB_SENSOR_NAME), {}};
+    addStream(rgb, RS2_STREAM_COLOR, 0, RS2_FORMAT_RGB8, 3, 640, 480, 30);
+    addStream(rgb, RS2_STREAM_COLOR, 0, RS2_FORMAT_RGB8, 3, 640, 480, 15);
+    addStream(rgb, RS2_STREAM_COLOR, 0, RS2_FORMAT_RGB8, 3, 424, 240, 30);
+    m_sensors.push_back(rgb);
+
+    // the server exposes the extrinsics between all the streams
+    rs2_extrinsics identity = {{1, 0, 0, 0, 1, 0, 0, 0, 1}, {0, 0, 0}};
+    for(auto& sensorFrom : m_sensors)
+    {
+        for(auto& streamFrom : sensorFrom.streams)
+        {
+            for(auto& sensorTo : m_sensors)
+            {
+                for(auto& streamTo : sensorTo.streams)
+                {
+                    streamFrom.profile.register_extrinsics_to(streamTo.profile, identity);
+                }
+            }
+        }
+    }
+
+    m_generator = std::thread(&RsSyntheticDevice::generateFrames, this);
+}
+
+RsSyntheticDevice::~RsSyntheticDevice()
+{
+    m_isGenerating = false;
+    if(m_generator.joinable())
+    {
+        m_generator.join();
+    }
+}
+
+void RsSyntheticDevice::addStream(SyntheticSensor& t_sensor, rs2_stream t_type, int t_index, rs2_format t_format, int t_bpp, int t_width, int t_height, int t_fps)
+{
+    rs2_intrinsics intrinsics = {};
+    intrinsics.width = t_width;
+    intrinsics.height = t_height;
+    intrinsics.ppx = t_width / 2.f;
+    intrinsics.ppy = t_height / 2.f;
+    intrinsics.fx = t_width * 0.9f;
+    intrinsics.fy = t_width * 0.9f;
+    intrinsics.model = RS2_DISTORTION_BROWN_CONRADY;
+
+    rs2::stream_profile profile = t_sensor.sensor.add_video_stream({t_type, t_index, m_nextStreamUid++, t_width, t_height, t_fps, t_bpp, t_format, intrinsics});
+    t_sensor.streams.push_back({profile.as<rs2::video_stream_profile>(), t_bpp, 0, std::chrono::steady_clock::now()});
+}
+
+void RsSyntheticDevice::generateFrames()
+{
+    while(m_isGenerating)
+    {
+        auto now = std::chrono::steady_clock::now();
+        auto wakeUp = now + std::chrono::milliseconds(SYNTHETIC_MAX_SLEEP_MS);
+        for(auto& sensor : m_sensors)
+        {
+            std::vector<rs2::stream_profile> activeStreams;
+            try
+            {
+                activeStreams = sensor.sensor.get_active_streams();
+            }
+            catch(const std::exception&)
+            {
+                continue;
+            }
+            for(auto& stream : sensor.streams)
+            {
+                bool isActive = std::any_of(activeStreams.begin(), activeStreams.end(), [&](const rs2::stream_profile& t_active) { return t_active.unique_id() == stream.profile.unique_id(); });
+                if(!isActive)
+                {
+                    continue;
+                }
+                auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / stream.profile.fps()));
+                if(stream.nextFrame <= now)
+                {
+                    generateFrame(sensor, stream);
+                    // a late frame does not make the following frames come in a burst
+                    stream.nextFrame = std::max(stream.nextFrame + period, now);
+                }
+                wakeUp = std::min(wakeUp, stream.nextFrame);
+            }
+        }
+        std::this_thread::sleep_until(wakeUp);
+    }
+}
+
+void RsSyntheticDevice::generateFrame(SyntheticSensor& t_sensor, SyntheticStream& t_stream)
+{
+    int width = t_stream.profile.width();
+    int height = t_stream.profile.height();
+    rs2_format format = t_stream.profile.format();
+    int frameNumber = ++t_stream.frameNumber;
+    unsigned char* pixels = new unsigned char[width * height * t_stream.bpp];
+
+    // a moving gradient with a little noise, so the codecs see content that is neither flat nor random
+    for(int y = 0; y < height; y++)
+    {
+        for(int x = 0; x < width; x++)
+        {
+            m_noise ^= m_noise << 13;
+            m_noise ^= m_noise >> 17;
+            m_noise ^= m_noise << 5;
+            int value = (x + y + frameNumber * 4) & 0xff;
+            unsigned char* pixel = pixels + (y * width + x) * t_stream.bpp;
+            switch(format)
+            {
+            case RS2_FORMAT_Z16:
+                *(uint16_t*)pixel = (uint16_t)(500 + value * 8 + (m_noise & 0x7));
+                break;
+            case RS2_FORMAT_RGB8:
+                pixel[0] = (unsigned char)(value + (m_noise & 0x3));
+                pixel[1] = (unsigned char)(x * 255 / width);
+                pixel[2] = (unsigned char)(y * 255 / height);
+                break;
+            default:
+                memset(pixel, value + (m_noise & 0x3), t_stream.bpp);
+                break;
+            }
+        }
+    }
+
+    double systemTime = std::chrono::duration<double, std::milli>(std::chrono::system_clock::now().time_since_epoch()).count();
+    t_sensor.sensor.on_video_frame({pixels, [](void* t_pixels) { delete[](unsigned char*) t_pixels; }, width * t_stream.bpp, t_stream.bpp, systemTime, RS2_TIMESTAMP_DOMAIN_SYSTEM_TIME, frameNumber, t_stream.profile.get()});
+}
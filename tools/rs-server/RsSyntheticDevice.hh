@@ -0,0 +1,53 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <librealsense2/rs.hpp>
+#include <librealsense2/hpp/rs_internal.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+// Software device with the sensors and the streams of a depth camera, that generates frames at the rate of the
+// streams that are played. The frames are stamped with the system time they were generated at, so the clients can
+// measure the latency from the frame generation to their callback. Used to run and benchmark the server without a camera.
+class RsSyntheticDevice
+{
+public:
+    RsSyntheticDevice();
+    ~RsSyntheticDevice();
+
+    rs2::device getDevice()
+    {
+        return m_device;
+    }
+
+private:
+    struct SyntheticStream
+    {
+        rs2::video_stream_profile profile;
+        int bpp;
+        int frameNumber;
+        std::chrono::steady_clock::time_point nextFrame;
+    };
+
+    struct SyntheticSensor
+    {
+        rs2::software_sensor sensor;
+        std::vector<SyntheticStream> streams;
+    };
+
+    void addStream(SyntheticSensor& t_sensor, rs2_stream t_type, int t_index, rs2_format t_format, int t_bpp, int t_width, int t_height, int t_fps);
+    void generateFrames();
+    void generateFrame(SyntheticSensor& t_sensor, SyntheticStream& t_stream);
+
+    rs2::software_device m_device;
+    std::vector<SyntheticSensor> m_sensors;
+    int m_nextStreamUid;
+    unsigned int m_noise;
+    std::atomic<bool> m_isGenerating;
+    std::thread m_generator;
+};
@@ -0,0 +1,158 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "catch.h"
+#include <cstring>
+#include <random>
+#include <vector>
+#include "./../src/compression/AdaptiveCompression.h"
+#include "./../src/compression/CompressionFactory.h"
+#include "./../src/compression/Lz4Compression.h"
+#include "./../src/compression/RvlBandsCompression.h"
+#include "./../src/compression/RvlCompression.h"
+
+// Depth like frame: a slope with holes of zeros, and a few sharp edges
+static std::vector<short> make_depth(int width, int height, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> noise(-3, 3);
+    std::vector<short> pixels(width * height);
+    for (int y = 0; y < height; y++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            short value = short(500 + 4 * x + 2 * y + noise(rng));
+            if ((x / 16 + y / 8) % 5 == 0)
+                value = 0;
+            if (x == width / 2)
+                value = short(30000 + y);
+            pixels[y * width + x] = value;
+        }
+    }
+    return pixels;
+}
+
+// Compresses and decompresses the frame the way the server and the clients do, the clients read the data after the size
+static std::vector<short> round_trip(ICompression& encoder, ICompression& decoder, std::vector<short>& pixels)
+{
+    int size = int(pixels.size() * sizeof(short));
+    std::vector<unsigned char> compressed(encoder.getMaxCompressedSize(size));
+    int compressedWithHeaderSize = encoder.compressBuffer((unsigned char*)pixels.data(), size, compressed.data());
+    REQUIRE(compressedWithHeaderSize != -1);
+    int compressedSize;
+    memcpy(&compressedSize, compressed.data(), sizeof(compressedSize));
+    REQUIRE(compressedSize + int(sizeof(int)) == compressedWithHeaderSize);
+
+    std::vector<short> decompressed(pixels.size(), -1);
+    REQUIRE(decoder.decompressBuffer(compressed.data() + sizeof(int), compressedSize, (unsigned char*)decompressed.data()) == size);
+    return decompressed;
+}
+
+TEST_CASE("RVL bands compression round trip", "[compression]")
+{
+    const int W = 640;
+    const int H = 480;
+    RvlBandsCompression encoder(W, H, RS2_FORMAT_Z16, 2);
+    RvlBandsCompression decoder(W, H, RS2_FORMAT_Z16, 2);
+
+    // the workers of the codecs are reused from one frame to the next
+    for (unsigned frame = 0; frame < 5; frame++)
+    {
+        auto pixels = make_depth(W, H, frame);
+        REQUIRE(round_trip(encoder, decoder, pixels) == pixels);
+    }
+
+    SECTION("all zeros")
+    {
+        std::vector<short> pixels(W * H, 0);
+        REQUIRE(round_trip(encoder, decoder, pixels) == pixels);
+    }
+
+    SECTION("fewer rows than bands")
+    {
+        RvlBandsCompression narrowEncoder(W, 1, RS2_FORMAT_Z16, 2);
+        RvlBandsCompression narrowDecoder(W, 1, RS2_FORMAT_Z16, 2);
+        auto pixels = make_depth(W, 1, 7);
+        REQUIRE(round_trip(narrowEncoder, narrowDecoder, pixels) == pixels);
+    }
+
+    SECTION("legacy RVL data is decoded")
+    {
+        RvlCompression legacyEncoder(W, H, RS2_FORMAT_Z16, 2);
+        auto pixels = make_depth(W, H, 11);
+        REQUIRE(round_trip(legacyEncoder, decoder, pixels) == pixels);
+    }
+
+    SECTION("corrupted data is rejected")
+    {
+        auto pixels = make_depth(W, H, 13);
+        int size = int(pixels.size() * sizeof(short));
+        std::vector<unsigned char> compressed(encoder.getMaxCompressedSize(size));
+        int compressedWithHeaderSize = encoder.compressBuffer((unsigned char*)pixels.data(), size, compressed.data());
+        REQUIRE(compressedWithHeaderSize != -1);
+        std::vector<short> decompressed(pixels.size());
+        // a truncated payload ends in the middle of a band
+        REQUIRE(decoder.decompressBuffer(compressed.data() + sizeof(int), compressedWithHeaderSize / 2, (unsigned char*)decompressed.data()) == -1);
+    }
+}
+
+TEST_CASE("Adaptive compression decodes the fixed depth method", "[compression]")
+{
+    const int W = 320;
+    const int H = 240;
+    auto pixels = make_depth(W, H, 3);
+    for (ZipMethod zipMethod : {ZipMethod::lz, ZipMethod::rvl, ZipMethod::rvl_bands})
+    {
+        for (bool isAdaptive : {false, true})
+        {
+            AdaptiveCompression encoder(W, H, RS2_FORMAT_Z16, RS2_STREAM_DEPTH, 2, zipMethod, isAdaptive);
+            // the clients never adapt, they follow the method of each frame
+            AdaptiveCompression decoder(W, H, RS2_FORMAT_Z16, RS2_STREAM_DEPTH, 2, zipMethod, false);
+            REQUIRE(round_trip(encoder, decoder, pixels) == pixels);
+        }
+    }
+}
+
+TEST_CASE("Depth compression method names", "[compression]")
+{
+    // the server sends the name of its depth method in the SDP, the clients parse it back
+    for (ZipMethod zipMethod : {ZipMethod::lz, ZipMethod::rvl, ZipMethod::rvl_bands})
+    {
+        ZipMethod parsed = ZipMethod::none;
+        REQUIRE(CompressionFactory::getDepthZipMethod(CompressionFactory::getDepthZipMethodName(zipMethod), parsed));
+        REQUIRE(parsed == zipMethod);
+    }
+
+    ZipMethod parsed = ZipMethod::lz;
+    for (auto name : {"", "3", "jpeg", "rvl-bands"})
+    {
+        REQUIRE_FALSE(CompressionFactory::getDepthZipMethod(name, parsed));
+        REQUIRE(parsed == ZipMethod::lz);
+    }
+}
+
+TEST_CASE("Compressed size bound", "[compression]")
+{
+    // noise does not compress, the codecs that write before checking the size must stay within their bound
+    const int W = 64;
+    const int H = 48;
+    const unsigned char GUARD = 0xA5;
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> noise(1, 0xFFFF);
+    std::vector<short> pixels(W * H);
+    for (auto& pixel : pixels)
+        pixel = short(noise(rng));
+    int size = int(pixels.size() * sizeof(short));
+
+    Lz4Compression lz4(W, H, RS2_FORMAT_Z16, 2);
+    RvlCompression rvl(W, H, RS2_FORMAT_Z16, 2);
+    RvlBandsCompression rvlBands(W, H, RS2_FORMAT_Z16, 2);
+    for (ICompression* codec : std::vector<ICompression*>{&lz4, &rvl, &rvlBands})
+    {
+        int bound = codec->getMaxCompressedSize(size);
+        std::vector<unsigned char> compressed(bound + 64, GUARD);
+        codec->compressBuffer((unsigned char*)pixels.data(), size, compressed.data());
+        for (int i = bound; i < int(compressed.size()); i++)
+            REQUIRE(compressed[i] == GUARD);
+    }
+}
@@ -0,0 +1,149 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "catch.h"
+#include <vector>
+#include <librealsense2/rs.hpp>
+#include <librealsense2/hpp/rs_internal.hpp>
+#include "./../tools/rs-server/RsFrameBroadcast.hh"
+
+// Publishes the frames of a software sensor to a broadcast, numbered from 1 in publishing order
+class broadcast_publisher
+{
+public:
+    broadcast_publisher(RsFrameBroadcast& broadcast)
+        : _sensor(_dev.add_sensor("software_sensor")), _published(0)
+    {
+        rs2_intrinsics intrinsics{ 4, 4, 0, 0, 0, 0, RS2_DISTORTION_NONE, { 0, 0, 0, 0, 0 } };
+        _profile = _sensor.add_video_stream({ RS2_STREAM_DEPTH, 0, 0, 4, 4, 30, 2, RS2_FORMAT_Z16, intrinsics });
+        _sensor.open(_profile);
+        // the software sensor delivers its frames from on_video_frame, so each frame is in the broadcast once published
+        _sensor.start([&broadcast](rs2::frame f) { broadcast.publish(f); });
+    }
+    ~broadcast_publisher()
+    {
+        _sensor.stop();
+        _sensor.close();
+    }
+
+    void publish(int frames)
+    {
+        for (int i = 0; i < frames; i++)
+        {
+            _published++;
+            _sensor.on_video_frame({ _pixels, [](void*) {}, 4 * 2, 2, (rs2_time_t)_published, RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, _published, _profile });
+        }
+    }
+
+private:
+    rs2::software_device _dev;
+    rs2::software_sensor _sensor;
+    rs2::stream_profile _profile;
+    int _published;
+    uint8_t _pixels[4 * 4 * 2] = {};
+};
+
+// Reads the numbers of the frames a reader has not read yet
+static std::vector<unsigned long long> read_numbers(RsFrameBroadcast& broadcast, unsigned int reader)
+{
+    std::vector<unsigned long long> numbers;
+    rs2::frame f;
+    while (broadcast.read(reader, f))
+        numbers.push_back(f.get_frame_number());
+    return numbers;
+}
+
+static std::vector<unsigned long long> numbers_range(unsigned long long first, unsigned long long last)
+{
+    std::vector<unsigned long long> numbers;
+    for (auto n = first; n <= last; n++)
+        numbers.push_back(n);
+    return numbers;
+}
+
+TEST_CASE("Frame broadcast fans out every frame to each reader", "[network]")
+{
+    RsFrameBroadcast broadcast(10);
+    broadcast_publisher publisher(broadcast);
+
+    // the first read attaches a reader, which starts from the next published frame
+    for (unsigned int reader : { 1, 2, 3 })
+        REQUIRE(read_numbers(broadcast, reader).empty());
+    publisher.publish(5);
+    REQUIRE(broadcast.getBacklog() == 5);
+
+    REQUIRE(read_numbers(broadcast, 1) == numbers_range(1, 5));
+    // the backlog is the one of the most advanced reader
+    REQUIRE(broadcast.getBacklog() == 0);
+    REQUIRE(read_numbers(broadcast, 2) == numbers_range(1, 5));
+    REQUIRE(read_numbers(broadcast, 3) == numbers_range(1, 5));
+    for (unsigned int reader : { 1, 2, 3 })
+        REQUIRE(broadcast.getDroppedFrames(reader) == 0);
+}
+
+TEST_CASE("Frame broadcast starts a late reader from the next frame", "[network]")
+{
+    RsFrameBroadcast broadcast(10);
+    broadcast_publisher publisher(broadcast);
+
+    // frames published before any reader are not kept
+    publisher.publish(3);
+    REQUIRE(read_numbers(broadcast, 1).empty());
+    publisher.publish(3);
+
+    // a reader that attaches later does not get the frames the others did not read yet
+    REQUIRE(read_numbers(broadcast, 2).empty());
+    publisher.publish(2);
+    REQUIRE(read_numbers(broadcast, 1) == numbers_range(4, 8));
+    REQUIRE(read_numbers(broadcast, 2) == numbers_range(7, 8));
+    REQUIRE(broadcast.getDroppedFrames(2) == 0);
+}
+
+TEST_CASE("Frame broadcast skips the frames a slow reader missed", "[network]")
+{
+    const unsigned int capacity = 4;
+    RsFrameBroadcast broadcast(capacity);
+    broadcast_publisher publisher(broadcast);
+
+    REQUIRE(read_numbers(broadcast, 1).empty());
+    REQUIRE(read_numbers(broadcast, 2).empty());
+    publisher.publish(10);
+
+    // the slow reader does not hold the frames back, it continues from the oldest frame that is kept
+    REQUIRE(read_numbers(broadcast, 1) == numbers_range(7, 10));
+    REQUIRE(broadcast.getDroppedFrames(1) == 6);
+    REQUIRE(read_numbers(broadcast, 2) == numbers_range(7, 10));
+    REQUIRE(broadcast.getDroppedFrames(2) == 6);
+}
+
+TEST_CASE("Frame broadcast detaches a reader with frames in flight", "[network]")
+{
+    RsFrameBroadcast broadcast(10);
+    broadcast_publisher publisher(broadcast);
+
+    REQUIRE(read_numbers(broadcast, 1).empty());
+    REQUIRE(read_numbers(broadcast, 2).empty());
+    publisher.publish(4);
+
+    // the leaving reader still holds a frame it read, and did not read the others
+    rs2::frame in_flight;
+    REQUIRE(broadcast.read(1, in_flight));
+    broadcast.detach(1);
+    REQUIRE(in_flight.get_frame_number() == 1);
+    REQUIRE(broadcast.getDroppedFrames(1) == 0);
+
+    // the other reader gets every frame, and the leaving reader no longer counts in the backlog
+    publisher.publish(2);
+    REQUIRE(broadcast.getBacklog() == 6);
+    REQUIRE(read_numbers(broadcast, 2) == numbers_range(1, 6));
+    REQUIRE(broadcast.getBacklog() == 0);
+    REQUIRE(in_flight.get_frame_number() == 1);
+
+    // the last reader leaving releases the frames, and publishing does not keep any for nobody
+    broadcast.detach(2);
+    REQUIRE(broadcast.getBacklog() == 0);
+    publisher.publish(2);
+    REQUIRE(read_numbers(broadcast, 3).empty());
+    publisher.publish(1);
+    REQUIRE(read_numbers(broadcast, 3) == numbers_range(9, 9));
+}
@@ -187,4 +187,48 @@ TEST_CASE("named_mutex_processes", "[code]")
         sem_close(sem2);
         REQUIRE(child_alive == actual_test);
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("v4l_capture_reactor", "[code]")
+{
+    v4l_capture_reactor reactor(2);
+
+    int fds[2];
+    REQUIRE(pipe2(fds, O_NONBLOCK) == 0);
+
+    std::mutex m;
+    std::condition_variable cv;
+    int bytes_read = 0;
+    int timeouts = 0;
+    auto id = reactor.add(fds[0], [&]()
+    {
+        // drains the pipe, as the fd is edge triggered
+        char buff[16];
+        ssize_t count;
+        while ((count = read(fds[0], buff, sizeof(buff))) > 0)
+        {
+            std::lock_guard<std::mutex> lock(m);
+            bytes_read += count;
+        }
+        cv.notify_all();
+    }, [&]() { timeouts++; });
+
+    for (int i = 0; i < 10; i++)
+    {
+        REQUIRE(write(fds[1], "x", 1) == 1);
+        std::unique_lock<std::mutex> lock(m);
+        REQUIRE(cv.wait_for(lock, std::chrono::seconds(1), [&]() { return bytes_read == i + 1; }));
+    }
+
+    reactor.remove(id);
+    REQUIRE(write(fds[1], "x", 1) == 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    {
+        std::lock_guard<std::mutex> lock(m);
+        REQUIRE(bytes_read == 10);
+    }
+    REQUIRE(timeouts == 0);
+
+    close(fds[0]);
+    close(fds[1]);
+}
@@ -0,0 +1,88 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "catch.h"
+#include <cstring>
+#include <vector>
+#include "./../src/ipDeviceCommon/MemoryPool.h"
+
+TEST_CASE("Memory pool reuses the buffers of each size", "[network]")
+{
+    const unsigned int size = 1000;
+    MemoryPool pool;
+
+    unsigned char* first = pool.getNextMem(size);
+    REQUIRE(first != nullptr);
+    // the frame data is 16 bytes aligned
+    REQUIRE(reinterpret_cast<uintptr_t>(first) % 16 == 0);
+    pool.returnMem(first);
+    REQUIRE(pool.getStatistic().freeBytes == size);
+
+    REQUIRE(pool.getNextMem(size) == first);
+    unsigned char* other = pool.getNextMem(size + 1);
+    REQUIRE(other != first);
+    auto statistic = pool.getStatistic();
+    REQUIRE(statistic.allocatedBuffers == 2);
+    REQUIRE(statistic.reusedBuffers == 1);
+    REQUIRE(statistic.freeBytes == 0);
+
+    pool.returnMem(first);
+    pool.returnMem(other);
+    REQUIRE(pool.getStatistic().freeBytes == 2 * size + 1);
+
+    SECTION("stopping a stream releases the buffers of its size")
+    {
+        pool.trim(size);
+        REQUIRE(pool.getStatistic().freeBytes == size + 1);
+        pool.returnMem(pool.getNextMem(size));
+        REQUIRE(pool.getStatistic().allocatedBuffers == 3);
+    }
+}
+
+TEST_CASE("Memory pool keeps a bounded number of free buffers", "[network]")
+{
+    MemoryPool pool;
+
+    SECTION("per size")
+    {
+        const unsigned int size = 1000;
+        std::vector<unsigned char*> buffers;
+        for (int i = 0; i < 2 * POOL_MAX_FREE_BUFFERS_PER_SIZE; i++)
+            buffers.push_back(pool.getNextMem(size));
+        for (auto buffer : buffers)
+            pool.returnMem(buffer);
+        REQUIRE(pool.getStatistic().freeBytes == POOL_MAX_FREE_BUFFERS_PER_SIZE * size);
+    }
+
+    SECTION("in total")
+    {
+        const unsigned int size = POOL_MAX_FREE_BYTES / 2 + 1;
+        unsigned char* first = pool.getNextMem(size);
+        unsigned char* second = pool.getNextMem(size);
+        pool.returnMem(first);
+        pool.returnMem(second);
+        REQUIRE(pool.getStatistic().freeBytes == size);
+    }
+}
+
+TEST_CASE("Memory pool returns a frame buffer from its data", "[network]")
+{
+    const unsigned int dataSize = 640 * 480 * 2;
+    MemoryPool pool;
+
+    // the network devices hand the data after the frame header to the frames, and their deleter returns that address
+    unsigned char* buffer = pool.getNextMem(sizeof(RsFrameHeader) + dataSize);
+    memset(buffer, 0, sizeof(RsFrameHeader) + dataSize);
+    unsigned char* frameData = buffer + sizeof(RsFrameHeader);
+
+    // the data address is not the start of a buffer, so it is rejected rather than corrupting the pool
+    pool.returnMem(frameData);
+    REQUIRE(pool.getStatistic().freeBytes == 0);
+
+    pool.returnFrameMem(frameData);
+    REQUIRE(pool.getStatistic().freeBytes == sizeof(RsFrameHeader) + dataSize);
+    unsigned char* reused = pool.getNextMem(sizeof(RsFrameHeader) + dataSize);
+    REQUIRE(reused == buffer);
+    REQUIRE(pool.getStatistic().reusedBuffers == 1);
+    pool.returnMem(reused);
+}
@@ -0,0 +1,74 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "catch.h"
+#include <cmath>
+#include <librealsense2/rs.hpp>
+#include "./../src/source.h"
+#include "./../src/stream.h"
+#include "./../src/proc/synthetic-stream.h"
+#include "./../src/proc/motion-transform.h"
+
+using namespace librealsense;
+
+TEST_CASE("Motion transform converts a batch of samples", "[code]")
+{
+    const int samples = 4;
+    const size_t raw_stride = 16; // the raw samples are 8-bytes aligned, as the HID sensor batches them
+
+    frame_source source;
+    source.init(std::make_shared<metadata_parser_map>());
+
+    auto profile = std::make_shared<motion_stream_profile>(platform::stream_profile{ 0, 0, 200, 0 });
+    profile->set_stream_type(RS2_STREAM_ACCEL);
+    profile->set_format(RS2_FORMAT_MOTION_RAW);
+    profile->set_framerate(200);
+
+    frame_additional_data data{};
+    data.timestamp = 100 + samples - 1;
+    frame_holder batch(source.alloc_frame(RS2_EXTENSION_MOTION_FRAME, (raw_stride + sizeof(rs2_time_t)) * samples, data, true));
+    REQUIRE(batch);
+    auto raw = const_cast<byte*>(batch->get_frame_data());
+    for (int i = 0; i < samples; i++)
+    {
+        hid_data sample{};
+        sample.x = static_cast<short>(1000 * (i + 1));
+        sample.y = static_cast<short>(-1000 * (i + 1));
+        sample.z = 0;
+        memcpy(raw + raw_stride * i, &sample, sizeof(sample));
+        reinterpret_cast<rs2_time_t*>(raw + raw_stride * samples)[i] = 100 + i;
+    }
+    static_cast<frame*>(batch.frame)->additional_data.motion_samples = samples;
+    batch->set_stream(profile);
+
+    rs2::frame result;
+    acceleration_transform accel;
+    accel.set_output_callback({ new internal_frame_callback<std::function<void(frame_interface*)>>([&](frame_interface* f)
+    {
+        result = rs2::frame((rs2_frame*)f);
+    }), [](rs2_frame_callback* p) { p->release(); } });
+    accel.invoke(std::move(batch));
+
+    REQUIRE(result);
+    auto motion = result.as<rs2::motion_frame>();
+    REQUIRE(motion);
+    REQUIRE(motion.get_profile().format() == RS2_FORMAT_MOTION_XYZ32F);
+    REQUIRE(motion.get_samples_count() == samples);
+    // the packed samples are followed by their timestamps
+    REQUIRE(motion.get_data_size() == samples * (3 * sizeof(float) + sizeof(rs2_time_t)));
+
+    const float gravity = 9.80665f;
+    for (int i = 0; i < samples; i++)
+    {
+        auto xyz = motion.get_motion_data(i);
+        CAPTURE(i);
+        REQUIRE(std::fabs(xyz.x - (i + 1) * gravity) < 1e-3f);
+        REQUIRE(std::fabs(xyz.y + (i + 1) * gravity) < 1e-3f);
+        REQUIRE(std::fabs(xyz.z) < 1e-3f);
+        REQUIRE(motion.get_sample_timestamp(i) == 100 + i);
+    }
+
+    REQUIRE_THROWS(motion.get_motion_data(samples));
+    REQUIRE_THROWS(motion.get_motion_data(-1));
+    REQUIRE_THROWS(motion.get_sample_timestamp(samples));
+}
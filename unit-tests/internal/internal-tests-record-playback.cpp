@@ -0,0 +1,593 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "catch.h"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <thread>
+#include <librealsense2/rs.hpp>
+#include <librealsense2/hpp/rs_internal.hpp>
+#include "./../unit-tests-common.h"
+#include "./../src/context.h"
+#include "./../src/media/ros/ros_reader.h"
+#include "./../src/media/ros/ros_multi_file_reader.h"
+#include "./../src/media/ros/ros_writer.h"
+#include "./../src/media/playback/playback_device.h"
+
+using namespace librealsense;
+using namespace librealsense::device_serializer;
+
+// The value of byte i of the pixels of the recorded frame number
+static uint8_t recorded_pixel(unsigned long long number, size_t i)
+{
+    return static_cast<uint8_t>(number * 7 + i);
+}
+
+// Records depth frames numbered from 1, injected to a software device every interval
+static void record_software_depth(rs2::recorder recorder, rs2::software_sensor sensor, rs2::stream_profile depth,
+    int frames, std::chrono::milliseconds interval)
+{
+    const int W = 64;
+    const int H = 48;
+    const int BPP = 2;
+
+    // the software frames reference the pixels, so each frame keeps its own until the sensor is closed
+    std::vector<std::vector<uint8_t>> pixels(frames, std::vector<uint8_t>(W * H * BPP));
+    sensor.open(depth);
+    sensor.start([](rs2::frame) {});
+    for (int i = 1; i <= frames; i++)
+    {
+        auto& frame_pixels = pixels[i - 1];
+        for (size_t j = 0; j < frame_pixels.size(); j++)
+            frame_pixels[j] = recorded_pixel(i, j);
+        sensor.on_video_frame({ frame_pixels.data(), [](void*) {}, W * BPP, BPP, (rs2_time_t)i, RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, i, depth });
+        std::this_thread::sleep_for(interval);
+    }
+    sensor.stop();
+    sensor.close();
+}
+
+static rs2::stream_profile add_software_depth(rs2::software_sensor& sensor)
+{
+    rs2_intrinsics intrinsics{ 64, 48, 0, 0, 0, 0, RS2_DISTORTION_NONE ,{ 0,0,0,0,0 } };
+    return sensor.add_video_stream({ RS2_STREAM_DEPTH, 0, 0, 64, 48, 30, 2, RS2_FORMAT_Z16, intrinsics });
+}
+
+// Reads the timestamp and the number of every frame of the file
+static std::vector<std::pair<nanoseconds, unsigned long long>> read_all_frames(reader& r)
+{
+    std::vector<std::pair<nanoseconds, unsigned long long>> frames;
+    while (true)
+    {
+        auto data = r.read_next_data();
+        if (data->is<serialized_end_of_file>())
+            return frames;
+        if (auto frame = data->as<serialized_frame>())
+            frames.emplace_back(frame->get_timestamp(), frame->frame->get_frame_number());
+    }
+}
+
+static const stream_identifier recorded_depth{ 0, 0, RS2_STREAM_DEPTH, 0 };
+
+TEST_CASE("ros_reader last frames and seek", "[code][record]")
+{
+    const std::string file = get_folder_path(special_folder::temp_folder) + "ros_reader_seek.bag";
+    {
+        rs2::software_device dev;
+        auto sensor = dev.add_sensor("software_sensor");
+        auto depth = add_software_depth(sensor);
+        record_software_depth(rs2::recorder(file, dev), sensor, depth, 20, std::chrono::milliseconds(10));
+    }
+
+    auto ctx = std::make_shared<context>(backend_type::standard);
+    ros_reader r(file, ctx);
+    r.enable_stream({ recorded_depth });
+    auto frames = read_all_frames(r);
+    REQUIRE(frames.size() == 20);
+
+    // the last frame at or before each time, looked up through the frames time index
+    for (size_t i = 0; i < frames.size(); i++)
+    {
+        for (auto time : { frames[i].first, frames[i].first + std::chrono::microseconds(500) })
+        {
+            CAPTURE(i);
+            auto last = r.fetch_last_frames(time);
+            REQUIRE(last.size() == 1);
+            REQUIRE(last[0]->get_timestamp() == frames[i].first);
+            REQUIRE(last[0]->as<serialized_frame>()->frame->get_frame_number() == frames[i].second);
+        }
+    }
+    REQUIRE(r.fetch_last_frames(frames.front().first - std::chrono::microseconds(1)).empty());
+
+    // a seek continues from the first frame at or after the requested time
+    for (size_t i = 0; i < frames.size(); i++)
+    {
+        auto time = frames[i].first - std::chrono::microseconds(1);
+        if (time > r.query_duration())
+            break;
+        CAPTURE(i);
+        r.seek_to_time(time);
+        auto rest = read_all_frames(r);
+        REQUIRE(rest.size() == frames.size() - i);
+        REQUIRE(rest.front() == frames[i]);
+    }
+}
+
+TEST_CASE("ros_reader image frames hold the recorded pixels", "[code][record]")
+{
+    // with and without compression, so both the mapped and the copied images are read
+    for (bool compression : { false, true })
+    {
+        CAPTURE(compression);
+        const std::string file = get_folder_path(special_folder::temp_folder) + "ros_reader_image_size.bag";
+        {
+            rs2::software_device dev;
+            auto sensor = dev.add_sensor("software_sensor");
+            auto depth = add_software_depth(sensor);
+            record_software_depth(rs2::recorder(file, dev, compression), sensor, depth, 5, std::chrono::milliseconds(10));
+        }
+
+        auto ctx = std::make_shared<context>(backend_type::standard);
+        ros_reader r(file, ctx);
+        r.enable_stream({ recorded_depth });
+        int frames = 0;
+        while (true)
+        {
+            auto data = r.read_next_data();
+            if (data->is<serialized_end_of_file>())
+                break;
+            if (auto frame = data->as<serialized_frame>())
+            {
+                auto video = dynamic_cast<video_frame*>(frame->frame.frame);
+                REQUIRE(video != nullptr);
+                REQUIRE(video->get_frame_data_size() == video->get_stride() * video->get_height());
+                REQUIRE(video->get_frame_data_size() == 64 * 2 * 48);
+
+                // an uncompressed image references the pixels in the mapped file instead of a buffer of the frame
+                REQUIRE(video->data.empty() == !compression);
+                auto pixels = video->get_frame_data();
+                auto number = video->get_frame_number();
+                for (int i = 0; i < video->get_frame_data_size(); i++)
+                {
+                    if (pixels[i] != recorded_pixel(number, i))
+                    {
+                        CAPTURE(number);
+                        CAPTURE(i);
+                        REQUIRE(int(pixels[i]) == int(recorded_pixel(number, i)));
+                    }
+                }
+                frames++;
+            }
+        }
+        REQUIRE(frames == 5);
+    }
+}
+
+// Counts the frames a playback device reads ahead of its consumer
+class counting_reader : public reader
+{
+public:
+    explicit counting_reader(std::shared_ptr<reader> r) : frames_read(0), _reader(r) {}
+
+    device_snapshot query_device_description(const nanoseconds& time) override { return _reader->query_device_description(time); }
+    std::shared_ptr<serialized_data> read_next_data() override
+    {
+        auto data = _reader->read_next_data();
+        if (data->is<serialized_frame>())
+            frames_read++;
+        return data;
+    }
+    void seek_to_time(const nanoseconds& time) override { _reader->seek_to_time(time); }
+    nanoseconds query_duration() const override { return _reader->query_duration(); }
+    void reset() override { _reader->reset(); }
+    void enable_stream(const std::vector<stream_identifier>& stream_ids) override { _reader->enable_stream(stream_ids); }
+    void disable_stream(const std::vector<stream_identifier>& stream_ids) override { _reader->disable_stream(stream_ids); }
+    const std::string& get_file_name() const override { return _reader->get_file_name(); }
+    std::vector<std::shared_ptr<serialized_data>> fetch_last_frames(const nanoseconds& seek_time) override { return _reader->fetch_last_frames(seek_time); }
+    void set_blocking(bool blocking) override { _reader->set_blocking(blocking); }
+
+    std::atomic<int> frames_read;
+
+private:
+    std::shared_ptr<reader> _reader;
+};
+
+TEST_CASE("Non real time playback delivers every frame to a slow consumer", "[code][record]")
+{
+    const int frames = 100;
+    // more than the 32 frames of the reader's frames pool
+    const size_t held_frames = 40;
+    // the stream's queue of 16 frames, the frame being delivered and the one the reading thread waits to enqueue
+    const int max_read_ahead = 18;
+
+    const std::string file = get_folder_path(special_folder::temp_folder) + "non_real_time_playback.bag";
+    {
+        rs2::software_device dev;
+        auto sensor = dev.add_sensor("software_sensor");
+        auto depth = add_software_depth(sensor);
+        record_software_depth(rs2::recorder(file, dev), sensor, depth, frames, std::chrono::milliseconds(1));
+    }
+
+    auto ctx = std::make_shared<context>(backend_type::standard);
+    auto r = std::make_shared<counting_reader>(std::make_shared<ros_reader>(file, ctx));
+    auto dev = std::make_shared<playback_device>(ctx, r);
+    dev->set_real_time(false);
+    auto& sensor = dev->get_sensor(0);
+
+    std::mutex m;
+    std::condition_variable cv;
+    std::vector<unsigned long long> delivered;
+    std::deque<frame_holder> held;
+    int read_ahead = 0;
+    sensor.open(sensor.get_stream_profiles());
+    sensor.start({ new internal_frame_callback<std::function<void(frame_interface*)>>([&](frame_interface* f)
+    {
+        frame_holder frame(f);
+        auto number = frame->get_frame_number();
+        // a slow consumer that keeps the last frames it got
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        std::lock_guard<std::mutex> lock(m);
+        read_ahead = std::max(read_ahead, r->frames_read - static_cast<int>(delivered.size()));
+        delivered.push_back(number);
+        held.push_back(std::move(frame));
+        if (held.size() > held_frames)
+            held.pop_front();
+        cv.notify_one();
+    }), [](rs2_frame_callback* p) { p->release(); } });
+
+    {
+        std::unique_lock<std::mutex> lock(m);
+        cv.wait_for(lock, std::chrono::seconds(10), [&]() { return delivered.size() == frames; });
+    }
+    sensor.stop();
+    sensor.close();
+    held.clear();
+
+    REQUIRE(delivered.size() == frames);
+    for (size_t i = 0; i < delivered.size(); i++)
+        REQUIRE(delivered[i] == i + 1);
+    // the reading thread waits for the consumer instead of reading the whole file ahead of it
+    REQUIRE(read_ahead <= max_read_ahead);
+}
+
+TEST_CASE("get_segment_file_name", "[code][record]")
+{
+    REQUIRE(get_segment_file_name("rec.bag", 0) == "rec.bag");
+    REQUIRE(get_segment_file_name("rec.bag", 1) == "rec_1.bag");
+    REQUIRE(get_segment_file_name("/data/rec.bag", 12) == "/data/rec_12.bag");
+    REQUIRE(get_segment_file_name("C:\\data\\rec.bag", 2) == "C:\\data\\rec_2.bag");
+    REQUIRE(get_segment_file_name("/data.old/rec", 3) == "/data.old/rec_3");
+    REQUIRE(get_segment_file_name("rec", 1) == "rec_1");
+}
+
+// Plays each file of a split recording on its own and returns the frames of each file
+static std::vector<std::vector<std::pair<nanoseconds, unsigned long long>>> read_segments(const std::string& file)
+{
+    std::vector<std::vector<std::pair<nanoseconds, unsigned long long>>> segments;
+    auto ctx = std::make_shared<context>(backend_type::standard);
+    for (uint32_t i = 0; file_exists(get_segment_file_name(file, i)); i++)
+    {
+        ros_reader r(get_segment_file_name(file, i), ctx);
+        r.enable_stream({ recorded_depth });
+        segments.push_back(read_all_frames(r));
+    }
+    return segments;
+}
+
+static void remove_segments(const std::string& file)
+{
+    for (uint32_t i = 0; i < 100; i++)
+        std::remove(get_segment_file_name(file, i).c_str());
+}
+
+TEST_CASE("Split recording rolls over by size and by duration", "[code][record]")
+{
+    const int frames = 20;
+    const std::string folder = get_folder_path(special_folder::temp_folder);
+
+    SECTION("by size")
+    {
+        // each frame holds 6KB of pixels, so a file is full after a few frames
+        const uint64_t max_size = 20000;
+        const std::string file = folder + "split_by_size.bag";
+        remove_segments(file);
+        {
+            rs2::software_device dev;
+            auto sensor = dev.add_sensor("software_sensor");
+            auto depth = add_software_depth(sensor);
+            record_software_depth(rs2::recorder(file, dev, false, max_size, std::chrono::milliseconds(0)), sensor, depth,
+                frames, std::chrono::milliseconds(0));
+        }
+
+        auto segments = read_segments(file);
+        REQUIRE(segments.size() > 2);
+        REQUIRE_FALSE(file_exists(get_segment_file_name(file, static_cast<uint32_t>(segments.size()))));
+
+        unsigned long long expected_number = 1;
+        for (size_t i = 0; i < segments.size(); i++)
+        {
+            CAPTURE(i);
+            REQUIRE_FALSE(segments[i].empty());
+            for (auto&& frame : segments[i])
+                REQUIRE(frame.second == expected_number++);
+        }
+        REQUIRE(expected_number == frames + 1);
+    }
+
+    SECTION("by duration")
+    {
+        // the frames are written at set times, so the split points do not depend on the time the test takes
+        const auto max_duration = std::chrono::milliseconds(50);
+        const auto interval = std::chrono::milliseconds(10);
+        const std::string file = folder + "split_by_duration.bag";
+        remove_segments(file);
+        {
+            rs2::software_device dev;
+            auto sensor = dev.add_sensor("software_sensor");
+            auto depth = add_software_depth(sensor);
+            auto info = std::make_shared<info_container>();
+            info->register_info(RS2_CAMERA_INFO_NAME, "software_sensor");
+            snapshot_collection sensor_extensions;
+            sensor_extensions[RS2_EXTENSION_INFO] = info;
+            std::shared_ptr<stream_profile_interface> profile;
+            depth.get()->profile->create_snapshot(profile);
+
+            ros_writer writer(file, false, 0, max_duration);
+            writer.write_device_description(device_snapshot({}, { sensor_snapshot(0, sensor_extensions) }, {}));
+            writer.write_snapshot(sensor_identifier{ 0, 0 }, get_static_file_info_timestamp(), RS2_EXTENSION_VIDEO_PROFILE,
+                std::dynamic_pointer_cast<extension_snapshot>(profile));
+
+            const int W = 64;
+            const int H = 48;
+            const int BPP = 2;
+            std::vector<uint8_t> pixels(W * H * BPP, 0);
+            int written = 0;
+            sensor.open(depth);
+            sensor.start([&](rs2::frame f)
+            {
+                written++;
+                auto frame = (frame_interface*)f.get();
+                frame->acquire();
+                writer.write_frame(recorded_depth, written * interval, frame_holder(frame));
+            });
+            for (int i = 1; i <= frames; i++)
+                sensor.on_video_frame({ pixels.data(), [](void*) {}, W * BPP, BPP, (rs2_time_t)i, RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, i, depth });
+            sensor.stop();
+            sensor.close();
+            REQUIRE(written == frames);
+        }
+
+        // a file is full once its first frame is max_duration behind the frame to write,
+        // and each following file starts at the last frame of the file before it
+        auto segments = read_segments(file);
+        const size_t frames_per_file = static_cast<size_t>(max_duration / interval - 1);
+        REQUIRE(segments.size() == frames / frames_per_file);
+
+        unsigned long long expected_number = 1;
+        for (size_t i = 0; i < segments.size(); i++)
+        {
+            CAPTURE(i);
+            REQUIRE(segments[i].size() == frames_per_file);
+            for (size_t j = 0; j < segments[i].size(); j++)
+            {
+                // the timeline of each file starts at the split
+                auto expected_time = std::chrono::duration_cast<std::chrono::nanoseconds>(interval).count() * int64_t(j + 1);
+                REQUIRE(std::abs(int64_t(segments[i][j].first.count()) - expected_time) < 1000);
+                REQUIRE(segments[i][j].second == expected_number++);
+            }
+
+            // the stream profile is written once to every file
+            ros_reader r(get_segment_file_name(file, static_cast<uint32_t>(i)), std::make_shared<context>(backend_type::standard));
+            auto sensors = r.query_device_description(get_static_file_info_timestamp()).get_sensors_snapshots();
+            REQUIRE(sensors.size() == 1);
+            REQUIRE(sensors[0].get_stream_profiles().size() == 1);
+        }
+        REQUIRE(expected_number == frames + 1);
+    }
+}
+
+TEST_CASE("Multi-file recording names", "[code][record]")
+{
+    SECTION("wildcard_match")
+    {
+        REQUIRE(ros_multi_file_reader::wildcard_match("rec_*.bag", "rec_1.bag"));
+        REQUIRE(ros_multi_file_reader::wildcard_match("rec_*.bag", "rec_.bag"));
+        REQUIRE_FALSE(ros_multi_file_reader::wildcard_match("rec_*.bag", "rec.bag"));
+        REQUIRE(ros_multi_file_reader::wildcard_match("rec_?.bag", "rec_2.bag"));
+        REQUIRE_FALSE(ros_multi_file_reader::wildcard_match("rec_?.bag", "rec_10.bag"));
+        REQUIRE(ros_multi_file_reader::wildcard_match("a*b*c", "aXbYbc"));
+        REQUIRE_FALSE(ros_multi_file_reader::wildcard_match("a*b", "aXbc"));
+        REQUIRE(ros_multi_file_reader::wildcard_match("*", ""));
+        REQUIRE_FALSE(ros_multi_file_reader::wildcard_match("", "a"));
+    }
+
+    SECTION("natural_less")
+    {
+        std::vector<std::string> names = { "rec_10.bag", "rec_2.bag", "rec.bag", "rec_1.bag", "rec_1b.bag" };
+        std::sort(names.begin(), names.end(), ros_multi_file_reader::natural_less);
+        REQUIRE(names == std::vector<std::string>({ "rec.bag", "rec_1.bag", "rec_1b.bag", "rec_2.bag", "rec_10.bag" }));
+
+        // leading zeros do not change the value of a number
+        REQUIRE_FALSE(ros_multi_file_reader::natural_less("rec_01", "rec_1"));
+        REQUIRE_FALSE(ros_multi_file_reader::natural_less("rec_1", "rec_01"));
+        REQUIRE(ros_multi_file_reader::natural_less("rec_9", "rec_010"));
+    }
+
+    SECTION("list_files")
+    {
+        const std::string folder = get_folder_path(special_folder::temp_folder);
+        for (auto name : { "list_files_test_10.bag", "list_files_test_2.bag", "list_files_test_1.bag" })
+            std::ofstream(folder + name) << "#ROSBAG";
+
+        REQUIRE(ros_multi_file_reader::list_files(folder + "list_files_test_*.bag") == std::vector<std::string>({
+            folder + "list_files_test_1.bag", folder + "list_files_test_2.bag", folder + "list_files_test_10.bag" }));
+        REQUIRE_THROWS(ros_multi_file_reader::list_files(folder + "list_files_test_*.none"));
+
+        // a bag file is a recording of its own
+        REQUIRE(ros_multi_file_reader::list_files(folder + "list_files_test_2.bag") == std::vector<std::string>({ folder + "list_files_test_2.bag" }));
+
+        // a text file lists the files, relative to its own folder
+        std::ofstream(folder + "list_files_test.txt") << "# recording\n list_files_test_2.bag \n\n/data/rec.bag\n";
+        REQUIRE(ros_multi_file_reader::list_files(folder + "list_files_test.txt") == std::vector<std::string>({
+            folder + "list_files_test_2.bag", "/data/rec.bag" }));
+    }
+}
+
+TEST_CASE("Multi-file recording seeks across files", "[code][record]")
+{
+    const int frames = 20;
+    const std::string file = get_folder_path(special_folder::temp_folder) + "multi_file_seek.bag";
+    remove_segments(file);
+    {
+        rs2::software_device dev;
+        auto sensor = dev.add_sensor("software_sensor");
+        auto depth = add_software_depth(sensor);
+        record_software_depth(rs2::recorder(file, dev, false, 20000, std::chrono::milliseconds(0)), sensor, depth,
+            frames, std::chrono::milliseconds(5));
+    }
+    auto segments = read_segments(file);
+    REQUIRE(segments.size() > 2);
+
+    std::vector<std::string> files;
+    for (uint32_t i = 0; i < segments.size(); i++)
+        files.push_back(get_segment_file_name(file, i));
+
+    auto ctx = std::make_shared<context>(backend_type::standard);
+    ros_multi_file_reader r(file, files, ctx);
+    r.enable_stream({ recorded_depth });
+    auto recording = read_all_frames(r);
+    REQUIRE(recording.size() == frames);
+
+    // the files follow each other on one timeline that starts at the first frame and ends at the last one,
+    // and the frames on both sides of a split keep the time between them
+    REQUIRE(recording.front().first == nanoseconds::zero());
+    REQUIRE(recording.back().first == r.query_duration());
+    for (size_t i = 0; i < recording.size(); i++)
+    {
+        REQUIRE(recording[i].second == i + 1);
+        if (i > 0)
+            REQUIRE(recording[i].first > recording[i - 1].first);
+    }
+
+    // the duration is known before the playback reaches the last file
+    REQUIRE(ros_multi_file_reader(file, files, ctx).query_duration() == recording.back().first);
+
+    // a seek lands on the first frame at or after the requested time, whichever file holds it
+    for (size_t i = 0; i < recording.size(); i++)
+    {
+        for (auto time : { recording[i].first, recording[i].first - std::chrono::microseconds(1) })
+        {
+            if (time < nanoseconds::zero())
+                continue;
+            CAPTURE(i);
+            CAPTURE(time.count());
+            auto first = std::find_if(recording.begin(), recording.end(),
+                [&](const std::pair<nanoseconds, unsigned long long>& f) { return f.first >= time; });
+            r.seek_to_time(time);
+            auto rest = read_all_frames(r);
+            REQUIRE(rest == std::vector<std::pair<nanoseconds, unsigned long long>>(first, recording.end()));
+
+            r.seek_to_time(time);
+            auto last = r.fetch_last_frames(time);
+            if (first != recording.end() && first->first == time)
+            {
+                REQUIRE(last.size() == 1);
+                REQUIRE(last[0]->get_timestamp() == time);
+            }
+        }
+    }
+}
+
+TEST_CASE("Multi-file playback of separate recordings", "[code][record]")
+{
+    const int frames = 5;
+    std::vector<std::string> files;
+    for (auto name : { "multi_file_separate_1.bag", "multi_file_separate_2.bag" })
+    {
+        files.push_back(get_folder_path(special_folder::temp_folder) + name);
+        rs2::software_device dev;
+        auto sensor = dev.add_sensor("software_sensor");
+        auto depth = add_software_depth(sensor);
+        record_software_depth(rs2::recorder(files.back(), dev), sensor, depth, frames, std::chrono::milliseconds(10));
+    }
+
+    // files that were not split from one recording start right after the previous file ends
+    auto ctx = std::make_shared<context>(backend_type::standard);
+    ros_multi_file_reader r(files.front(), files, ctx);
+    r.enable_stream({ recorded_depth });
+    REQUIRE(r.query_duration() > nanoseconds::zero());
+    auto recording = read_all_frames(r);
+    REQUIRE(recording.size() == 2 * frames);
+    REQUIRE(recording.back().first == r.query_duration());
+    for (size_t i = 0; i < recording.size(); i++)
+    {
+        CAPTURE(i);
+        REQUIRE(recording[i].second == i % frames + 1);
+        if (i > 0)
+            REQUIRE(recording[i].first > recording[i - 1].first);
+    }
+
+    // the time between the files belongs to the first one, so a seek there continues from the second one
+    auto second_start = recording[frames].first;
+    r.seek_to_time(second_start - std::chrono::nanoseconds(1));
+    REQUIRE(read_all_frames(r) == std::vector<std::pair<nanoseconds, unsigned long long>>(recording.begin() + frames, recording.end()));
+}
+
+TEST_CASE("Multi-file recording last frames look back across files", "[code][record]")
+{
+    const int W = 64;
+    const int H = 48;
+    const int BPP = 2;
+    const std::string file = get_folder_path(special_folder::temp_folder) + "multi_file_last_frames.bag";
+    remove_segments(file);
+    {
+        // the second sensor sends a single frame at the start, so only the first file holds a frame of it
+        rs2::software_device dev;
+        auto sensor = dev.add_sensor("software_sensor");
+        auto depth = add_software_depth(sensor);
+        auto other_sensor = dev.add_sensor("other_software_sensor");
+        auto other_depth = add_software_depth(other_sensor);
+        rs2::recorder recorder(file, dev, false, 20000, std::chrono::milliseconds(0));
+
+        std::vector<uint8_t> pixels(W * H * BPP, 0);
+        other_sensor.open(other_depth);
+        other_sensor.start([](rs2::frame) {});
+        other_sensor.on_video_frame({ pixels.data(), [](void*) {}, W * BPP, BPP, 0., RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, 1, other_depth });
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        record_software_depth(recorder, sensor, depth, 20, std::chrono::milliseconds(5));
+        other_sensor.stop();
+        other_sensor.close();
+    }
+
+    std::vector<std::string> files;
+    for (uint32_t i = 0; file_exists(get_segment_file_name(file, i)); i++)
+        files.push_back(get_segment_file_name(file, i));
+    REQUIRE(files.size() > 2);
+
+    const stream_identifier other_recorded_depth{ 0, 1, RS2_STREAM_DEPTH, 0 };
+    auto ctx = std::make_shared<context>(backend_type::standard);
+    ros_multi_file_reader r(file, files, ctx);
+    r.enable_stream({ recorded_depth, other_recorded_depth });
+
+    auto end = r.query_duration();
+    r.seek_to_time(end);
+    auto last = r.fetch_last_frames(end);
+    REQUIRE(last.size() == 2);
+    for (auto&& data : last)
+    {
+        auto frame = data->as<serialized_frame>();
+        if (frame->stream_id == other_recorded_depth)
+        {
+            REQUIRE(frame->frame->get_frame_number() == 1);
+            REQUIRE(frame->get_timestamp() == nanoseconds::zero());
+        }
+        else
+        {
+            REQUIRE(frame->stream_id == recorded_depth);
+            REQUIRE(frame->frame->get_frame_number() == 20);
+            REQUIRE(frame->get_timestamp() == end);
+        }
+    }
+}
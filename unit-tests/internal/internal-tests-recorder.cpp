@@ -0,0 +1,430 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "catch.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <random>
+#include <thread>
+#include "./../unit-tests-common.h"
+#include "./../src/mock/recorder.h"
+
+using namespace librealsense::platform;
+
+// A recording with a compressible blob, a blob that does not compress, a profiles list and a devices list
+static std::shared_ptr<recording> make_recording(std::vector<std::vector<uint8_t>>& blobs)
+{
+    auto rec = std::make_shared<recording>(std::make_shared<os_time_service>());
+
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> noise(0, 255);
+    blobs.assign(2, std::vector<uint8_t>());
+    blobs[0].assign(4096, 7);
+    for (int i = 0; i < 1024; i++)
+        blobs[1].push_back(uint8_t(noise(rng)));
+
+    uvc_device_info info;
+    info.unique_id = "1-2-3";
+    info.vid = 0x8086;
+    info.pid = 0x0b07;
+    info.mi = 3;
+    rec->save_device_info_list(std::vector<uvc_device_info>{ info }, { 0, call_type::query_uvc_devices });
+    rec->save_stream_profiles({ { 640, 480, 30, 0x5a313620 }, { 1280, 720, 15, 0x59555956 } }, { 1, call_type::uvc_stream_profiles });
+
+    for (int i = 0; i < 2; i++)
+    {
+        auto blob = rec->save_blob(blobs[i].data(), blobs[i].size());
+        auto&& c = rec->add_call({ 1, call_type::uvc_frame });
+        c.param1 = blob;
+        c.param2 = int(blobs[i].size());
+        c.inline_string = "frame " + std::to_string(i);
+    }
+    return rec;
+}
+
+// any recording api version is accepted
+static std::shared_ptr<recording> load(const std::string& file, const char* section)
+{
+    return recording::load(file.c_str(), section, nullptr, "0.0.0");
+}
+
+static void require_recording(std::shared_ptr<recording> rec, const std::vector<std::vector<uint8_t>>& blobs)
+{
+    // the loaded calls start with an empty one
+    REQUIRE(rec->size() == 5);
+    REQUIRE(rec->blobs_count() == blobs.size());
+    for (size_t i = 0; i < blobs.size(); i++)
+        REQUIRE(rec->load_blob(int(i)) == blobs[i]);
+
+    auto devices = rec->load_uvc_device_info_list();
+    REQUIRE(devices.size() == 1);
+    REQUIRE(devices[0].unique_id == "1-2-3");
+    REQUIRE(devices[0].vid == 0x8086);
+    REQUIRE(devices[0].pid == 0x0b07);
+    REQUIRE(devices[0].mi == 3);
+
+    auto profiles = rec->load_stream_profiles(1, call_type::uvc_stream_profiles);
+    REQUIRE(profiles.size() == 2);
+    REQUIRE(profiles[1].width == 1280);
+    REQUIRE(profiles[1].height == 720);
+    REQUIRE(profiles[1].fps == 15);
+    REQUIRE(profiles[1].format == 0x59555956);
+
+    for (int i = 0; i < 2; i++)
+    {
+        auto&& c = rec->find_call(call_type::uvc_frame, 1);
+        REQUIRE(c.param1 == i);
+        REQUIRE(c.param2 == int(blobs[i].size()));
+        REQUIRE(c.inline_string == "frame " + std::to_string(i));
+    }
+}
+
+TEST_CASE("Binary recording round trip and conversion", "[code][record]")
+{
+    const std::string folder = get_folder_path(special_folder::temp_folder);
+    const std::string binary = folder + "recorder_round_trip.rsmock";
+    const std::string database = folder + "recorder_round_trip.db";
+    const std::string converted = folder + "recorder_round_trip_converted.rsmock";
+    for (auto&& file : { binary, database, converted })
+        std::remove(file.c_str());
+
+    std::vector<std::vector<uint8_t>> blobs;
+    make_recording(blobs)->save(binary.c_str(), "0");
+    require_recording(load(binary, "0"), blobs);
+
+    // a section is found by walking back from the last one
+    make_recording(blobs)->save(binary.c_str(), "1");
+    require_recording(load(binary, "0"), blobs);
+    require_recording(load(binary, "1"), blobs);
+    REQUIRE_THROWS(make_recording(blobs)->save(binary.c_str(), "1"));
+
+    // binary to sqlite and back
+    recording::convert(binary.c_str(), database.c_str(), "1");
+    require_recording(load(database, "1"), blobs);
+    recording::convert(database.c_str(), converted.c_str(), "1");
+    require_recording(load(converted, "1"), blobs);
+
+    for (auto&& file : { binary, database, converted })
+        std::remove(file.c_str());
+}
+
+static std::vector<uint8_t> read_file(const std::string& file)
+{
+    std::ifstream in(file, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+static void write_file(const std::string& file, const std::vector<uint8_t>& bytes)
+{
+    std::ofstream out(file, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+}
+
+template<class T>
+static T peek(const std::vector<uint8_t>& bytes, size_t offset)
+{
+    T value;
+    memcpy(&value, bytes.data() + offset, sizeof(T));
+    return value;
+}
+
+template<class T>
+static std::vector<uint8_t> patch(std::vector<uint8_t> bytes, size_t offset, T value)
+{
+    memcpy(bytes.data() + offset, &value, sizeof(T));
+    return bytes;
+}
+
+TEST_CASE("Binary recording rejects corrupted files", "[code][record]")
+{
+    const std::string folder = get_folder_path(special_folder::temp_folder);
+    const std::string binary = folder + "recorder_corrupted.rsmock";
+    std::remove(binary.c_str());
+
+    std::vector<std::vector<uint8_t>> blobs;
+    make_recording(blobs)->save(binary.c_str(), "0");
+    const auto valid = read_file(binary);
+    require_recording(load(binary, "0"), blobs);
+
+    // the trailer holds the offset of the index, which starts with its magic, the previous index and the section name
+    const size_t trailer = valid.size() - sizeof(uint64_t) - sizeof(uint32_t);
+    const size_t index = size_t(peek<uint64_t>(valid, trailer));
+    const size_t previous = index + sizeof(uint32_t);
+    const size_t section_end = previous + sizeof(uint64_t) + sizeof(uint32_t) + 1;
+    // the first blob follows the file magic, its raw and stored sizes come first
+    const size_t first_blob = 8;
+
+    SECTION("truncated file")
+    {
+        for (auto size : { valid.size() / 2, valid.size() - 1, size_t(index + 10) })
+        {
+            write_file(binary, std::vector<uint8_t>(valid.begin(), valid.begin() + size));
+            REQUIRE_THROWS(load(binary, "0"));
+        }
+    }
+    SECTION("index offset out of the file")
+    {
+        write_file(binary, patch<uint64_t>(valid, trailer, valid.size() + 100));
+        REQUIRE_THROWS(load(binary, "0"));
+        write_file(binary, patch<uint64_t>(valid, trailer, 1));
+        REQUIRE_THROWS(load(binary, "0"));
+    }
+    SECTION("index chain cycle")
+    {
+        // a missing section walks the chain, an index pointing at itself must not loop forever
+        write_file(binary, patch<uint64_t>(valid, previous, index));
+        REQUIRE_THROWS(load(binary, "missing"));
+    }
+    SECTION("count larger than the file")
+    {
+        // the api version and the creation time strings follow the section name, then the calls count
+        auto api_version = peek<uint32_t>(valid, section_end);
+        auto created_at = peek<uint32_t>(valid, section_end + sizeof(uint32_t) + api_version);
+        auto calls = section_end + 2 * sizeof(uint32_t) + api_version + created_at;
+        REQUIRE(peek<uint32_t>(valid, calls) == 4);
+        write_file(binary, patch<uint32_t>(valid, calls, 0x7fffffff));
+        REQUIRE_THROWS(load(binary, "0"));
+
+        write_file(binary, patch<uint32_t>(valid, section_end, 0xffffffff));
+        REQUIRE_THROWS(load(binary, "0"));
+    }
+    SECTION("blob sizes")
+    {
+        // a declared size that the stored bytes can't decompress to
+        write_file(binary, patch<uint32_t>(valid, first_blob, 0xfffffff0));
+        REQUIRE_THROWS(load(binary, "0")->load_blob(0));
+        write_file(binary, patch<uint32_t>(valid, first_blob, peek<uint32_t>(valid, first_blob) - 1));
+        REQUIRE_THROWS(load(binary, "0")->load_blob(0));
+        write_file(binary, patch<uint32_t>(valid, first_blob + sizeof(uint32_t), 0x7fffffff));
+        REQUIRE_THROWS(load(binary, "0")->load_blob(0));
+
+        write_file(binary, valid);
+        REQUIRE_THROWS(load(binary, "0")->load_blob(int(blobs.size())));
+    }
+    SECTION("blob offset out of the section")
+    {
+        // the blob offsets are the last list of the index
+        const size_t last_offset = trailer - sizeof(uint64_t);
+        write_file(binary, patch<uint64_t>(valid, last_offset, index));
+        REQUIRE_THROWS(load(binary, "0"));
+    }
+
+    std::remove(binary.c_str());
+}
+
+// The calls lookups of the playback scanning the calls one by one, the indexed lookups of the recording must match them
+class linear_replay
+{
+public:
+    explicit linear_replay(const std::vector<call>& calls) : _calls(calls) {}
+
+    int find_call(call_type t, int id)
+    {
+        for (size_t i = 1; i <= _calls.size(); i++)
+        {
+            const auto idx = (_cursors[id] + i) % _calls.size();
+            if (_calls[idx].type == t && _calls[idx].entity_id == id)
+            {
+                _cursors[id] = _cycles[id] = idx;
+                return int(idx);
+            }
+        }
+        return -1;
+    }
+
+    int cycle_calls(call_type t, int id)
+    {
+        for (auto idx = _cycles[id] + 1; idx < _calls.size(); idx++)
+        {
+            if (_calls[idx].entity_id != id)
+                continue;
+            if (_calls[idx].type != t)
+                break;
+            _cycles[id] = idx;
+            return int(idx);
+        }
+        _cycles[id] = _cursors[id];
+        return -1;
+    }
+
+    int pick_next_entity_call(int id)
+    {
+        for (auto idx = _cycles[id] + 1; idx < _calls.size(); idx++)
+        {
+            if (_calls[idx].entity_id == id)
+                return int(idx);
+        }
+        return -1;
+    }
+
+private:
+    const std::vector<call>& _calls;
+    std::map<int, size_t> _cursors;
+    std::map<int, size_t> _cycles;
+};
+
+TEST_CASE("Recording call lookups wrap around and cycle", "[code][record]")
+{
+    // each call keeps its position in param1
+    std::vector<call> calls;
+    auto rec = std::make_shared<recording>(std::make_shared<os_time_service>());
+    auto add = [&](int id, call_type t)
+    {
+        auto&& c = rec->add_call({ id, t });
+        c.param1 = int(calls.size());
+        calls.push_back(c);
+    };
+    auto position = [](call* c) { return c ? c->param1 : -1; };
+
+    SECTION("a recorded sequence")
+    {
+        add(1, call_type::uvc_set_pu);
+        add(1, call_type::uvc_frame);
+        add(1, call_type::uvc_frame);
+        add(2, call_type::uvc_set_pu);
+        add(1, call_type::uvc_set_pu);
+        add(1, call_type::uvc_frame);
+
+        // the lookup starts after the cursor and wraps around to the start of the recording
+        REQUIRE(rec->find_call(call_type::uvc_set_pu, 1).param1 == 4);
+        REQUIRE(rec->find_call(call_type::uvc_set_pu, 1).param1 == 0);
+        REQUIRE(rec->find_call(call_type::uvc_set_pu, 2).param1 == 3);
+
+        // the frames that follow the call are cycled, a call of another type ends the cycle and it starts over
+        REQUIRE(position(rec->cycle_calls(call_type::uvc_frame, 1)) == 1);
+        REQUIRE(position(rec->cycle_calls(call_type::uvc_frame, 1)) == 2);
+        REQUIRE(position(rec->pick_next_entity_call(1)) == 4);
+        REQUIRE(position(rec->cycle_calls(call_type::uvc_frame, 1)) == -1);
+        REQUIRE(position(rec->cycle_calls(call_type::uvc_frame, 1)) == 1);
+
+        // the end of the recording ends the cycle too
+        REQUIRE(rec->find_call(call_type::uvc_set_pu, 1).param1 == 4);
+        REQUIRE(position(rec->cycle_calls(call_type::uvc_frame, 1)) == 5);
+        REQUIRE(position(rec->cycle_calls(call_type::uvc_frame, 1)) == -1);
+        REQUIRE(position(rec->pick_next_entity_call(2)) == -1);
+
+        REQUIRE_THROWS(rec->find_call(call_type::uvc_get_pu, 1));
+        REQUIRE_THROWS(rec->find_call(call_type::uvc_set_pu, 1, [](const call&) { return false; }));
+    }
+
+    SECTION("random lookups match the linear scan")
+    {
+        const call_type types[] = { call_type::uvc_set_pu, call_type::uvc_get_pu, call_type::uvc_frame };
+        std::mt19937 rng(17);
+        std::uniform_int_distribution<int> entity(1, 3);
+        std::uniform_int_distribution<int> type(0, 2);
+        std::uniform_int_distribution<int> lookup(0, 3);
+        for (int i = 0; i < 300; i++)
+            add(entity(rng), types[type(rng)]);
+
+        linear_replay expected(calls);
+        for (int i = 0; i < 5000; i++)
+        {
+            auto id = entity(rng);
+            auto t = types[type(rng)];
+            switch (lookup(rng))
+            {
+            case 0:
+                REQUIRE(rec->find_call(t, id).param1 == expected.find_call(t, id));
+                break;
+            case 3:
+                REQUIRE(position(rec->pick_next_entity_call(id)) == expected.pick_next_entity_call(id));
+                break;
+            default:
+                REQUIRE(position(rec->cycle_calls(t, id)) == expected.cycle_calls(t, id));
+                break;
+            }
+        }
+
+        // calls recorded during the playback are indexed too
+        add(2, call_type::uvc_close);
+        REQUIRE(rec->find_call(call_type::uvc_close, 2).param1 == int(calls.size()) - 1);
+    }
+}
+
+// Frames of a playback device, the size of each frame is its timestamp so the order of the delivery can be told
+static void add_playback_frames(recording& rec, int id, stream_profile profile, const std::vector<int>& timestamps)
+{
+    uint8_t no_metadata = 0;
+    for (auto timestamp : timestamps)
+    {
+        auto profile_blob = rec.save_blob(&profile, sizeof(profile));
+        auto metadata_blob = rec.save_blob(&no_metadata, 0);
+        auto&& c = rec.add_call({ id, call_type::uvc_frame });
+        c.timestamp = timestamp;
+        c.param1 = profile_blob;
+        c.param3 = 0; // the pixels were not saved
+        c.param4 = timestamp;
+        c.param5 = metadata_blob;
+    }
+}
+
+TEST_CASE("Virtual clock playback", "[code][record]")
+{
+    const stream_profile profile{ 64, 48, 30, 0x5a313620 };
+    auto rec = std::make_shared<recording>(std::make_shared<os_time_service>());
+    rec->add_call({ 1, call_type::uvc_play });
+    rec->add_call({ 2, call_type::uvc_play });
+    add_playback_frames(*rec, 1, profile, { 10, 30, 50, 70 });
+    add_playback_frames(*rec, 2, profile, { 20, 40, 60 });
+    rec->save_stream_profiles({ profile }, { 1, call_type::uvc_close });
+    rec->save_stream_profiles({ profile }, { 2, call_type::uvc_close });
+    rec->enable_virtual_clock();
+
+    playback_uvc_device first(rec, 1);
+    playback_uvc_device second(rec, 2);
+
+    // the devices cycle through their frames from the moment they are created, so the first frames depend on when
+    // the streams start. once both stream, each round of the recording is delivered in the order of the timestamps
+    const std::vector<size_t> round{ 10, 20, 30, 40, 50, 60 };
+    std::mutex order_mutex;
+    std::vector<size_t> order;
+    auto collect = [&](stream_profile, frame_object fo, std::function<void()>)
+    {
+        std::lock_guard<std::mutex> lock(order_mutex);
+        order.push_back(fo.frame_size);
+    };
+    first.probe_and_commit(profile, collect, 0);
+    second.probe_and_commit(profile, collect, 0);
+    first.stream_on();
+    second.stream_on();
+
+    bool in_order = false;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!in_order && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        std::lock_guard<std::mutex> lock(order_mutex);
+        in_order = std::search(order.begin(), order.end(), round.begin(), round.end()) != order.end();
+    }
+    REQUIRE(in_order);
+
+    // an entity that never delivers keeps the devices waiting on the clock, there is no timeout to fall back on
+    std::atomic<bool> alive(true);
+    rec->wait_virtual_clock(99, 0, alive);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    size_t delivered;
+    {
+        std::lock_guard<std::mutex> lock(order_mutex);
+        delivered = order.size();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    {
+        std::lock_guard<std::mutex> lock(order_mutex);
+        REQUIRE(order.size() == delivered);
+    }
+
+    // closing a stream does not wait for the clock
+    for (auto device : { &first, &second })
+    {
+        auto start = std::chrono::steady_clock::now();
+        device->close(profile);
+        REQUIRE(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(100));
+    }
+    rec->leave_virtual_clock(99);
+}
@@ -0,0 +1,145 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "catch.h"
+#include <algorithm>
+#include <vector>
+#include "./../src/ipDeviceCommon/RsSharedMemory.h"
+
+#ifdef __linux__
+#include <sys/wait.h>
+#include <unistd.h>
+
+static const uint32_t ring_frame_size = 64;
+
+static std::string ring_name(const std::string& test)
+{
+    return "/rs-unit-tests-" + std::to_string(getpid()) + "-" + test;
+}
+
+// Publishes a frame whose bytes and metadata hold its number
+static bool publish_numbered(RsSharedMemoryRing& ring, uint8_t number)
+{
+    RsMetadataHeader metadata{};
+    metadata.data.frameCounter = number;
+    std::vector<uint8_t> data(ring_frame_size, number);
+    return ring.publish(metadata, data.data(), uint32_t(data.size()));
+}
+
+// Holds the newest frame of the ring, as a frame handed to the software sensor does
+static unsigned char* acquire_numbered(RsSharedMemoryRing& ring, uint8_t number)
+{
+    uint64_t sequence = 0;
+    RsSharedMemorySlot* slot = ring.acquireLatest(sequence);
+    REQUIRE(slot != nullptr);
+    REQUIRE(slot->size == ring_frame_size);
+    REQUIRE(slot->metadata.data.frameCounter == number);
+    unsigned char* data = RsSharedMemoryRing::getFrameData(slot);
+    REQUIRE(std::all_of(data, data + ring_frame_size, [&](unsigned char b) { return b == number; }));
+    return data;
+}
+
+TEST_CASE("Shared memory ring wraps around its slots", "[network]")
+{
+    const uint32_t slots = 4;
+    const auto name = ring_name("wrap");
+    auto writer = RsSharedMemoryRing::create(name, slots, ring_frame_size);
+    REQUIRE(writer);
+    auto reader = RsSharedMemoryRing::open(name);
+    REQUIRE(reader);
+
+    // every released slot is written again, round after round
+    uint64_t sequence = 0;
+    for (uint8_t number = 1; number <= 3 * slots; number++)
+    {
+        CAPTURE(int(number));
+        REQUIRE(publish_numbered(*writer, number));
+        REQUIRE(reader->waitFrame(sequence, std::chrono::milliseconds(100)));
+        RsSharedMemoryRing::releaseFrame(acquire_numbered(*reader, number));
+        sequence = number;
+    }
+    REQUIRE(writer->getDroppedFrames() == 0);
+    REQUIRE_FALSE(reader->waitFrame(sequence, std::chrono::milliseconds(1)));
+}
+
+TEST_CASE("Shared memory ring drops frames for a slow reader", "[network]")
+{
+    const uint32_t slots = 4;
+    const auto name = ring_name("slow");
+    auto writer = RsSharedMemoryRing::create(name, slots, ring_frame_size);
+    REQUIRE(writer);
+    auto slow_reader = RsSharedMemoryRing::open(name);
+    auto reader = RsSharedMemoryRing::open(name);
+    REQUIRE(slow_reader);
+    REQUIRE(reader);
+
+    // the slow reader holds every slot, the writer drops the next frame rather than waiting for it
+    std::vector<unsigned char*> held;
+    for (uint8_t number = 1; number <= slots; number++)
+    {
+        REQUIRE(publish_numbered(*writer, number));
+        held.push_back(acquire_numbered(*slow_reader, number));
+    }
+    REQUIRE_FALSE(publish_numbered(*writer, slots + 1));
+    REQUIRE(writer->getDroppedFrames() == 1);
+
+    // the other reader still gets the newest frame
+    RsSharedMemoryRing::releaseFrame(acquire_numbered(*reader, slots));
+
+    // a released slot is written with the next frame
+    RsSharedMemoryRing::releaseFrame(held.front());
+    held.erase(held.begin());
+    REQUIRE(publish_numbered(*writer, slots + 2));
+    RsSharedMemoryRing::releaseFrame(acquire_numbered(*reader, slots + 2));
+    for (auto data : held)
+        RsSharedMemoryRing::releaseFrame(data);
+    REQUIRE(writer->getDroppedFrames() == 1);
+}
+
+TEST_CASE("Shared memory ring reclaims the slots of a dead reader", "[network]")
+{
+    const uint32_t slots = 4;
+    const auto name = ring_name("dead");
+    auto writer = RsSharedMemoryRing::create(name, slots, ring_frame_size);
+    REQUIRE(writer);
+    auto reader = RsSharedMemoryRing::open(name);
+    REQUIRE(reader);
+    REQUIRE(publish_numbered(*writer, 1));
+
+    // a reader in another process takes the first frame and dies without releasing it
+    pid_t child = fork();
+    REQUIRE(child != -1);
+    if (child == 0)
+    {
+        auto child_reader = RsSharedMemoryRing::open(name);
+        uint64_t sequence = 0;
+        _exit(child_reader && child_reader->acquireLatest(sequence) ? 0 : 1);
+    }
+    int status = 0;
+    REQUIRE(waitpid(child, &status, 0) == child);
+    REQUIRE(WIFEXITED(status));
+    REQUIRE(WEXITSTATUS(status) == 0);
+
+    // with the other slots held by a live reader, only the slot of the dead reader can be written
+    std::vector<unsigned char*> held;
+    for (uint8_t number = 2; number <= slots; number++)
+    {
+        REQUIRE(publish_numbered(*writer, number));
+        held.push_back(acquire_numbered(*reader, number));
+    }
+    REQUIRE(publish_numbered(*writer, slots + 1));
+    REQUIRE(writer->getDroppedFrames() == 0);
+
+    // the entry of the dead reader is free again, so the ring takes as many readers as it has entries
+    std::vector<std::shared_ptr<RsSharedMemoryRing>> readers;
+    for (int i = 1; i < SHARED_MEMORY_READERS; i++)
+    {
+        readers.push_back(RsSharedMemoryRing::open(name));
+        REQUIRE(readers.back());
+    }
+    REQUIRE_FALSE(RsSharedMemoryRing::open(name));
+
+    for (auto data : held)
+        RsSharedMemoryRing::releaseFrame(data);
+}
+#endif
@@ -102,3 +102,45 @@ TEST_CASE("copy_2darray", "[code]")
             REQUIRE(src_double[i][j] != tgt_float[i][j]);
         }
 }
+
+TEST_CASE("enum_map iterates from find over dense and sparse keys", "[code]")
+{
+    // the keys below 4 are dense, the others are sparse
+    librealsense::enum_map<int, int, 4> map;
+    for (auto key : { 7, 1, 3, 12 })
+        map[key] = key * 10;
+    REQUIRE(map.size() == 4);
+
+    auto keys_from = [&](int key)
+    {
+        std::vector<int> keys;
+        for (auto it = map.find(key); it != map.end(); ++it)
+        {
+            REQUIRE(it->second == it->first * 10);
+            keys.push_back(it->first);
+        }
+        return keys;
+    };
+
+    // an iterator found on a dense key continues into the sparse keys
+    REQUIRE(keys_from(1) == std::vector<int>({ 1, 3, 7, 12 }));
+    REQUIRE(keys_from(3) == std::vector<int>({ 3, 7, 12 }));
+    REQUIRE(keys_from(7) == std::vector<int>({ 7, 12 }));
+    REQUIRE(keys_from(12) == std::vector<int>({ 12 }));
+    REQUIRE(map.find(2) == map.end());
+    REQUIRE(map.find(8) == map.end());
+
+    const auto& const_map = map;
+    std::vector<int> keys;
+    for (auto it = const_map.find(3); it != const_map.end(); ++it)
+        keys.push_back(it->first);
+    REQUIRE(keys == std::vector<int>({ 3, 7, 12 }));
+
+    // the insert of a present dense key returns an iterator that continues the same way
+    auto inserted = map.insert({ 1, 0 });
+    REQUIRE_FALSE(inserted.second);
+    int count = 0;
+    for (auto it = inserted.first; it != map.end(); ++it)
+        count++;
+    REQUIRE(count == 4);
+}
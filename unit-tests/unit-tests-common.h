@@ -325,10 +325,15 @@ inline bool make_context(const char* id, rs2::context* ctx, std::string min_api_
     std::string base_filename;
     bool record = false;
     bool playback = false;
+    bool virtual_clock = false;
     for (auto i = 0u; i < argc; i++)
     {
         std::string param(argv[i]);
-        if (param == "into")
+        if (param == "virtual-clock")
+        {
+            virtual_clock = true;
+        }
+        else if (param == "into")
         {
             i++;
             if (i < argc)
@@ -361,7 +366,7 @@ inline bool make_context(const char* id, rs2::context* ctx, std::string min_api_
         }
         else if (playback)
         {
-            *ctx = rs2::mock_context(base_filename, section, min_api_version);
+            *ctx = rs2::mock_context(base_filename, section, min_api_version, virtual_clock);
         }
         command_line_params::instance()._found_any_section = true;
         return true;
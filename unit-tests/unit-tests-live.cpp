@@ -1268,6 +1268,62 @@ TEST_CASE("Motion profiles sanity", "[live]")
     }
 }
 
+TEST_CASE("Motion samples batching", "[live]")
+{
+    rs2::context ctx;
+    if (make_context(SECTION_FROM_TEST_NAME, &ctx, "2.38.0"))
+    {
+        std::vector<sensor> list;
+        REQUIRE_NOTHROW(list = ctx.query_all_sensors());
+        REQUIRE(list.size() > 0);
+
+        const int batch_size = 8;
+        for (auto&& s : list)
+        {
+            if (!s.supports(RS2_OPTION_MOTION_BATCH_SIZE))
+                continue;
+
+            std::vector<rs2::stream_profile> profiles;
+            for (auto&& profile : s.get_stream_profiles())
+            {
+                if (profile.stream_type() == RS2_STREAM_GYRO && profile.format() == RS2_FORMAT_MOTION_XYZ32F)
+                {
+                    profiles.push_back(profile);
+                    break;
+                }
+            }
+            REQUIRE(profiles.size() == 1);
+
+            REQUIRE_NOTHROW(s.set_option(RS2_OPTION_MOTION_BATCH_SIZE, batch_size));
+            REQUIRE(batch_size == s.get_option(RS2_OPTION_MOTION_BATCH_SIZE));
+
+            std::mutex m;
+            std::vector<rs2::motion_frame> frames;
+            REQUIRE_NOTHROW(s.open(profiles));
+            REQUIRE_NOTHROW(s.start([&](rs2::frame f)
+            {
+                std::lock_guard<std::mutex> lock(m);
+                if (frames.size() < 10)
+                    frames.push_back(f.as<rs2::motion_frame>());
+            }));
+            std::this_thread::sleep_for(std::chrono::seconds(2));
+            REQUIRE_NOTHROW(s.stop());
+            REQUIRE_NOTHROW(s.close());
+            REQUIRE_NOTHROW(s.set_option(RS2_OPTION_MOTION_BATCH_SIZE, 1));
+
+            REQUIRE(frames.size() > 0);
+            for (auto&& f : frames)
+            {
+                REQUIRE(f.get_samples_count() == batch_size);
+                // the frame is stamped by its last sample
+                REQUIRE(f.get_sample_timestamp(batch_size - 1) == f.get_timestamp());
+                for (int i = 1; i < batch_size; i++)
+                    REQUIRE(f.get_sample_timestamp(i - 1) <= f.get_sample_timestamp(i));
+            }
+        }
+    }
+}
+
 TEST_CASE("Check width and height of stream intrinsics", "[live][AdvMd]")
 {
     rs2::context ctx;
@@ -4210,6 +4266,41 @@ TEST_CASE("Alternating Emitter", "[live][options]")
     }
 }
 
+TEST_CASE("Streaming profile presets", "[live][options]")
+{
+    rs2::context ctx;
+    if (make_context(SECTION_FROM_TEST_NAME, &ctx, "2.38.0"))
+    {
+        std::vector<sensor> list;
+        REQUIRE_NOTHROW(list = ctx.query_all_sensors());
+        REQUIRE(list.size() > 0);
+
+        for (auto&& s : list)
+        {
+            if (!s.supports(RS2_OPTION_STREAMING_PROFILE))
+                continue;
+
+            REQUIRE(s.supports(RS2_OPTION_KERNEL_FRAME_BUFFERS));
+            REQUIRE(s.supports(RS2_OPTION_NEWEST_FRAME_ONLY));
+            REQUIRE(s.supports(RS2_OPTION_KERNEL_DROPPED_FRAMES));
+            REQUIRE(s.is_option_read_only(RS2_OPTION_KERNEL_DROPPED_FRAMES));
+
+            REQUIRE_NOTHROW(s.set_option(RS2_OPTION_STREAMING_PROFILE, 1));
+            REQUIRE(2 == s.get_option(RS2_OPTION_KERNEL_FRAME_BUFFERS));
+            REQUIRE(1 == s.get_option(RS2_OPTION_NEWEST_FRAME_ONLY));
+
+            REQUIRE_NOTHROW(s.set_option(RS2_OPTION_STREAMING_PROFILE, 2));
+            REQUIRE(16 == s.get_option(RS2_OPTION_KERNEL_FRAME_BUFFERS));
+            REQUIRE(0 == s.get_option(RS2_OPTION_NEWEST_FRAME_ONLY));
+
+            // a manual change leaves the preset
+            REQUIRE_NOTHROW(s.set_option(RS2_OPTION_KERNEL_FRAME_BUFFERS, 4));
+            REQUIRE(0 == s.get_option(RS2_OPTION_STREAMING_PROFILE));
+            REQUIRE_THROWS(s.set_option(RS2_OPTION_KERNEL_FRAME_BUFFERS, 1));
+        }
+    }
+}
+
 // the tests may incorrectly interpret changes to librealsense-core, namely default profiles selections
 TEST_CASE("All suggested profiles can be opened", "[live][!mayfail]") {
 
@@ -5166,6 +5257,234 @@ TEST_CASE("Syncer try wait for frames", "[live][software-device]") {
     }
 }
 
+TEST_CASE("Software-device frame injected with its metadata", "[software-device]") {
+    const int W = 64;
+    const int H = 48;
+    const int BPP = 2;
+    software_device dev;
+    auto s = dev.add_sensor("software_sensor");
+
+    rs2_intrinsics intrinsics{ W, H, 0, 0, 0, 0, RS2_DISTORTION_NONE ,{ 0,0,0,0,0 } };
+    auto depth = s.add_video_stream({ RS2_STREAM_DEPTH, 0, 0, W, H, 30, BPP, RS2_FORMAT_Z16, intrinsics });
+
+    frame_queue q(2);
+    s.open(depth);
+    s.start(q);
+
+    // the metadata set on the sensor do not leak into a frame injected with its own metadata
+    s.set_metadata(RS2_FRAME_METADATA_ACTUAL_EXPOSURE, 100);
+    std::vector<uint8_t> pixels(W * H * BPP, 0);
+    s.on_video_frame({ pixels.data(), [](void*) {}, W * BPP, BPP, 0, RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, 1, depth },
+        { { RS2_FRAME_METADATA_FRAME_COUNTER, 7 }, { RS2_FRAME_METADATA_ACTUAL_FPS, 30 } });
+
+    rs2::frame f;
+    REQUIRE(q.try_wait_for_frame(&f, 5000));
+    REQUIRE(f.supports_frame_metadata(RS2_FRAME_METADATA_FRAME_COUNTER));
+    REQUIRE(f.get_frame_metadata(RS2_FRAME_METADATA_FRAME_COUNTER) == 7);
+    REQUIRE(f.get_frame_metadata(RS2_FRAME_METADATA_ACTUAL_FPS) == 30);
+    REQUIRE_FALSE(f.supports_frame_metadata(RS2_FRAME_METADATA_ACTUAL_EXPOSURE));
+
+    // metadata that do not fit in the frame are rejected rather than cut, and the pixels of the rejected frame are released
+    static int released_frames;
+    released_frames = 0;
+    std::vector<rs2_software_metadata> too_many;
+    for (int i = 0; i < RS2_FRAME_METADATA_COUNT; i++)
+        too_many.push_back({ rs2_frame_metadata_value(i), i });
+    REQUIRE_THROWS(s.on_video_frame({ pixels.data(), [](void*) { released_frames++; }, W * BPP, BPP, 0, RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, 2, depth }, too_many));
+    REQUIRE(released_frames == 1);
+    REQUIRE_THROWS([&]() {
+        for (auto& metadata : too_many)
+            s.set_metadata(metadata.key, metadata.value);
+    }());
+
+    s.stop();
+    s.close();
+}
+
+TEST_CASE("Software-device frame metadata retrieved in one call", "[software-device]") {
+    const int W = 64;
+    const int H = 48;
+    const int BPP = 2;
+    software_device dev;
+    auto s = dev.add_sensor("software_sensor");
+
+    rs2_intrinsics intrinsics{ W, H, 0, 0, 0, 0, RS2_DISTORTION_NONE ,{ 0,0,0,0,0 } };
+    auto depth = s.add_video_stream({ RS2_STREAM_DEPTH, 0, 0, W, H, 30, BPP, RS2_FORMAT_Z16, intrinsics });
+
+    frame_queue q(2);
+    s.open(depth);
+    s.start(q);
+
+    std::vector<uint8_t> pixels(W * H * BPP, 0);
+    s.on_video_frame({ pixels.data(), [](void*) {}, W * BPP, BPP, 0, RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, 1, depth },
+        { { RS2_FRAME_METADATA_FRAME_COUNTER, 7 }, { RS2_FRAME_METADATA_ACTUAL_FPS, 30 } });
+
+    rs2::frame f;
+    REQUIRE(q.try_wait_for_frame(&f, 5000));
+    // the attributes queried before and after the bulk query agree with it
+    REQUIRE(f.get_frame_metadata(RS2_FRAME_METADATA_FRAME_COUNTER) == 7);
+    auto all = f.get_all_frame_metadata();
+    REQUIRE(all.size() == 2);
+    for (auto&& md : all)
+    {
+        REQUIRE(f.supports_frame_metadata(md.first));
+        REQUIRE(f.get_frame_metadata(md.first) == md.second);
+    }
+    REQUIRE(f.get_frame_metadata(RS2_FRAME_METADATA_ACTUAL_FPS) == 30);
+    REQUIRE_FALSE(f.supports_frame_metadata(RS2_FRAME_METADATA_ACTUAL_EXPOSURE));
+    REQUIRE_THROWS(f.get_frame_metadata(RS2_FRAME_METADATA_ACTUAL_EXPOSURE));
+
+    // the attributes that were not injected are reported unsupported, with a zero value
+    rs2_metadata_type values[RS2_FRAME_METADATA_COUNT];
+    int supported[RS2_FRAME_METADATA_COUNT];
+    std::fill(std::begin(values), std::end(values), -1);
+    std::fill(std::begin(supported), std::end(supported), -1);
+    rs2_error* e = nullptr;
+    rs2_get_frame_metadata_all(f.get(), values, supported, RS2_FRAME_METADATA_COUNT, &e);
+    REQUIRE(e == nullptr);
+    for (int i = 0; i < RS2_FRAME_METADATA_COUNT; i++)
+    {
+        CAPTURE(i);
+        auto injected = (i == RS2_FRAME_METADATA_FRAME_COUNTER || i == RS2_FRAME_METADATA_ACTUAL_FPS);
+        REQUIRE(supported[i] == (injected ? 1 : 0));
+        if (!injected)
+            REQUIRE(values[i] == 0);
+    }
+
+    // a shorter array is filled up to its size, a count beyond the attributes is an error
+    std::fill(std::begin(supported), std::end(supported), -1);
+    rs2_get_frame_metadata_all(f.get(), values, supported, RS2_FRAME_METADATA_FRAME_COUNTER + 1, &e);
+    REQUIRE(e == nullptr);
+    REQUIRE(supported[RS2_FRAME_METADATA_FRAME_COUNTER] == 1);
+    REQUIRE(supported[RS2_FRAME_METADATA_FRAME_COUNTER + 1] == -1);
+    rs2_get_frame_metadata_all(f.get(), values, supported, RS2_FRAME_METADATA_COUNT + 1, &e);
+    REQUIRE(e != nullptr);
+    rs2_free_error(e);
+
+    s.stop();
+    s.close();
+}
+
+TEST_CASE("Software-device frames use the injected buffers", "[software-device][benchmark]") {
+    const int W = 640;
+    const int H = 480;
+    const int BPP = 2;
+    const int FRAMES = 10000;
+    software_device dev;
+    auto s = dev.add_sensor("software_sensor");
+
+    rs2_intrinsics intrinsics{ W, H, 0, 0, 0, 0, RS2_DISTORTION_NONE ,{ 0,0,0,0,0 } };
+    auto depth = s.add_video_stream({ RS2_STREAM_DEPTH, 0, 0, W, H, 30, BPP, RS2_FORMAT_Z16, intrinsics });
+
+    // the application pool the deleter returns the buffers to
+    static std::mutex pool_mutex;
+    static std::vector<void*> pool;
+    std::vector<std::vector<uint8_t>> buffers(2, std::vector<uint8_t>(W * H * BPP, 0));
+    for (auto&& buffer : buffers)
+        pool.push_back(buffer.data());
+
+    void* injected = nullptr;
+    int copied_frames = 0;
+    s.open(depth);
+    s.start([&](rs2::frame f) {
+        if (f.get_data() != injected || f.get_data_size() != W * H * BPP)
+            copied_frames++;
+    });
+
+    auto started = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < FRAMES; i++)
+    {
+        {
+            std::lock_guard<std::mutex> lock(pool_mutex);
+            REQUIRE_FALSE(pool.empty());
+            injected = pool.back();
+            pool.pop_back();
+        }
+        s.on_video_frame({ injected, [](void* p) { std::lock_guard<std::mutex> lock(pool_mutex); pool.push_back(p); },
+            W * BPP, BPP, (rs2_time_t)i, RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, i, depth });
+    }
+    auto done = std::chrono::high_resolution_clock::now();
+
+    s.stop();
+    s.close();
+
+    // reported through Catch, so the measurement shows in the test report next to the other [benchmark] results
+    WARN("Software-device injection overhead: "
+        << std::chrono::duration_cast<std::chrono::nanoseconds>(done - started).count() / FRAMES << " ns per frame");
+
+    REQUIRE(copied_frames == 0);
+    std::lock_guard<std::mutex> lock(pool_mutex);
+    REQUIRE(pool.size() == buffers.size());
+    pool.clear();
+}
+
+TEST_CASE("Software-device per-frame metadata and option queries", "[software-device][benchmark]") {
+    const int W = 64;
+    const int H = 48;
+    const int BPP = 2;
+    const int FRAMES = 1000;
+    const int QUERIES = 100;
+    software_device dev;
+    auto s = dev.add_sensor("software_sensor");
+
+    rs2_intrinsics intrinsics{ W, H, 0, 0, 0, 0, RS2_DISTORTION_NONE ,{ 0,0,0,0,0 } };
+    auto depth = s.add_video_stream({ RS2_STREAM_DEPTH, 0, 0, W, H, 30, BPP, RS2_FORMAT_Z16, intrinsics });
+
+    // the attributes a pipeline typically reads from each frame
+    const rs2_frame_metadata_value attributes[] = { RS2_FRAME_METADATA_FRAME_COUNTER, RS2_FRAME_METADATA_FRAME_TIMESTAMP,
+        RS2_FRAME_METADATA_SENSOR_TIMESTAMP, RS2_FRAME_METADATA_ACTUAL_EXPOSURE, RS2_FRAME_METADATA_GAIN_LEVEL,
+        RS2_FRAME_METADATA_AUTO_EXPOSURE, RS2_FRAME_METADATA_TIME_OF_ARRIVAL, RS2_FRAME_METADATA_ACTUAL_FPS };
+    std::vector<rs2_software_metadata> metadata;
+    for (auto attribute : attributes)
+        metadata.push_back({ attribute, 1 });
+
+    rs2::decimation_filter filter;
+    frame_queue q(2);
+    s.open(depth);
+    s.start(q);
+
+    // each frame is queried as it arrives, so its first queries pay for the parsing
+    rs2_metadata_type sum = 0;
+    std::chrono::high_resolution_clock::duration metadata_queries{ 0 };
+    std::vector<uint8_t> pixels(W * H * BPP, 0);
+    for (int i = 0; i < FRAMES; i++)
+    {
+        s.on_video_frame({ pixels.data(), [](void*) {}, W * BPP, BPP, (rs2_time_t)i, RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, i, depth },
+            metadata);
+        rs2::frame f;
+        REQUIRE(q.try_wait_for_frame(&f, 5000));
+
+        auto started = std::chrono::high_resolution_clock::now();
+        for (auto attribute : attributes)
+        {
+            if (f.supports_frame_metadata(attribute))
+                sum += f.get_frame_metadata(attribute);
+        }
+        metadata_queries += std::chrono::high_resolution_clock::now() - started;
+    }
+
+    auto metadata_done = std::chrono::high_resolution_clock::now();
+    int supported = 0;
+    for (int i = 0; i < FRAMES * QUERIES; i++)
+    {
+        supported += s.supports(RS2_OPTION_FRAMES_QUEUE_SIZE) ? 1 : 0;
+        supported += filter.supports(static_cast<rs2_option>(i % RS2_OPTION_COUNT)) ? 1 : 0;
+    }
+    auto options_done = std::chrono::high_resolution_clock::now();
+
+    s.stop();
+    s.close();
+
+    WARN("Metadata queries: "
+        << std::chrono::duration_cast<std::chrono::nanoseconds>(metadata_queries).count() / FRAMES << " ns per frame of "
+        << sizeof(attributes) / sizeof(attributes[0]) << " attributes");
+    WARN("Option support queries: "
+        << std::chrono::duration_cast<std::chrono::nanoseconds>(options_done - metadata_done).count() / (FRAMES * QUERIES * 2) << " ns per query");
+
+    REQUIRE(sum == FRAMES * sizeof(attributes) / sizeof(attributes[0]));
+    REQUIRE(supported >= FRAMES * QUERIES);
+}
+
 TEST_CASE("Test Motion Module Extension", "[software-device][using_pipeline][projection]") {
     rs2::context ctx;
     if (!make_context(SECTION_FROM_TEST_NAME, &ctx))
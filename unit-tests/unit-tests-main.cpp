@@ -19,6 +19,10 @@ int main(int argc, char* const argv[])
     for (auto i = 0; i < argc; i++)
     {
         std::string param(argv[i]);
+        if (param == "virtual-clock")
+        {
+            continue;
+        }
         if (param != "into" && param != "from")
         {
             new_argvs.push_back(argv[i]);
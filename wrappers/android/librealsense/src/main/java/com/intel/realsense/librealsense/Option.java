@@ -75,7 +75,12 @@ public enum Option {
     EMITTER_ALWAYS_ON(71),
     THERMAL_COMPENSATION(72),
     TRIGGER_CAMERA_ACCURACY_HEALTH(73),
-    RESET_CAMERA_ACCURACY_HEALTH(74);
+    RESET_CAMERA_ACCURACY_HEALTH(74),
+    KERNEL_FRAME_BUFFERS(75),
+    NEWEST_FRAME_ONLY(76),
+    STREAMING_PROFILE(77),
+    KERNEL_DROPPED_FRAMES(78),
+    MOTION_BATCH_SIZE(79);
     private final int mValue;
 
     private Option(int value) { mValue = value; }
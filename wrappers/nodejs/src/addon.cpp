@@ -4701,6 +4701,11 @@ void InitModule(v8::Local<v8::Object> exports) {
   _FORCE_SET_ENUM(RS2_OPTION_THERMAL_COMPENSATION);
   _FORCE_SET_ENUM(RS2_OPTION_TRIGGER_CAMERA_ACCURACY_HEALTH);
   _FORCE_SET_ENUM(RS2_OPTION_RESET_CAMERA_ACCURACY_HEALTH);
+  _FORCE_SET_ENUM(RS2_OPTION_KERNEL_FRAME_BUFFERS);
+  _FORCE_SET_ENUM(RS2_OPTION_NEWEST_FRAME_ONLY);
+  _FORCE_SET_ENUM(RS2_OPTION_STREAMING_PROFILE);
+  _FORCE_SET_ENUM(RS2_OPTION_KERNEL_DROPPED_FRAMES);
+  _FORCE_SET_ENUM(RS2_OPTION_MOTION_BATCH_SIZE);
   _FORCE_SET_ENUM(RS2_OPTION_COUNT);
 
   // rs2_camera_info
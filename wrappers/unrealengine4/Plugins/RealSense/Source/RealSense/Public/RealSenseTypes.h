@@ -128,6 +128,11 @@ enum class ERealSenseOptionType : uint8
     THERMAL_COMPENSATION                       , /**< Depth Thermal Compensation for selected D400 SKUs */
     TRIGGER_CAMERA_ACCURACY_HEALTH             ,
     RESET_CAMERA_ACCURACY_HEALTH               ,
+    KERNEL_FRAME_BUFFERS                       , /**< Number of frame buffers queued to the driver, applied when the sensor is opened */
+    NEWEST_FRAME_ONLY                          , /**< Deliver only the newest frame the driver has ready, releasing the stale ones unread */
+    STREAMING_PROFILE                          , /**< Preset of the frame buffers and delivery: 0 - custom, 1 - low latency, 2 - high throughput */
+    KERNEL_DROPPED_FRAMES                      , /**< Frames dropped at the driver boundary since the sensor was started */
+    MOTION_BATCH_SIZE                          , /**< Number of consecutive IMU samples delivered in a single motion frame, applied when the sensor is started */
 };
 
 UENUM(Blueprintable)